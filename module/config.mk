@@ -74,10 +74,19 @@ CSRCS = \
 	../module/usb_disk_mode.c   				\
 	../module/screensaver_mode.c   				\
 	../src/command.c					\
+	../src/cv_out.c					\
 	../src/every.c					\
 	../src/helpers.c					\
+	../src/ii_poll.c					\
+	../src/ii_queue.c				\
 	../src/match_token.c					\
+	../src/match_token_hash.c				\
+	../src/profiler.c					\
+	../src/queue.c					\
+	../src/scene_binary.c				\
+	../src/scene_text.c				\
 	../src/scanner.c					\
+	../src/slew.c					\
 	../src/state.c						\
 	../src/table.c						\
 	../src/teletype.c					\
@@ -230,6 +239,10 @@ CFLAGS = -fshort-enums -fno-common
 # The most relevant symbols to define for the preprocessor are:
 #   BOARD      Target board in use, see boards/board.h for a list.
 #   EXT_BOARD  Optional extension board in use, see boards/board.h for a list.
+#   TELETYPE_PROFILE  Optional, compiles in the execution profiler, which
+#              prints to the debug serial port.
+#   MATCH_TOKEN_HASH  Optional, matches op and mod names with the perfect hash
+#              in match_token_hash.c rather than the ragel state machine.
 CPPFLAGS = -D BOARD=USER_BOARD -D UHD_ENABLE
 
 # Extra flags to use when linking
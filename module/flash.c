@@ -7,18 +7,34 @@
 #include "print_funcs.h"
 
 // this
+#include "scene_binary.h"
 #include "teletype.h"
 
-#define FIRSTRUN_KEY 0x22
+#define FIRSTRUN_KEY 0x24
 
-// NVRAM data structure located in the flash array.
-typedef const struct {
-    scene_script_t scripts[SCRIPT_COUNT - 1]; // Exclude TEMP script
-    scene_pattern_t patterns[PATTERN_COUNT];
-    char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+// Scenes are stored in the scene_binary format (see scene_binary.h), in blocks
+// of one flash page. A scene takes as many blocks as it needs, which don't
+// need to be next to each other, and a block belongs to the scene whose block
+// list names it.
+//
+// The blocks and the block lists fit in the flash the 32 fixed slots of
+// 4,556 bytes took before (145,792 bytes). An empty scene takes 1 block and
+// one with every line, pattern value and line of text used about 7, so 64
+// scenes only fit if most of them are small (e.g. 32 full and 32 empty). A
+// save that doesn't fit fails without touching the scene already in the slot.
+#define FLASH_BLOCK_SIZE 512
+#define FLASH_BLOCKS 278
+// well beyond the size of a full scene
+#define SCENE_MAX_BLOCKS 24
+
+typedef struct {
+    uint16_t length;
+    uint16_t blocks[SCENE_MAX_BLOCKS];
 } nvram_scene_t;
 
+// NVRAM data structure located in the flash array.
 typedef const struct {
+    uint8_t blocks[FLASH_BLOCKS][FLASH_BLOCK_SIZE];
     nvram_scene_t scenes[SCENE_SLOTS];
     uint8_t last_scene;
     uint8_t fresh;
@@ -28,6 +44,14 @@ typedef const struct {
 
 static __attribute__((__section__(".flash_nvram"))) nvram_data_t f;
 
+// the text of one scene is kept decoded for the preset read page
+static char text_cache[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
+static int16_t text_cache_scene = -1;
+
+static uint16_t blocks_for(uint16_t length) {
+    return (length + FLASH_BLOCK_SIZE - 1) / FLASH_BLOCK_SIZE;
+}
+
 void flash_prepare() {
     // if it's not empty return
     if (f.fresh == FIRSTRUN_KEY) return;
@@ -36,8 +60,11 @@ void flash_prepare() {
     print_dbg("\r\nflash size: ");
     print_dbg_ulong(sizeof(f));
 
-    // blank scene to write to flash
-    scene_state_t scene;
+    // no scene owns any blocks
+    flashc_memset8((void *)&f.scenes, 0, sizeof(f.scenes), true);
+
+    // blank scene to write to flash, static as it's too big for the stack
+    static scene_state_t scene;
     ss_init(&scene);
 
     char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
@@ -51,26 +78,174 @@ void flash_prepare() {
     flashc_memset8((void *)&f.fresh, FIRSTRUN_KEY, 1, true);
 }
 
-void flash_write(uint8_t preset_no, scene_state_t *scene,
+
+////////////////////////////////////////////////////////////////////////////////
+// write
+
+// A scene is never written over the copy it replaces: a block that is the
+// same as the old copy's block in the same place is kept as it is, and any
+// other is written to a free block. The slot's block list only changes once
+// all of them are written, so a save that runs out of room leaves the old
+// copy as it was.
+//
+// This doesn't make a save safe from losing power: the block lists are
+// packed into pages (and straddle them), and writing one erases its page, so
+// a power cut then can lose the lists of the other slots in the page too.
+typedef struct {
+    const nvram_scene_t *old;
+    uint8_t used[(FLASH_BLOCKS + 7) / 8];
+    uint16_t next_free;
+    uint16_t blocks[SCENE_MAX_BLOCKS];
+    uint16_t length;
+    uint8_t page[FLASH_BLOCK_SIZE];
+} block_writer_t;
+
+static bool is_used(const block_writer_t *w, uint16_t b) {
+    return w->used[b / 8] & (1 << (b % 8));
+}
+
+static void set_used(block_writer_t *w, uint16_t b) {
+    w->used[b / 8] |= 1 << (b % 8);
+}
+
+// the blocks of every scene, including the old copy of this one, are in use
+static void find_used(block_writer_t *w) {
+    memset(w->used, 0, sizeof(w->used));
+    for (uint8_t s = 0; s < SCENE_SLOTS; s++) {
+        const uint16_t n = blocks_for(f.scenes[s].length);
+        for (uint16_t i = 0; i < n && i < SCENE_MAX_BLOCKS; i++) {
+            const uint16_t b = f.scenes[s].blocks[i];
+            if (b < FLASH_BLOCKS) set_used(w, b);
+        }
+    }
+}
+
+// block i of the scene, returns false if there's no room left
+static bool write_block(block_writer_t *w, uint16_t i, uint16_t length) {
+    // keep the old block if it holds the same bytes
+    const uint32_t start = (uint32_t)i * FLASH_BLOCK_SIZE;
+    if (i < SCENE_MAX_BLOCKS && start + length <= w->old->length) {
+        const uint16_t b = w->old->blocks[i];
+        if (b < FLASH_BLOCKS && !memcmp(f.blocks[b], w->page, length)) {
+            w->blocks[i] = b;
+            return true;
+        }
+    }
+
+    while (w->next_free < FLASH_BLOCKS && is_used(w, w->next_free))
+        w->next_free++;
+    if (w->next_free == FLASH_BLOCKS) return false;
+
+    const uint16_t b = w->next_free;
+    set_used(w, b);
+    w->blocks[i] = b;
+    // a free block may still hold these bytes from an earlier save
+    if (memcmp(f.blocks[b], w->page, length))
+        flashc_memcpy((void *)f.blocks[b], w->page, length, true);
+    return true;
+}
+
+static bool block_put(void *context, uint8_t byte) {
+    block_writer_t *w = context;
+    if (w->length == SCENE_MAX_BLOCKS * FLASH_BLOCK_SIZE) return false;
+    const uint16_t offset = w->length % FLASH_BLOCK_SIZE;
+
+    w->page[offset] = byte;
+    w->length++;
+    if (offset == FLASH_BLOCK_SIZE - 1)
+        return write_block(w, w->length / FLASH_BLOCK_SIZE - 1,
+                           FLASH_BLOCK_SIZE);
+    return true;
+}
+
+bool flash_write(uint8_t preset_no, scene_state_t *scene,
                  char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
-    flashc_memcpy((void *)&f.scenes[preset_no].scripts, ss_scripts_ptr(scene),
-                  // Exclude TEMP script from flash storage by subtracting one
-                  ss_scripts_size() - sizeof(scene_script_t), true);
-    flashc_memcpy((void *)&f.scenes[preset_no].patterns, ss_patterns_ptr(scene),
-                  ss_patterns_size(), true);
-    flashc_memcpy((void *)&f.scenes[preset_no].text, text,
-                  SCENE_TEXT_LINES * SCENE_TEXT_CHARS, true);
+    if (preset_no >= SCENE_SLOTS) return false;
+
+    // nothing to do if the scene was read from (or written to) this slot and
+    // hasn't changed since, the live script isn't saved
+    if (ss_get_dirty_slot(scene) == preset_no &&
+        !(ss_get_dirty(scene) & ~SS_DIRTY_SCRIPT(TEMP_SCRIPT)))
+        return true;
+
+    static block_writer_t w;
+    memset(&w, 0, sizeof(w));
+    w.old = &f.scenes[preset_no];
+    find_used(&w);
+
+    const scene_binary_writer_t writer = { .put = block_put, .context = &w };
+    bool ok = scene_binary_write(scene, &(*text)[0][0], SCENE_TEXT_LINES,
+                                 SCENE_TEXT_CHARS, &writer,
+                                 NULL) == SCENE_BINARY_OK;
+    if (ok && w.length % FLASH_BLOCK_SIZE)
+        ok = write_block(&w, w.length / FLASH_BLOCK_SIZE,
+                         w.length % FLASH_BLOCK_SIZE);
+    if (!ok) {
+        print_dbg("\r\nno room in flash for scene ");
+        print_dbg_ulong(preset_no);
+        return false;
+    }
+
+    // the scene only moves to its new blocks once they're written
+    nvram_scene_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.length = w.length;
+    memcpy(entry.blocks, w.blocks, sizeof(entry.blocks));
+    if (memcmp(&f.scenes[preset_no], &entry, sizeof(entry)))
+        flashc_memcpy((void *)&f.scenes[preset_no], &entry, sizeof(entry),
+                      true);
+
+    ss_clear_dirty(scene, preset_no);
+    if (text_cache_scene == preset_no) text_cache_scene = -1;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// read
+
+typedef struct {
+    const nvram_scene_t *scene;
+    uint16_t pos;
+} block_reader_t;
+
+static bool block_get(void *context, uint8_t *byte) {
+    block_reader_t *r = context;
+    if (r->pos >= r->scene->length) return false;
+
+    const uint16_t b = r->scene->blocks[r->pos / FLASH_BLOCK_SIZE];
+    if (b >= FLASH_BLOCKS) return false;
+    *byte = f.blocks[b][r->pos % FLASH_BLOCK_SIZE];
+    r->pos++;
+    return true;
+}
+
+static bool read_scene(uint8_t preset_no, scene_state_t *scene, char *text) {
+    if (preset_no >= SCENE_SLOTS) return false;
+
+    block_reader_t r = { .scene = &f.scenes[preset_no] };
+    const scene_binary_reader_t reader = { .get = block_get, .context = &r };
+    const scene_binary_result_t result = scene_binary_read(
+        scene, text, SCENE_TEXT_LINES, SCENE_TEXT_CHARS, &reader);
+    if (result != SCENE_BINARY_OK) {
+        print_dbg("\r\ncan't read scene ");
+        print_dbg_ulong(preset_no);
+        print_dbg(", error ");
+        print_dbg_ulong(result);
+    }
+    return result == SCENE_BINARY_OK;
 }
 
-void flash_read(uint8_t preset_no, scene_state_t *scene,
+bool flash_read(uint8_t preset_no, scene_state_t *scene,
                 char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]) {
-    memcpy(ss_scripts_ptr(scene), &f.scenes[preset_no].scripts,
-           // Exclude size of TEMP script as above
-           ss_scripts_size() - sizeof(scene_script_t));
-    memcpy(ss_patterns_ptr(scene), &f.scenes[preset_no].patterns,
-           ss_patterns_size());
-    memcpy(text, &f.scenes[preset_no].text,
-           SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
+    if (read_scene(preset_no, scene, &(*text)[0][0])) {
+        ss_clear_dirty(scene, preset_no);
+        return true;
+    }
+    // what was read doesn't match the slot
+    ss_clear_dirty(scene, -1);
+    ss_set_dirty(scene, SS_DIRTY_ALL);
+    return false;
 }
 
 uint8_t flash_last_saved_scene() {
@@ -82,7 +257,11 @@ void flash_update_last_saved_scene(uint8_t preset_no) {
 }
 
 const char *flash_scene_text(uint8_t preset_no, size_t line) {
-    return f.scenes[preset_no].text[line];
+    if (text_cache_scene != preset_no) {
+        read_scene(preset_no, NULL, &text_cache[0][0]);
+        text_cache_scene = preset_no;
+    }
+    return text_cache[line];
 }
 
 void flash_update_cal(cal_data_t *cal) {
@@ -1,18 +1,23 @@
 #ifndef _FLASH_H_
 #define _FLASH_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "globals.h"
 #include "line_editor.h"
 #include "teletype.h"
 
-#define SCENE_SLOTS 32
+#define SCENE_SLOTS 64
 
 void flash_prepare(void);
-void flash_read(uint8_t preset_no, scene_state_t *scene,
+// both return false if the scene can't be read, or there is no room for it,
+// and both leave the scene clean (see ss_get_dirty), a write of a clean scene
+// to the slot it came from does nothing, so text must be the text that was
+// read with it
+bool flash_read(uint8_t preset_no, scene_state_t *scene,
                 char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
-void flash_write(uint8_t preset_no, scene_state_t *scene,
+bool flash_write(uint8_t preset_no, scene_state_t *scene,
                  char (*text)[SCENE_TEXT_LINES][SCENE_TEXT_CHARS]);
 uint8_t flash_last_saved_scene(void);
 void flash_update_last_saved_scene(uint8_t preset_no);
@@ -81,13 +81,14 @@ const char* help2[HELP2_LENGTH] = { "2/8 VARIABLES",
                                     "Q.N|SET Q LENGTH",
                                     "Q.AVG|AVERAGE OF ALL Q" };
 
-#define HELP3_LENGTH 22
+#define HELP3_LENGTH 26
 const char* help3[HELP3_LENGTH] = { "3/8 PARAMETERS",
                                     " ",
                                     "TR A-D|SET TR VALUE (0,1)",
                                     "TR.TIME A-D|TR PULSE TIME",
                                     "CV 1-4|CV TARGET VALUE",
                                     "CV.SLEW 1-4|CV SLEW TIME (MS)",
+                                    "CV.CURVE 1-4|CV SLEW SHAPE (0-3)",
                                     "CV.SET 1-4|SET CV (NO SLEW)",
                                     "CV.OFF 1-4|ADD CV OFFSET",
                                     " ",
@@ -103,7 +104,10 @@ const char* help3[HELP3_LENGTH] = { "3/8 PARAMETERS",
                                     " ",
                                     "SCRIPT A|GET/RUN SCRIPT",
                                     "SCENE|GET/SET SCENE #",
-                                    "LAST N|GET SCRIPT LAST RUN" };
+                                    "LAST N|GET SCRIPT LAST RUN",
+                                    " ",
+                                    "II.PRI A|I2C PRIORITY (0-2)",
+                                    "II.RATE A|I2C MSGS PER 10MS" };
 
 #define HELP4_LENGTH 10
 const char* help4[HELP4_LENGTH] = { "4/8 DATA AND TABLES",
@@ -165,7 +169,7 @@ const char* help5[HELP5_LENGTH] = { "5/8 OPERATORS",
                                     "TR.TOG X|FLIP STATE OF TR X",
                                     "TR.PULSE X|PULSE TR X" };
 
-#define HELP6_LENGTH 31
+#define HELP6_LENGTH 35
 const char* help6[HELP6_LENGTH] = { "6/8 PRE :",
                                     " ",
                                     "EACH PRE NEEDS A : FOLLOWED",
@@ -190,6 +194,10 @@ const char* help6[HELP6_LENGTH] = { "6/8 PRE :",
                                     "NB: I IS UPDATED EACH TIME",
                                     " ",
                                     "W X:|ITERATE WHILE X",
+                                    "BUDGET N X|W YIELDS AFTER X OPS",
+                                    "BUDGET.ABORT N 1|STOP N INSTEAD",
+                                    "BUDGET.OVER N|TIMES N OVERRAN",
+                                    "BUDGET.OPS N|MOST OPS IN N",
                                     " ",
                                     "EVERY X:|EXECUTE EACH X",
                                     "SKIP X:|EXECUTE EACH BUT X",
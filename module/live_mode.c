@@ -31,6 +31,7 @@ static process_result_t output;
 static error_t status;
 static char error_msg[TELE_ERROR_MSG_LENGTH];
 static bool show_welcome_message;
+static char message[32];
 
 static const uint8_t D_INPUT = 1 << 0;
 static const uint8_t D_LIST = 1 << 1;
@@ -89,6 +90,13 @@ void set_vars_updated() {
     dirty |= D_VARS;
 }
 
+// shown once on the message line, in place of the welcome message
+void set_live_message(const char *m) {
+    strncpy(message, m, sizeof(message) - 1);
+    show_welcome_message = false;
+    dirty |= D_MESSAGE;
+}
+
 // main mode functions
 void init_live_mode() {
     status = E_OK;
@@ -212,6 +220,10 @@ uint8_t screen_refresh_live() {
             itoa(output.value, s, 10);
             output.has_value = false;
         }
+        else if (message[0]) {
+            strcpy(s, message);
+            message[0] = 0;
+        }
         else if (show_welcome_message) {
             strcpy(s, "TELETYPE: ");
             strncat(s, git_version, 35 - strlen(s));
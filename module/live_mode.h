@@ -11,5 +11,6 @@ void set_live_mode(void);
 void process_live_keys(uint8_t key, uint8_t mod_key, bool is_held_key);
 uint8_t screen_refresh_live(void);
 void set_vars_updated(void);
+void set_live_message(const char *message);
 
 #endif
@@ -30,7 +30,6 @@
 #include "util.h"
 
 // this
-#include "chaos.h"
 #include "conf_board.h"
 #include "edit_mode.h"
 #include "flash.h"
@@ -42,26 +41,24 @@
 #include "preset_r_mode.h"
 #include "preset_w_mode.h"
 #include "screensaver_mode.h"
+#include "slew.h"
 #include "teletype.h"
 #include "teletype_io.h"
 #include "usb_disk_mode.h"
 
 #ifdef TELETYPE_PROFILE
+#include "profiler.h"
 #include "profile.h"
 
-profile_t
-    prof_Script[SCRIPT_COUNT],
-    prof_Delay[DELAY_SIZE], 
-    prof_CV,
-    prof_ADC,
-    prof_ScreenRefresh;
+profile_t prof_CV, prof_ADC, prof_ScreenRefresh;
 
-void tele_profile_script(size_t s) {
-    profile_update(&prof_Script[s]);
+uint32_t tele_profile_time() {
+    return Get_system_register(AVR32_COUNT);
 }
 
-void tele_profile_delay(uint8_t d) {
-    profile_update(&prof_Delay[d]);
+static void profile_print(const char *line) {
+    print_dbg("\r\n");
+    print_dbg(line);
 }
 
 #endif
@@ -70,7 +67,7 @@ void tele_profile_delay(uint8_t d) {
 // constants
 
 #define RATE_CLOCK 10
-#define RATE_CV 6
+#define RATE_CV SLEW_RATE
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -98,17 +95,11 @@ static uint32_t ss_counter = 0;
 
 static uint16_t adc[4];
 
-typedef struct {
-    uint16_t now;
-    uint16_t off;
-    uint16_t target;
-    uint16_t slew;
-    uint16_t step;
-    int32_t delta;
-    uint32_t a;
-} aout_t;
-
-static aout_t aout[4];
+static slew_t aout[4];
+// the values last written to the DAC
+static uint16_t dac[4] = { UINT16_MAX, UINT16_MAX, UINT16_MAX, UINT16_MAX };
+// the interrupts paused while a script's CV changes are applied
+static u8 cv_irq_flags;
 static bool metro_timer_enabled;
 static uint8_t front_timer;
 static uint8_t mod_key = 0, hold_key, hold_key_count = 0;
@@ -171,32 +162,21 @@ void cvTimer_callback(void* o) {
 #ifdef TELETYPE_PROFILE
     profile_update(&prof_CV);
 #endif
-    bool updated = false;
     bool slewing = false;
 
-    for (size_t i = 0; i < 4; i++) {
-        if (aout[i].step) {
-            aout[i].step--;
-
-            if (aout[i].step == 0) { aout[i].now = aout[i].target; }
-            else {
-                aout[i].a += aout[i].delta;
-                aout[i].now = aout[i].a >> 16;
-                slewing = true;
-            }
-
-            updated = true;
-        }
-    }
+    for (size_t i = 0; i < 4; i++)
+        if (slew_step(&aout[i])) slewing = true;
 
     set_slew_icon(slewing);
 
-    if (updated) {
-        uint16_t a0 = aout[0].now >> 2;
-        uint16_t a1 = aout[1].now >> 2;
-        uint16_t a2 = aout[2].now >> 2;
-        uint16_t a3 = aout[3].now >> 2;
+    uint16_t a0 = aout[0].now >> 2;
+    uint16_t a1 = aout[1].now >> 2;
+    uint16_t a2 = aout[2].now >> 2;
+    uint16_t a3 = aout[3].now >> 2;
 
+    // the two DACs are daisy chained, each write sets a channel on both, so
+    // a write is only skipped if neither of its channels has changed
+    if (a0 != dac[0] || a2 != dac[2]) {
         spi_selectChip(DAC_SPI, DAC_SPI_NPCS);
         spi_write(DAC_SPI, 0x31);
         spi_write(DAC_SPI, a2 >> 4);
@@ -205,7 +185,11 @@ void cvTimer_callback(void* o) {
         spi_write(DAC_SPI, a0 >> 4);
         spi_write(DAC_SPI, a0 << 4);
         spi_unselectChip(DAC_SPI, DAC_SPI_NPCS);
+        dac[0] = a0;
+        dac[2] = a2;
+    }
 
+    if (a1 != dac[1] || a3 != dac[3]) {
         spi_selectChip(DAC_SPI, DAC_SPI_NPCS);
         spi_write(DAC_SPI, 0x38);
         spi_write(DAC_SPI, a3 >> 4);
@@ -214,6 +198,8 @@ void cvTimer_callback(void* o) {
         spi_write(DAC_SPI, a1 >> 4);
         spi_write(DAC_SPI, a1 << 4);
         spi_unselectChip(DAC_SPI, DAC_SPI_NPCS);
+        dac[1] = a1;
+        dac[3] = a3;
     }
 #ifdef TELETYPE_PROFILE
     profile_update(&prof_CV);
@@ -377,10 +363,16 @@ void handler_MscConnect(int32_t data) {
     }
 
     // do USB
-    tele_usb_disk();
+    uint8_t not_loaded = tele_usb_disk();
 
     // renable teletype
     set_mode(M_LIVE);
+    if (not_loaded) {
+        char s[32] = "FLASH FULL: ";
+        itoa(not_loaded, s + strlen(s), 10);
+        strcat(s, " NOT LOADED");
+        set_live_message(s);
+    }
     assign_main_event_handlers();
     irqs_resume(flags);
 }
@@ -588,7 +580,7 @@ bool process_global_keys(uint8_t k, uint8_t m, bool is_held_key) {
     else if (match_win(m, k, HID_ESCAPE)) {
         if (!is_held_key) {
             clear_delays(&scene_state);
-            for (int i = 0; i < 4; i++) { aout[i].step = 1; }
+            for (int i = 0; i < 4; i++) { slew_stop(&aout[i]); }
         }
         return true;
     }
@@ -708,33 +700,30 @@ void tele_tr(uint8_t i, int16_t v) {
 }
 
 void tele_cv(uint8_t i, int16_t v, uint8_t s) {
-    int16_t t = v + aout[i].off;
-    if (t < 0)
-        t = 0;
-    else if (t > 16383)
-        t = 16383;
-    aout[i].target = t;
-    if (s) {
-        aout[i].step = aout[i].slew;
-        aout[i].delta = ((aout[i].target - aout[i].now) << 16) / aout[i].step;
-    }
-    else {
-        aout[i].step = 1;
-        aout[i].now = aout[i].target;
-    }
+    slew_set(&aout[i], v, s);
+    timer_manual(&adcTimer);
+}
 
-    aout[i].a = aout[i].now << 16;
+// the CV timer can't run between these, so all of a script's changes are
+// written on the same update
+void tele_cv_begin() {
+    cv_irq_flags = irqs_pause();
+}
 
-    timer_manual(&adcTimer);
+void tele_cv_end() {
+    irqs_resume(cv_irq_flags);
 }
 
 void tele_cv_slew(uint8_t i, int16_t v) {
-    aout[i].slew = v / RATE_CV;
-    if (aout[i].slew == 0) aout[i].slew = 1;
+    slew_set_time(&aout[i], v);
+}
+
+void tele_cv_curve(uint8_t i, uint8_t shape) {
+    slew_set_shape(&aout[i], shape);
 }
 
 void tele_cv_off(uint8_t i, int16_t v) {
-    aout[i].off = v;
+    slew_set_off(&aout[i], v);
 }
 
 void tele_update_in(void) {
@@ -759,7 +748,7 @@ void tele_scene(uint8_t i) {
 
 void tele_kill() {
     for (int i = 0; i < 4; i++) {
-        aout[i].step = 1;
+        slew_stop(&aout[i]);
         tele_tr(i, 0);
     }
 }
@@ -836,14 +825,9 @@ int main(void) {
     metro_timer_enabled = false;
     tele_metro_updated();
 
-    // init chaos generator
-    chaos_init();
     clear_delays(&scene_state);
 
-    aout[0].slew = 1;
-    aout[1].slew = 1;
-    aout[2].slew = 1;
-    aout[3].slew = 1;
+    for (size_t i = 0; i < 4; i++) slew_init(&aout[i]);
 
     init_live_mode();
     set_mode(M_LIVE);
@@ -863,18 +847,9 @@ int main(void) {
 #ifdef TELETYPE_PROFILE
         count = (count + 1) % (FCPU_HZ / 10);
         if (count == 0) {
+            print_dbg("\r\n\r\nProfile Data (cycles)");
+            profile_dump(profile_print);
             print_dbg("\r\n\r\nProfile Data (us)");
-            for (uint8_t i = 0; i < SCRIPT_COUNT - 1; i++) {
-                print_dbg("\r\nScript ");
-                print_dbg_ulong(i);
-                print_dbg(":\t");
-                print_dbg_ulong(profile_delta_us(&prof_Script[i]));
-            }
-            uint32_t total = 0;
-            for (uint8_t i = 0; i < DELAY_SIZE; i++)
-                total += profile_delta_us(&prof_Delay[i]);
-            print_dbg("\r\nDelays (total):\t");
-            print_dbg_ulong(total);
             print_dbg("\r\nCV Write:\t");
             print_dbg_ulong(profile_delta_us(&prof_CV));
             print_dbg("\r\nADC Read:\t");
@@ -21,13 +21,13 @@ static bool dirty;
 static void do_preset_read(void);
 
 void set_preset_r_mode(uint16_t knob) {
-    knob_last = knob >> 7;
+    knob_last = (knob * SCENE_SLOTS) >> 12;
     offset = 0;
     dirty = true;
 }
 
 void process_preset_r_knob(uint16_t knob, uint8_t mod_key) {
-    uint8_t knob_now = knob >> 7;
+    uint8_t knob_now = (knob * SCENE_SLOTS) >> 12;
     if (knob_now != knob_last) {
         preset_select = knob_now;
         knob_last = knob_now;
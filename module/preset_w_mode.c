@@ -27,14 +27,30 @@ static const uint8_t D_LIST = 1 << 1;
 static const uint8_t D_ALL = 0xFF;
 static uint8_t dirty;
 
+// the last save didn't fit in the flash, shown until the next key
+static bool save_failed;
+
+// only a line that has changed makes the text need saving
+static void set_text_line(uint8_t line, const char *text) {
+    if (!strcmp(scene_text[line], text)) return;
+    strcpy(scene_text[line], text);
+    ss_set_dirty(&scene_state, SS_DIRTY_TEXT);
+}
+
 void set_preset_w_mode() {
     edit_line = 0;
     edit_offset = 0;
     line_editor_set(&le, scene_text[0]);
+    save_failed = false;
     dirty = D_ALL;
 }
 
 void process_preset_w_keys(uint8_t k, uint8_t m, bool is_held_key) {
+    if (save_failed) {
+        save_failed = false;
+        dirty |= D_LIST;
+    }
+
     // <down> or C-n: line down
     if (match_no_mod(m, k, HID_DOWN) || match_ctrl(m, k, HID_N)) {
         if ((edit_offset + edit_line) < 31) {
@@ -71,7 +87,7 @@ void process_preset_w_keys(uint8_t k, uint8_t m, bool is_held_key) {
     }
     // <enter>: enter text
     else if (match_no_mod(m, k, HID_ENTER)) {
-        strcpy(scene_text[edit_line + edit_offset], line_editor_get(&le));
+        set_text_line(edit_line + edit_offset, line_editor_get(&le));
         if (edit_line + edit_offset < 31) {
             if (edit_line == 5)
                 edit_offset++;
@@ -85,17 +101,24 @@ void process_preset_w_keys(uint8_t k, uint8_t m, bool is_held_key) {
     // shift-<enter>: insert text
     else if (match_shift(m, k, HID_ENTER)) {
         for (uint8_t i = SCENE_TEXT_LINES - 1; i > edit_line + edit_offset; i--)
-            strcpy(scene_text[i], scene_text[i - 1]);  // overwrites final line!
-        strcpy(scene_text[edit_line + edit_offset], line_editor_get(&le));
+            set_text_line(i, scene_text[i - 1]);  // overwrites final line!
+        set_text_line(edit_line + edit_offset, line_editor_get(&le));
         dirty |= D_LIST;
     }
     // alt-<enter>: save preset
     else if (match_alt(m, k, HID_ENTER)) {
         if (!is_held_key) {
-            strcpy(scene_text[edit_line + edit_offset], line_editor_get(&le));
-            flash_write(preset_select, &scene_state, &scene_text);
-            flash_update_last_saved_scene(preset_select);
-            set_last_mode();
+            set_text_line(edit_line + edit_offset, line_editor_get(&le));
+            // the slot keeps its old scene if the new one doesn't fit, so
+            // stay here to say so rather than leave as if it had saved
+            if (flash_write(preset_select, &scene_state, &scene_text)) {
+                flash_update_last_saved_scene(preset_select);
+                set_last_mode();
+            }
+            else {
+                save_failed = true;
+                dirty |= D_LIST;
+            }
         }
     }
     else {  // pass to line editor
@@ -114,7 +137,8 @@ uint8_t screen_refresh_preset_w() {
         itoa(preset_select, header + 4, 10);
         region_fill(&line[0], 1);
         font_string_region_clip_right(&line[0], header, 126, 0, 0xf, 1);
-        font_string_region_clip(&line[0], "WRITE", 2, 0, 0xf, 1);
+        font_string_region_clip(&line[0], save_failed ? "FLASH FULL" : "WRITE",
+                                2, 0, 0xf, 1);
 
         for (uint8_t y = 1; y < 7; y++) {
             uint8_t a = edit_line == (y - 1);
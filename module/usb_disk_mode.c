@@ -1,12 +1,14 @@
 #include "usb_disk_mode.h"
 
-#include <ctype.h>
 #include <stdint.h>
 #include <string.h>
 
 // this
 #include "flash.h"
 #include "globals.h"
+#include "helpers.h"
+#include "scene_binary.h"
+#include "scene_text.h"
 #include "teletype.h"
 
 // libavr32
@@ -26,8 +28,31 @@
 #include "usb_protocol_msc.h"
 
 
-void tele_usb_disk() {
-    char input_buffer[32];
+static bool file_write(void *NOTUSED(context), const uint8_t *data,
+                       uint16_t length) {
+    return file_write_buf((uint8_t *)data, length) == length;
+}
+
+static void print_error(void *NOTUSED(context), uint16_t line, error_t status,
+                        const char *message) {
+    print_dbg("\r\nline ");
+    print_dbg_ulong(line);
+    print_dbg(": ");
+    print_dbg(tele_error(status));
+    if (message[0]) {
+        print_dbg(": ");
+        print_dbg(message);
+    }
+}
+
+// too big for the stack, the reader reads into the writer's buffer
+static scene_text_writer_t writer;
+static scene_text_reader_t reader;
+
+uint8_t tele_usb_disk() {
+    // a dot for every 4 scenes after WRITE or READ
+    char input_buffer[6 + SCENE_SLOTS / 4];
+    uint8_t not_loaded = 0;
     print_dbg("\r\nusb");
 
     uint8_t lun_state = 0;
@@ -63,16 +88,20 @@ void tele_usb_disk() {
         region_draw(&line[0]);
 
         for (int i = 0; i < SCENE_SLOTS; i++) {
-            scene_state_t scene;
+            // too big for the stack
+            static scene_state_t scene;
             ss_init(&scene);
 
             char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
             memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
 
-            strcat(input_buffer, ".");
-            region_fill(&line[0], 0);
-            font_string_region_clip_tab(&line[0], input_buffer, 2, 0, 0xa, 0);
-            region_draw(&line[0]);
+            if (i % 4 == 0) {
+                strcat(input_buffer, ".");
+                region_fill(&line[0], 0);
+                font_string_region_clip_tab(&line[0], input_buffer, 2, 0, 0xa,
+                                            0);
+                region_draw(&line[0]);
+            }
 
             flash_read(i, &scene, &text);
 
@@ -99,96 +128,30 @@ void tele_usb_disk() {
                 continue;
             }
 
-            char blank = 0;
-            for (int l = 0; l < SCENE_TEXT_LINES; l++) {
-                if (strlen(text[l])) {
-                    file_write_buf((uint8_t*)text[l], strlen(text[l]));
-                    file_putc('\n');
-                    blank = 0;
-                }
-                else if (!blank) {
-                    file_putc('\n');
-                    blank = 1;
-                }
-            }
-
-            char input[36];
-            for (int s = 0; s < 10; s++) {
-                file_putc('\n');
-                file_putc('\n');
-                file_putc('#');
-                if (s == 8)
-                    file_putc('M');
-                else if (s == 9)
-                    file_putc('I');
-                else
-                    file_putc(s + 49);
-
-                for (int l = 0; l < ss_get_script_len(&scene, s); l++) {
-                    file_putc('\n');
-                    print_command(ss_get_script_command(&scene, s, l), input);
-                    file_write_buf((uint8_t*)input, strlen(input));
-                }
-            }
-
-            file_putc('\n');
-            file_putc('\n');
-            file_putc('#');
-            file_putc('P');
-            file_putc('\n');
-
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_len(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
-
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_wrap(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
-
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_start(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
-
-            for (int b = 0; b < 4; b++) {
-                itoa(ss_get_pattern_end(&scene, b), input, 10);
-                file_write_buf((uint8_t*)input, strlen(input));
-                if (b == 3)
-                    file_putc('\n');
-                else
-                    file_putc('\t');
-            }
-
-            file_putc('\n');
+            scene_text_writer_init(&writer, file_write, NULL);
+            if (!scene_text_write(&writer, &scene, &text[0][0],
+                                  SCENE_TEXT_LINES, SCENE_TEXT_CHARS))
+                print_dbg("\r\ncan't write scene");
+            file_close();
+            lun_state |= (1 << lun);  // LUN test is done.
 
-            for (int l = 0; l < 64; l++) {
-                for (int b = 0; b < 4; b++) {
-                    itoa(ss_get_pattern_val(&scene, b, l), input, 10);
-                    file_write_buf((uint8_t*)input, strlen(input));
-                    if (b == 3)
-                        file_putc('\n');
-                    else
-                        file_putc('\t');
+            // and in the binary format, as ttNNs.ttb
+            char binary_filename[13];
+            strcpy(binary_filename, filename);
+            strcpy(binary_filename + 6, "ttb");
+            if (nav_file_create((FS_STRING)binary_filename) ||
+                fs_g_status == FS_ERR_FILE_EXIST) {
+                if (file_open(FOPEN_MODE_W)) {
+                    scene_text_writer_init(&writer, file_write, NULL);
+                    const scene_binary_writer_t binary_writer =
+                        scene_text_binary_writer(&writer);
+                    scene_binary_write(&scene, &text[0][0], SCENE_TEXT_LINES,
+                                       SCENE_TEXT_CHARS, &binary_writer, NULL);
+                    scene_text_flush(&writer);
+                    file_close();
                 }
             }
 
-            file_close();
-            lun_state |= (1 << lun);  // LUN test is done.
-
             if (filename[3] == '9') {
                 filename[3] = '0';
                 filename[2]++;
@@ -212,176 +175,43 @@ void tele_usb_disk() {
         region_draw(&line[1]);
 
         for (int i = 0; i < SCENE_SLOTS; i++) {
-            scene_state_t scene;
+            // too big for the stack
+            static scene_state_t scene;
             ss_init(&scene);
             char text[SCENE_TEXT_LINES][SCENE_TEXT_CHARS];
             memset(text, 0, SCENE_TEXT_LINES * SCENE_TEXT_CHARS);
 
-            strcat(input_buffer, ".");
-            region_fill(&line[1], 0);
-            font_string_region_clip_tab(&line[1], input_buffer, 2, 0, 0xa, 0);
-            region_draw(&line[1]);
+            if (i % 4 == 0) {
+                strcat(input_buffer, ".");
+                region_fill(&line[1], 0);
+                font_string_region_clip_tab(&line[1], input_buffer, 2, 0, 0xa,
+                                            0);
+                region_draw(&line[1]);
+            }
             if (nav_filelist_findname(filename, 0)) {
                 print_dbg("\r\nfound: ");
                 print_dbg(filename);
                 if (!file_open(FOPEN_MODE_R))
                     print_dbg("\r\ncan't open");
                 else {
-                    char c;
-                    uint8_t l = 0;
-                    uint8_t p = 0;
-                    int8_t s = 99;
-                    uint8_t b = 0;
-                    uint16_t num = 0;
-                    int8_t neg = 1;
-
-                    char input[32];
-                    memset(input, 0, sizeof(input));
-
-                    while (!file_eof() && s != -1) {
-                        c = toupper(file_getc());
-                        // print_dbg_char(c);
-
-                        if (c == '#') {
-                            if (!file_eof()) {
-                                c = toupper(file_getc());
-                                // print_dbg_char(c);
-
-                                if (c == 'M')
-                                    s = 8;
-                                else if (c == 'I')
-                                    s = 9;
-                                else if (c == 'P')
-                                    s = 10;
-                                else {
-                                    s = c - 49;
-                                    if (s < 0 || s > 7) s = -1;
-                                }
-
-                                l = 0;
-                                p = 0;
-
-                                if (!file_eof()) c = toupper(file_getc());
-                            }
-                            else
-                                s = -1;
-
-                            // print_dbg("\r\nsection: ");
-                            // print_dbg_ulong(s);
-                        }
-                        // SCENE TEXT
-                        else if (s == 99) {
-                            if (c == '\n') {
-                                l++;
-                                p = 0;
-                            }
-                            else {
-                                if (l < SCENE_TEXT_LINES &&
-                                    p < SCENE_TEXT_CHARS) {
-                                    text[l][p] = c;
-                                    p++;
-                                }
-                            }
-                        }
-                        // SCRIPTS
-                        else if (s >= 0 && s <= 9) {
-                            if (c == '\n') {
-                                if (p && l < SCRIPT_MAX_COMMANDS) {
-                                    tele_command_t temp;
-                                    error_t status;
-                                    char error_msg[TELE_ERROR_MSG_LENGTH];
-                                    status = parse(input, &temp, error_msg);
-
-                                    if (status == E_OK) {
-                                        status = validate(&temp, error_msg);
-
-                                        if (status == E_OK) {
-                                            ss_overwrite_script_command(
-                                                &scene, s, l, &temp);
-                                            l++;
-                                        }
-                                        else {
-                                            print_dbg("\r\nvalidate: ");
-                                            print_dbg(tele_error(status));
-                                            print_dbg(" >> ");
-                                            print_dbg("\r\nINPUT: ");
-                                            print_dbg(input);
-                                        }
-                                    }
-                                    else {
-                                        print_dbg("\r\nERROR: ");
-                                        print_dbg(tele_error(status));
-                                        print_dbg(" >> ");
-                                        print_dbg("\r\nINPUT: ");
-                                        print_dbg(input);
-                                    }
-
-                                    memset(input, 0, sizeof(input));
-                                    p = 0;
-                                }
-                            }
-                            else {
-                                if (p < 32) input[p] = c;
-                                p++;
-                            }
-                        }
-                        // PATTERNS
-                        // tele_patterns[]. l wrap start end v[64]
-                        else if (s == 10) {
-                            if (c == '\n' || c == '\t') {
-                                if (b < 4) {
-                                    if (l > 3) {
-                                        ss_set_pattern_val(&scene, b, l - 4,
-                                                           neg * num);
-                                        // print_dbg("\r\nset: ");
-                                        // print_dbg_ulong(b);
-                                        // print_dbg(" ");
-                                        // print_dbg_ulong(l-4);
-                                        // print_dbg(" ");
-                                        // print_dbg_ulong(num);
-                                    }
-                                    else if (l == 0) {
-                                        ss_set_pattern_len(&scene, b, num);
-                                    }
-                                    else if (l == 1) {
-                                        ss_set_pattern_wrap(&scene, b, num);
-                                    }
-                                    else if (l == 2) {
-                                        ss_set_pattern_start(&scene, b, num);
-                                    }
-                                    else if (l == 3) {
-                                        ss_set_pattern_end(&scene, b, num);
-                                    }
-                                }
-
-                                b++;
-                                num = 0;
-                                neg = 1;
-
-                                if (c == '\n') {
-                                    if (p) l++;
-                                    if (l > 68) s = -1;
-                                    b = 0;
-                                    p = 0;
-                                }
-                            }
-                            else {
-                                if (c == '-')
-                                    neg = -1;
-                                else if (c >= '0' && c <= '9') {
-                                    num = num * 10 + (c - 48);
-                                    // print_dbg("\r\nnum: ");
-                                    // print_dbg_ulong(num);
-                                }
-                                p++;
-                            }
-                        }
+                    scene_text_reader_init(&reader, &scene, &text[0][0],
+                                           SCENE_TEXT_LINES, SCENE_TEXT_CHARS,
+                                           print_error, NULL);
+                    while (!file_eof()) {
+                        const uint16_t n = file_read_buf(writer.buffer,
+                                                         sizeof(writer.buffer));
+                        if (n == 0) break;
+                        scene_text_read(&reader, writer.buffer, n);
                     }
-
+                    scene_text_read_end(&reader);
 
                     file_close();
 
-                    flash_write(i, &scene, &text);
+                    // the slot keeps its old scene
+                    if (!flash_write(i, &scene, &text)) {
+                        print_dbg("\r\nflash full, not loaded");
+                        not_loaded++;
+                    }
                 }
             }
 
@@ -397,4 +227,5 @@ void tele_usb_disk() {
     }
 
     nav_exit();
+    return not_loaded;
 }
@@ -1,6 +1,9 @@
 #ifndef _USB_DISK_MODE_H_
 #define _USB_DISK_MODE_H_
 
-void tele_usb_disk(void);
+#include <stdint.h>
+
+// returns the number of scenes read that didn't fit in the flash
+uint8_t tele_usb_disk(void);
 
 #endif
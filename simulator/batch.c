@@ -0,0 +1,481 @@
+#define _POSIX_C_SOURCE 199309L  // clock_gettime
+
+#include "batch.h"
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "profiler.h"
+#include "scene_text.h"
+#include "slew.h"
+#include "teletype.h"
+#include "teletype_io.h"
+
+// usage:
+//   tt -s scene.txt [-e schedule.txt] [-t seconds] [-o trace.txt] [-r seed]
+//      [-p] [-b] [-v]
+//
+// -p prints the profiler data to stderr at the end, if tt was built with
+// PROFILE=1, and -b prints the budget stats of each script that ran (see
+// BUDGET) and the i2c queue's counters
+//
+// -v renders the CV outputs as the module's CV timer would, tracing the value
+// sent to each DAC every SLEW_RATE ms while it slews, e.g. "252 CV.OUT 0 1365"
+//
+// the schedule file has one input event per line, times are in milliseconds
+// of virtual time and '#' starts a comment:
+//
+//   0     IN 8192      set IN to 8192
+//   0     PARAM 16383  set PARAM to 16383
+//   250   TR 1         trigger input 1 (runs script 1 unless muted)
+//   250   STATE 1 1    set the level returned by STATE 1
+//   1000  METRO        run the metro script once
+//
+// the trace has one output event per line, prefixed with the virtual time in
+// milliseconds, e.g. "250 CV 0 8192 1"
+
+typedef enum { EV_TR, EV_STATE, EV_IN, EV_PARAM, EV_METRO } event_type_t;
+
+typedef struct {
+    uint32_t time;
+    uint32_t order;
+    event_type_t type;
+    int16_t a;
+    int16_t b;
+} event_t;
+
+// everything a run needs, so that runs can happen on several threads at once
+typedef struct {
+    scene_state_t scene;
+    FILE *trace;
+    uint32_t now;
+    uint32_t events;
+
+    bool metro_enabled;
+    uint32_t metro_period;
+    uint32_t metro_next;
+
+    bool input_states[TRIGGER_INPUTS];
+
+    bool render_cv;
+    slew_t outputs[CV_COUNT];
+} batch_t;
+
+// the run the io callbacks on this thread belong to
+static __thread batch_t *current = NULL;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// io
+
+bool batch_active() {
+    return current != NULL;
+}
+
+bool batch_trace(const char *fmt, ...) {
+    if (!current) return false;
+
+    current->events++;
+    if (current->trace) {
+        va_list args;
+        va_start(args, fmt);
+        fprintf(current->trace, "%" PRIu32 " ", current->now);
+        vfprintf(current->trace, fmt, args);
+        fputc('\n', current->trace);
+        va_end(args);
+    }
+    return true;
+}
+
+void batch_cv(uint8_t i, int16_t v, bool slewed) {
+    if (current) slew_set(&current->outputs[i], v, slewed);
+}
+
+void batch_cv_slew(uint8_t i, int16_t v) {
+    if (current) slew_set_time(&current->outputs[i], v);
+}
+
+void batch_cv_off(uint8_t i, int16_t v) {
+    if (current) slew_set_off(&current->outputs[i], v);
+}
+
+void batch_cv_curve(uint8_t i, uint8_t shape) {
+    if (current) slew_set_shape(&current->outputs[i], shape);
+}
+
+void batch_metro_updated() {
+    batch_t *b = current;
+    uint32_t metro_time = b->scene.variables.m;
+    if (metro_time < METRO_MIN_UNSUPPORTED_MS)
+        metro_time = METRO_MIN_UNSUPPORTED_MS;
+    b->metro_period = metro_time;
+
+    if (b->scene.variables.m_act && !b->metro_enabled) {
+        b->metro_enabled = true;
+        b->metro_next = b->now + b->metro_period;
+    }
+    else if (!b->scene.variables.m_act) {
+        b->metro_enabled = false;
+    }
+}
+
+void batch_metro_reset() {
+    batch_t *b = current;
+    if (b->metro_enabled) b->metro_next = b->now + b->metro_period;
+}
+
+bool batch_get_input_state(uint8_t n) {
+    return n < TRIGGER_INPUTS && current->input_states[n];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// scene file
+
+static void print_error(void *context, uint16_t line, error_t status,
+                        const char *message) {
+    fprintf(stderr, "%s:%" PRIu16 ": %s", (const char *)context, line,
+            tele_error(status));
+    if (message[0]) fprintf(stderr, ": %s", message);
+    fprintf(stderr, "\n");
+}
+
+// same format and rules as the USB disk import on the module
+static bool load_scene(const char *path, scene_state_t *ss) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "can't open scene: %s\n", path);
+        return false;
+    }
+
+    scene_text_reader_t r;
+    scene_text_reader_init(&r, ss, NULL, 0, 0, print_error, (void *)path);
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        scene_text_read(&r, chunk, n);
+    scene_text_read_end(&r);
+
+    fclose(f);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// schedule file
+
+static int compare_events(const void *a, const void *b) {
+    const event_t *x = a, *y = b;
+    if (x->time != y->time) return x->time < y->time ? -1 : 1;
+    return x->order < y->order ? -1 : x->order > y->order;
+}
+
+static event_t *load_schedule(const char *path, size_t *count) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "can't open schedule: %s\n", path);
+        return NULL;
+    }
+
+    size_t size = 64;
+    event_t *events = malloc(size * sizeof(event_t));
+    char line[128];
+    unsigned line_no = 0;
+    *count = 0;
+
+    while (events && fgets(line, sizeof(line), f)) {
+        line_no++;
+        char *comment = strchr(line, '#');
+        if (comment) *comment = 0;
+
+        uint32_t time;
+        char name[16];
+        int a = 0, b = 0;
+        int n = sscanf(line, "%" SCNu32 " %15s %d %d", &time, name, &a, &b);
+        if (n <= 0) continue;
+
+        event_t e = { .time = time, .order = *count, .a = a, .b = b };
+        for (char *c = name; *c; c++) *c = toupper(*c);
+
+        if (n >= 3 && !strcmp(name, "TR") && a >= 1 && a <= TRIGGER_INPUTS)
+            e.type = EV_TR;
+        else if (n == 4 && !strcmp(name, "STATE") && a >= 1 &&
+                 a <= TRIGGER_INPUTS)
+            e.type = EV_STATE;
+        else if (n >= 3 && !strcmp(name, "IN"))
+            e.type = EV_IN;
+        else if (n >= 3 && !strcmp(name, "PARAM"))
+            e.type = EV_PARAM;
+        else if (n >= 2 && !strcmp(name, "METRO"))
+            e.type = EV_METRO;
+        else {
+            fprintf(stderr, "%s:%u: bad event\n", path, line_no);
+            free(events);
+            events = NULL;
+            break;
+        }
+
+        if (*count == size) {
+            size *= 2;
+            event_t *grown = realloc(events, size * sizeof(event_t));
+            if (!grown) {
+                free(events);
+                events = NULL;
+                break;
+            }
+            events = grown;
+        }
+        events[(*count)++] = e;
+    }
+
+    fclose(f);
+    if (events) qsort(events, *count, sizeof(event_t), compare_events);
+    return events;
+}
+
+static void run_event(batch_t *b, const event_t *e) {
+    scene_state_t *ss = &b->scene;
+    switch (e->type) {
+        case EV_TR:
+            if (!ss_get_mute(ss, e->a - 1)) run_script(ss, e->a - 1);
+            break;
+        case EV_STATE: b->input_states[e->a - 1] = e->b != 0; break;
+        case EV_IN: ss_set_in(ss, e->a); break;
+        case EV_PARAM: ss_set_param(ss, e->a); break;
+        case EV_METRO: run_script(ss, METRO_SCRIPT); break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// main loop
+
+#ifdef TELETYPE_PROFILE
+static void print_profile(const char *line) {
+    fprintf(stderr, "%s\n", line);
+}
+#endif
+
+static bool cv_slewing(batch_t *b) {
+    for (uint8_t i = 0; i < CV_COUNT; i++)
+        if (b->outputs[i].step) return true;
+    return false;
+}
+
+// the CV timer runs every SLEW_RATE ms from boot, each output that has
+// somewhere to go takes a step and its new value is traced
+static void step_cv(batch_t *b) {
+    for (uint8_t i = 0; i < CV_COUNT; i++) {
+        slew_t *s = &b->outputs[i];
+        if (s->step == 0) continue;
+        slew_step(s);
+        batch_trace("CV.OUT %" PRIu8 " %" PRIu16, i, s->now);
+    }
+}
+
+// advance virtual time to `until`, stopping wherever the scene has something
+// due so that delays, pulses and TIME see the same ms as on the module
+static void advance(batch_t *b, uint32_t until) {
+    while (b->now < until) {
+        uint32_t next = until;
+        int16_t d = tele_next_deadline(&b->scene);
+        if (d >= 0 && b->now + d < next) next = b->now + d;
+        if (b->metro_enabled && b->metro_next < next) next = b->metro_next;
+        if (b->render_cv && cv_slewing(b)) {
+            uint32_t step = (b->now / SLEW_RATE + 1) * SLEW_RATE;
+            if (step < next) next = step;
+        }
+
+        uint32_t dt = next - b->now;
+        b->now = next;
+        if (b->render_cv && b->now % SLEW_RATE == 0) step_cv(b);
+        tele_tick(&b->scene, dt);
+
+        if (b->metro_enabled && b->metro_next <= b->now) {
+            b->metro_next += b->metro_period;
+            if (ss_get_script_len(&b->scene, METRO_SCRIPT))
+                run_script(&b->scene, METRO_SCRIPT);
+        }
+    }
+}
+
+static uint64_t wall_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+int batch_run(const batch_options_t *o, batch_stats_t *stats) {
+    const uint64_t start = wall_ns();
+
+    event_t *events = NULL;
+    size_t event_count = 0;
+    if (o->schedule_path) {
+        events = load_schedule(o->schedule_path, &event_count);
+        if (!events) return 1;
+    }
+
+    // too big for a thread's stack
+    batch_t *b = calloc(1, sizeof(batch_t));
+    if (!b) {
+        free(events);
+        return 1;
+    }
+
+    b->render_cv = o->render_cv;
+    for (uint8_t i = 0; i < CV_COUNT; i++) slew_init(&b->outputs[i]);
+
+    ss_init(&b->scene);
+    ss_rand_seed(&b->scene, o->seed);
+    ss_reset_in_cal(&b->scene);
+    ss_reset_param_cal(&b->scene);
+    if (!load_scene(o->scene_path, &b->scene)) {
+        free(b);
+        free(events);
+        return 1;
+    }
+
+    if (o->trace_path && !(b->trace = fopen(o->trace_path, "w"))) {
+        fprintf(stderr, "can't open trace: %s\n", o->trace_path);
+        free(b);
+        free(events);
+        return 1;
+    }
+    if (o->trace_stdout) b->trace = stdout;
+
+    const uint32_t end = (uint32_t)(o->seconds * 1000);
+    size_t e = 0;
+    current = b;
+
+    run_script(&b->scene, INIT_SCRIPT);
+    b->scene.initializing = false;
+
+    while (e < event_count && events[e].time <= end) {
+        advance(b, events[e].time);
+        while (e < event_count && events[e].time == b->now)
+            run_event(b, &events[e++]);
+    }
+    advance(b, end);
+
+    current = NULL;
+    if (b->trace && b->trace != stdout) fclose(b->trace);
+
+    if (stats) {
+        stats->virtual_ms = b->now;
+        stats->events = b->events;
+        stats->delays_dropped = ss_delay_dropped(&b->scene);
+        stats->overruns = 0;
+        for (uint8_t i = 0; i < SCRIPT_COUNT; i++) {
+            stats->scripts[i] = *ss_get_script_stats(&b->scene, i);
+            stats->overruns += stats->scripts[i].overruns;
+        }
+        stats->ii_queued = b->scene.ii.queued;
+        stats->ii_sent = b->scene.ii.sent;
+        stats->ii_coalesced = b->scene.ii.coalesced;
+        stats->ii_dropped = b->scene.ii.dropped;
+        stats->ii_late = b->scene.ii.late;
+        stats->wall_ns = wall_ns() - start;
+    }
+
+    free(b);
+    free(events);
+    return 0;
+}
+
+// scripts are named as they are on the module
+static void print_budget(const batch_stats_t *stats) {
+    const char *names[SCRIPT_COUNT] = { "1", "2", "3", "4", "5", "6",
+                                        "7", "8", "M", "I", "T" };
+    for (uint8_t i = 0; i < SCRIPT_COUNT; i++) {
+        const scene_script_stats_t *s = &stats->scripts[i];
+        if (s->ops == 0) continue;
+        fprintf(stderr,
+                "SCRIPT %s OVERRUNS %" PRIu16 " OPS %" PRIu32
+                " DEPTH %u STACK %u W %" PRIu16 "\n",
+                names[i], s->overruns, s->ops, s->depth, s->stack, s->w);
+    }
+}
+
+static void print_ii(const batch_stats_t *stats) {
+    if (stats->ii_queued == 0) return;
+    fprintf(stderr,
+            "II QUEUED %" PRIu32 " SENT %" PRIu32 " COALESCED %" PRIu32
+            " DROPPED %" PRIu32 " LATE %" PRIu32 "\n",
+            stats->ii_queued, stats->ii_sent, stats->ii_coalesced,
+            stats->ii_dropped, stats->ii_late);
+}
+
+int batch_main(int argc, char **argv) {
+    batch_options_t o = { .seconds = 10, .seed = 1, .trace_stdout = true };
+    bool profile = false;
+    bool budget = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (!strcmp(arg, "-p")) {
+            profile = true;
+            continue;
+        }
+        if (!strcmp(arg, "-b")) {
+            budget = true;
+            continue;
+        }
+        if (!strcmp(arg, "-v")) {
+            o.render_cv = true;
+            continue;
+        }
+        if (!val) arg = "";
+
+        if (!strcmp(arg, "-s"))
+            o.scene_path = val;
+        else if (!strcmp(arg, "-e"))
+            o.schedule_path = val;
+        else if (!strcmp(arg, "-o")) {
+            o.trace_path = val;
+            o.trace_stdout = false;
+        }
+        else if (!strcmp(arg, "-t"))
+            o.seconds = atof(val);
+        else if (!strcmp(arg, "-r"))
+            o.seed = strtoul(val, NULL, 10);
+        else {
+            fprintf(stderr,
+                    "usage: %s -s scene.txt [-e schedule.txt] [-t seconds] "
+                    "[-o trace.txt] [-r seed] [-p] [-b] [-v]\n",
+                    argv[0]);
+            return 2;
+        }
+        i++;
+    }
+    if (!o.scene_path || o.seconds < 0) {
+        fprintf(stderr, "%s: a scene file is required\n", argv[0]);
+        return 2;
+    }
+
+    batch_stats_t stats;
+    int status = batch_run(&o, &stats);
+    if (status) return status;
+
+    fprintf(stderr,
+            "%" PRIu32 " ms run, %" PRIu16 " delays dropped, %" PRIu32
+            " budget overruns\n",
+            stats.virtual_ms, stats.delays_dropped, stats.overruns);
+    if (budget) {
+        print_budget(&stats);
+        print_ii(&stats);
+    }
+#ifdef TELETYPE_PROFILE
+    if (profile) profile_dump(print_profile);
+#else
+    if (profile) fprintf(stderr, "built without PROFILE=1\n");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "state.h"
+
+// headless runner: loads a scene in the USB text format, feeds it inputs
+// from a schedule file and runs it in virtual time as fast as possible,
+// writing every output event to a trace
+
+typedef struct {
+    const char *scene_path;
+    const char *schedule_path;  // optional
+    const char *trace_path;     // optional
+    bool trace_stdout;
+    double seconds;
+    uint32_t seed;
+    bool render_cv;  // trace each step of the CV outputs' slews
+} batch_options_t;
+
+typedef struct {
+    uint32_t virtual_ms;
+    uint32_t events;  // output events, whether or not they were traced
+    uint16_t delays_dropped;
+    uint32_t overruns;  // of every script's budget
+    scene_script_stats_t scripts[SCRIPT_COUNT];
+    // i2c messages, as counted by the queue (see ii_queue.h)
+    uint32_t ii_queued;
+    uint32_t ii_sent;
+    uint32_t ii_coalesced;
+    uint32_t ii_dropped;
+    uint32_t ii_late;
+    uint64_t wall_ns;
+} batch_stats_t;
+
+// runs one scene to the end, returns 0 on success. Runs on different threads
+// don't share any state.
+int batch_run(const batch_options_t *options, batch_stats_t *stats);
+
+// returns the process exit status
+int batch_main(int argc, char **argv);
+
+// true while a run is active on this thread
+bool batch_active(void);
+
+// returns true if a run is active on this thread and has taken the event, the
+// io callbacks fall back to the interactive output otherwise
+bool batch_trace(const char *fmt, ...);
+
+// the CV outputs are rendered with the module's slew engine (see slew.h)
+void batch_cv(uint8_t i, int16_t v, bool slewed);
+void batch_cv_slew(uint8_t i, int16_t v);
+void batch_cv_off(uint8_t i, int16_t v);
+void batch_cv_curve(uint8_t i, uint8_t shape);
+
+void batch_metro_updated(void);
+void batch_metro_reset(void);
+bool batch_get_input_state(uint8_t n);
+
+#endif
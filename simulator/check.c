@@ -0,0 +1,126 @@
+#define _POSIX_C_SOURCE 200809L  // strdup, opendir
+
+#include "check.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "scene_text.h"
+
+// usage:
+//   tt -c scene.txt | directory ...
+//
+// every tt*.txt file in a directory is checked (as on a USB stick, case
+// doesn't matter). Errors are printed as "path:line: error", with a summary
+// on stderr, and the exit status is 1 if any line won't load.
+
+static char **paths = NULL;
+static size_t path_count = 0;
+static size_t path_size = 0;
+
+static bool add_path(const char *path) {
+    if (path_count == path_size) {
+        path_size = path_size ? path_size * 2 : 64;
+        char **grown = realloc(paths, path_size * sizeof(char *));
+        if (!grown) return false;
+        paths = grown;
+    }
+    paths[path_count++] = strdup(path);
+    return true;
+}
+
+static bool is_scene_name(const char *name) {
+    const size_t length = strlen(name);
+    if (length < 6) return false;
+    if (toupper(name[0]) != 'T' || toupper(name[1]) != 'T') return false;
+    const char *ext = name + length - 4;
+    return ext[0] == '.' && toupper(ext[1]) == 'T' &&
+           toupper(ext[2]) == 'X' && toupper(ext[3]) == 'T';
+}
+
+static int compare_paths(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static bool add_directory(const char *path) {
+    DIR *d = opendir(path);
+    if (!d) {
+        fprintf(stderr, "can't open directory: %s\n", path);
+        return false;
+    }
+
+    const size_t first = path_count;
+    struct dirent *e;
+    bool ok = true;
+    while (ok && (e = readdir(d))) {
+        if (!is_scene_name(e->d_name)) continue;
+        char *full = malloc(strlen(path) + strlen(e->d_name) + 2);
+        sprintf(full, "%s/%s", path, e->d_name);
+        ok = add_path(full);
+        free(full);
+    }
+    closedir(d);
+
+    qsort(paths + first, path_count - first, sizeof(char *), compare_paths);
+    return ok;
+}
+
+static void print_error(void *context, uint16_t line, error_t status,
+                        const char *message) {
+    printf("%s:%" PRIu16 ": %s", (const char *)context, line,
+           tele_error(status));
+    if (message[0]) printf(": %s", message);
+    printf("\n");
+}
+
+// returns the number of errors, or -1 if the file can't be read
+static int check_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        printf("%s: can't open\n", path);
+        return -1;
+    }
+
+    static scene_text_reader_t r;
+    static uint8_t chunk[4096];
+    scene_text_reader_init(&r, NULL, NULL, 0, 0, print_error, (void *)path);
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        scene_text_read(&r, chunk, n);
+    fclose(f);
+    return scene_text_read_end(&r);
+}
+
+int check_main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s -c scene.txt | directory ...\n", argv[0]);
+        return 2;
+    }
+
+    for (int i = 2; i < argc; i++) {
+        struct stat st;
+        bool ok = stat(argv[i], &st) == 0 && S_ISDIR(st.st_mode)
+                      ? add_directory(argv[i])
+                      : add_path(argv[i]);
+        if (!ok) return 1;
+    }
+
+    size_t failed = 0, errors = 0;
+    for (size_t i = 0; i < path_count; i++) {
+        const int result = check_file(paths[i]);
+        if (result) failed++;
+        if (result > 0) errors += result;
+        free(paths[i]);
+    }
+    free(paths);
+
+    fprintf(stderr, "%zu files, %zu with errors, %zu lines won't load\n",
+            path_count, failed, errors);
+    return failed ? 1 : 0;
+}
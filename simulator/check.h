@@ -0,0 +1,10 @@
+#ifndef _CHECK_H_
+#define _CHECK_H_
+
+// checks scene files in the USB text format without running them, and prints
+// every line that won't load
+
+// returns the process exit status
+int check_main(int argc, char **argv);
+
+#endif
@@ -0,0 +1,274 @@
+#define _POSIX_C_SOURCE 200809L  // strdup, sysconf, clock_gettime
+
+#include "farm.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "batch.h"
+
+// usage:
+//   tt -j threads [-t seconds] [-n seeds] [-e schedule.txt] [-d trace_dir]
+//      scene.txt ... | @jobs.txt ...
+//
+// every scene is a job, as is every line of a jobs file:
+//
+//   scene.txt [schedule.txt|-] [seed]
+//
+// -n runs each job with seeds 1 to n (sweeping RAND, TOSS, etc.) unless it
+// names its own seed, -e is the schedule for jobs that don't name their own,
+// and -d writes the trace of job n to trace_dir/n.txt. -j 0 uses one thread
+// per core.
+//
+// one tab separated line of stats is printed per job, in job order, with a
+// summary on stderr
+
+typedef struct {
+    batch_options_t options;
+    batch_stats_t stats;
+    int status;
+    int worker;
+    char *trace_path;
+} job_t;
+
+// each worker owns a deque of jobs, it takes from the back of its own and
+// steals from the front of the others when it runs out
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    size_t *jobs;
+    size_t front;
+    size_t back;
+    int id;
+    uint32_t run;
+    uint32_t stolen;
+} worker_t;
+
+static job_t *jobs = NULL;
+static size_t job_count = 0;
+static size_t job_size = 0;
+static worker_t *workers = NULL;
+static int worker_count = 0;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// jobs
+
+static bool add_job(const char *scene, const char *schedule, uint32_t seed,
+                    double seconds) {
+    if (job_count == job_size) {
+        job_size = job_size ? job_size * 2 : 64;
+        job_t *grown = realloc(jobs, job_size * sizeof(job_t));
+        if (!grown) return false;
+        jobs = grown;
+    }
+
+    job_t *j = &jobs[job_count++];
+    memset(j, 0, sizeof(job_t));
+    j->options.scene_path = strdup(scene);
+    j->options.schedule_path = schedule ? strdup(schedule) : NULL;
+    j->options.seconds = seconds;
+    j->options.seed = seed;
+    return true;
+}
+
+static bool add_jobs(const char *scene, const char *schedule, uint32_t seed,
+                     uint32_t seeds, double seconds) {
+    if (seeds == 0) return add_job(scene, schedule, seed, seconds);
+    for (uint32_t s = 1; s <= seeds; s++)
+        if (!add_job(scene, schedule, s, seconds)) return false;
+    return true;
+}
+
+static bool read_jobs(const char *path, const char *schedule, uint32_t seeds,
+                      double seconds) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "can't open jobs: %s\n", path);
+        return false;
+    }
+
+    char line[512];
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f)) {
+        char scene[256], job_schedule[256];
+        unsigned long seed = 1;
+        int n = sscanf(line, "%255s %255s %lu", scene, job_schedule, &seed);
+        if (n <= 0 || scene[0] == '#') continue;
+
+        const char *s = schedule;
+        if (n >= 2 && strcmp(job_schedule, "-")) s = job_schedule;
+        ok = add_jobs(scene, s, seed, n == 3 ? 0 : seeds, seconds);
+    }
+
+    fclose(f);
+    return ok;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// workers
+
+static bool take(worker_t *w, bool own, size_t *job) {
+    bool found = false;
+    pthread_mutex_lock(&w->lock);
+    if (w->front < w->back) {
+        *job = own ? w->jobs[--w->back] : w->jobs[w->front++];
+        found = true;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+static void *work(void *arg) {
+    worker_t *w = arg;
+    size_t job;
+
+    while (true) {
+        bool found = take(w, true, &job);
+
+        // no job generates more, so once every deque is empty we're done
+        for (int i = 1; !found && i < worker_count; i++) {
+            found = take(&workers[(w->id + i) % worker_count], false, &job);
+            if (found) w->stolen++;
+        }
+        if (!found) break;
+
+        job_t *j = &jobs[job];
+        j->worker = w->id;
+        j->status = batch_run(&j->options, &j->stats);
+        w->run++;
+    }
+
+    return NULL;
+}
+
+static uint64_t wall_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// main
+
+int farm_main(int argc, char **argv) {
+    int threads = 0;
+    double seconds = 10;
+    uint32_t seeds = 0;
+    const char *schedule = NULL;
+    const char *trace_dir = NULL;
+    int i;
+
+    for (i = 1; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        const char *arg = argv[i], *val = argv[i + 1];
+        if (!strcmp(arg, "-j"))
+            threads = atoi(val);
+        else if (!strcmp(arg, "-t"))
+            seconds = atof(val);
+        else if (!strcmp(arg, "-n"))
+            seeds = strtoul(val, NULL, 10);
+        else if (!strcmp(arg, "-e"))
+            schedule = val;
+        else if (!strcmp(arg, "-d"))
+            trace_dir = val;
+        else
+            break;
+    }
+    if (i >= argc || argv[i][0] == '-' || threads < 0 || seconds < 0) {
+        fprintf(stderr,
+                "usage: %s -j threads [-t seconds] [-n seeds] "
+                "[-e schedule.txt] [-d trace_dir] scene.txt ... | @jobs.txt\n",
+                argv[0]);
+        return 2;
+    }
+
+    for (; i < argc; i++) {
+        bool ok = argv[i][0] == '@'
+                      ? read_jobs(argv[i] + 1, schedule, seeds, seconds)
+                      : add_jobs(argv[i], schedule, 1, seeds, seconds);
+        if (!ok) return 1;
+    }
+
+    if (trace_dir) {
+        for (size_t n = 0; n < job_count; n++) {
+            char *path = malloc(strlen(trace_dir) + 24);
+            sprintf(path, "%s/%zu.txt", trace_dir, n);
+            jobs[n].trace_path = path;
+            jobs[n].options.trace_path = path;
+        }
+    }
+
+    if (threads == 0) threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > job_count && job_count) threads = job_count;
+    worker_count = threads;
+
+    // deal the jobs out round robin, stealing evens out the rest
+    workers = calloc(worker_count, sizeof(worker_t));
+    for (int w = 0; w < worker_count; w++) {
+        pthread_mutex_init(&workers[w].lock, NULL);
+        workers[w].id = w;
+        workers[w].jobs = malloc((job_count / worker_count + 1) *
+                                 sizeof(size_t));
+    }
+    for (size_t n = 0; n < job_count; n++) {
+        worker_t *w = &workers[n % worker_count];
+        w->jobs[w->back++] = n;
+    }
+
+    const uint64_t start = wall_ns();
+    for (int w = 0; w < worker_count; w++)
+        pthread_create(&workers[w].thread, NULL, work, &workers[w]);
+    for (int w = 0; w < worker_count; w++)
+        pthread_join(workers[w].thread, NULL);
+    const uint64_t wall = wall_ns() - start;
+
+    printf("job\tscene\tschedule\tseed\tstatus\tvirtual_ms\tevents\t"
+           "dropped\toverruns\twall_us\tworker\n");
+    uint64_t busy = 0, virtual_ms = 0;
+    size_t failed = 0;
+    for (size_t n = 0; n < job_count; n++) {
+        const job_t *j = &jobs[n];
+        printf("%zu\t%s\t%s\t%" PRIu32 "\t%d\t%" PRIu32 "\t%" PRIu32
+               "\t%" PRIu16 "\t%" PRIu32 "\t%" PRIu64 "\t%d\n",
+               n, j->options.scene_path,
+               j->options.schedule_path ? j->options.schedule_path : "-",
+               j->options.seed, j->status, j->stats.virtual_ms,
+               j->stats.events, j->stats.delays_dropped, j->stats.overruns,
+               j->stats.wall_ns / 1000, j->worker);
+        if (j->status) failed++;
+        busy += j->stats.wall_ns;
+        virtual_ms += j->stats.virtual_ms;
+    }
+
+    uint32_t stolen = 0;
+    for (int w = 0; w < worker_count; w++) stolen += workers[w].stolen;
+
+    fprintf(stderr,
+            "%zu jobs (%zu failed) on %d threads in %.3f s, %.1fx parallel, "
+            "%.0fx real time, %" PRIu32 " stolen\n",
+            job_count, failed, worker_count, wall / 1e9,
+            wall ? (double)busy / wall : 0,
+            wall ? virtual_ms * 1e6 / wall : 0, stolen);
+
+    for (int w = 0; w < worker_count; w++) {
+        pthread_mutex_destroy(&workers[w].lock);
+        free(workers[w].jobs);
+    }
+    free(workers);
+    for (size_t n = 0; n < job_count; n++) {
+        free((char *)jobs[n].options.scene_path);
+        free((char *)jobs[n].options.schedule_path);
+        free(jobs[n].trace_path);
+    }
+    free(jobs);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,10 @@
+#ifndef _FARM_H_
+#define _FARM_H_
+
+// runs many batch jobs (see batch.h) across a pool of threads, and prints the
+// stats of each job
+
+// returns the process exit status
+int farm_main(int argc, char **argv);
+
+#endif
@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 199309L  // clock_gettime
+
 #include <ctype.h>
 #include <errno.h>
 #include <inttypes.h>
@@ -6,57 +8,96 @@
 #include <string.h>
 #include <time.h>
 
+#include "batch.h"
+#include "check.h"
+#include "farm.h"
 #include "teletype.h"
 #include "teletype_io.h"
 #include "util.h"
 
 
 void tele_metro_updated() {
+    if (batch_active()) {
+        batch_metro_updated();
+        return;
+    }
     printf("METRO UPDATED");
     printf("\n");
 }
 
 void tele_metro_reset() {
+    if (batch_active()) {
+        batch_metro_reset();
+        return;
+    }
     printf("METRO RESET");
     printf("\n");
 }
 
 void tele_tr(uint8_t i, int16_t v) {
+    if (batch_trace("TR %" PRIu8 " %" PRId16, i, v)) return;
     printf("TR  i:%" PRIu8 " v:%" PRId16, i, v);
     printf("\n");
 }
 
 void tele_cv(uint8_t i, int16_t v, uint8_t s) {
+    batch_cv(i, v, s);
+    if (batch_trace("CV %" PRIu8 " %" PRId16 " %" PRIu8, i, v, s)) return;
     printf("CV  i:%" PRIu8 " v:%" PRId16 " s:%" PRIu8, i, v, s);
     printf("\n");
 }
 
 void tele_cv_slew(uint8_t i, int16_t v) {
+    batch_cv_slew(i, v);
+    if (batch_trace("CV.SLEW %" PRIu8 " %" PRId16, i, v)) return;
     printf("CV_SLEW  i:%" PRIu8 " v:%" PRId16, i, v);
     printf("\n");
 }
 
+void tele_cv_curve(uint8_t i, uint8_t shape) {
+    batch_cv_curve(i, shape);
+    if (batch_trace("CV.CURVE %" PRIu8 " %" PRIu8, i, shape)) return;
+    printf("CV_CURVE  i:%" PRIu8 " shape:%" PRIu8, i, shape);
+    printf("\n");
+}
+
+// the outputs are traced as they're set, so there's nothing to batch
+void tele_cv_begin(void) {}
+void tele_cv_end(void) {}
+
 void tele_update_in(void) {
+    if (batch_active()) return;
     printf("UPDATE IN");
     printf("\n");
 }
 
 void tele_has_delays(bool i) {
+    if (batch_active()) return;
     printf("DELAY  i:%s", i ? "true" : "false");
     printf("\n");
 }
 
 void tele_has_stack(bool i) {
+    if (batch_active()) return;
     printf("STACK  i:%s", i ? "true" : "false");
     printf("\n");
 }
 
 void tele_cv_off(uint8_t i, int16_t v) {
+    batch_cv_off(i, v);
+    if (batch_trace("CV.OFF %" PRIu8 " %" PRId16, i, v)) return;
     printf("CV_OFF  i:%" PRIu8 " v:%" PRId16, i, v);
     printf("\n");
 }
 
 void tele_ii_tx(uint8_t addr, uint8_t *data, uint8_t l) {
+    if (batch_active()) {
+        char hex[3 * 256 + 1] = "";
+        for (size_t i = 0; i < l; i++)
+            sprintf(hex + 3 * i, " %02" PRIx8, data[i]);
+        batch_trace("II %" PRIu8 "%s", addr, hex);
+        return;
+    }
     printf("II_tx  addr:%" PRIu8 " l:%" PRIu8, addr, l);
     printf("\n");
     for (size_t i = 0; i < l; i++) {
@@ -67,31 +108,37 @@ void tele_ii_tx(uint8_t addr, uint8_t *data, uint8_t l) {
 void tele_vars_updated() {}
 
 void tele_ii_rx(uint8_t addr, uint8_t *data, uint8_t l) {
+    if (batch_trace("II.RX %" PRIu8 " %" PRIu8, addr, l)) return;
     printf("II_rx  addr:%" PRIu8 " l:%" PRIu8, addr, l);
     printf("\n");
 }
 
 void tele_scene(uint8_t i) {
+    if (batch_trace("SCENE %" PRIu8, i)) return;
     printf("SCENE  i:%" PRIu8, i);
     printf("\n");
 }
 
 void tele_pattern_updated() {
+    if (batch_trace("PATTERN")) return;
     printf("PATTERN UPDATED");
     printf("\n");
 }
 
 void tele_kill() {
+    if (batch_trace("KILL")) return;
     printf("KILL");
     printf("\n");
 }
 
 void tele_mute() {
+    if (batch_trace("MUTE")) return;
     printf("MUTE");
     printf("\n");
 }
 
 bool tele_get_input_state(uint8_t n) {
+    if (batch_active()) return batch_get_input_state(n);
     printf("INPUT_STATE  n:%" PRIu8, n);
     printf("\n");
     return false;
@@ -99,16 +146,24 @@ bool tele_get_input_state(uint8_t n) {
 
 void tele_save_calibration() {}
 
-void tele_profile_script(size_t s) {}
-void tele_profile_delay(uint8_t d) {}
+#ifdef TELETYPE_PROFILE
+uint32_t tele_profile_time() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000 + t.tv_nsec;
+}
+#endif
 
-int main() {
+int main(int argc, char **argv) {
     char *in;
     time_t t;
     error_t status;
     int i;
 
-    srand((unsigned)time(&t));
+    if (argc > 1 && !strcmp(argv[1], "-j")) return farm_main(argc, argv);
+    if (argc > 1 && !strcmp(argv[1], "-c")) return check_main(argc, argv);
+    if (argc > 1) return batch_main(argc, argv);
+
 
     // tele_command_t stored;
     // stored.data[0].t = OP;
@@ -128,6 +183,7 @@ int main() {
 
     scene_state_t ss;
     ss_init(&ss);
+    ss_rand_seed(&ss, time(&t));
 
     do {
         printf("> ");
@@ -151,6 +207,7 @@ int main() {
             printf("\n");
             if (status == E_OK) {
                 process_result_t output = process_command(&ss, &es, &temp);
+                ii_flush(&ss.ii);
                 if (output.has_value) { printf(">>> %i\n", output.value); }
             }
         }
@@ -1,5 +1,5 @@
 #ifndef CHAOS_H
-#define CHOAS_H
+#define CHAOS_H
 #include <stdint.h>
 
 typedef enum {
@@ -23,12 +23,12 @@ typedef struct {
     chaos_algo_t alg;  // current algorithm
 } chaos_state_t;
 
-void chaos_init(void);
-void chaos_set_val(int16_t);
-int16_t chaos_get_val(void);
-void chaos_set_r(int16_t);
-int16_t chaos_get_r(void);
-void chaos_set_alg(int16_t);
-int16_t chaos_get_alg(void);
+void chaos_init(chaos_state_t *state);
+void chaos_set_val(chaos_state_t *state, int16_t);
+int16_t chaos_get_val(chaos_state_t *state);
+void chaos_set_r(chaos_state_t *state, int16_t);
+int16_t chaos_get_r(chaos_state_t *state);
+void chaos_set_alg(chaos_state_t *state, int16_t);
+int16_t chaos_get_alg(chaos_state_t *state);
 
 #endif
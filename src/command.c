@@ -1,9 +1,8 @@
 #include "command.h"
 
-#include <string.h>  // memcpy
+#include <string.h>  // memcpy, memset
 
 #include "ops/op.h"
-#include "util.h"
 
 void copy_command(tele_command_t *dst, const tele_command_t *src) {
     // TODO does this need to use memcpy?
@@ -11,39 +10,63 @@ void copy_command(tele_command_t *dst, const tele_command_t *src) {
 }
 
 void copy_post_command(tele_command_t *dst, const tele_command_t *src) {
+    memset(dst, 0, sizeof(tele_command_t));
     dst->length = src->length - src->separator - 1;
     dst->separator = -1;
-    memcpy(dst->data, &src->data[src->separator + 1],
-           dst->length * sizeof(tele_data_t));
+    // the tags may not be nibble aligned, so copy word by word
+    for (uint8_t i = 0; i < dst->length; i++) {
+        const uint8_t j = src->separator + 1 + i;
+        command_set(dst, i, command_tag(src, j), command_value(src, j));
+    }
+}
+
+uint8_t print_number(int16_t value, char *out) {
+    char digits[5];
+    uint8_t n = 0, length = 0;
+    // negate as unsigned so that INT16_MIN works
+    uint16_t v = value < 0 ? -(uint16_t)value : value;
+    do {
+        digits[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    if (value < 0) out[length++] = '-';
+    while (n) out[length++] = digits[--n];
+    return length;
 }
 
-void print_command(const tele_command_t *cmd, char *out) {
-    out[0] = 0;
-    for (size_t i = 0; i < cmd->length; i++) {
-        tele_word_t tag = cmd->data[i].tag;
-        int16_t value = cmd->data[i].value;
-
-        switch (tag) {
-            case OP: strcat(out, tele_ops[value]->name); break;
-            case NUMBER: {
-                char number[8];
-                itoa(value, number, 10);
-                strcat(out, number);
-                break;
-            }
-            case MOD: strcat(out, tele_mods[value]->name); break;
-            case PRE_SEP: strcat(out, ":"); break;
-            case SUB_SEP: strcat(out, ";"); break;
-        }
-
-        // do we need to add a space?
-        // first check if we're not at the end
-        if (i < cmd->length - 1) {
-            // otherwise, only add a space if the next tag is a not a seperator
-            tele_word_t next_tag = cmd->data[i + 1].tag;
-            if (next_tag != PRE_SEP && next_tag != SUB_SEP) {
-                strcat(out, " ");
-            }
-        }
+uint8_t print_word(const tele_command_t *cmd, uint8_t i, char *out) {
+    const int16_t value = command_value(cmd, i);
+    uint8_t length = 0;
+
+    switch (command_tag(cmd, i)) {
+        case OP:
+            length = tele_ops[value]->name_length;
+            memcpy(out, tele_ops[value]->name, length);
+            break;
+        case NUMBER: length = print_number(value, out); break;
+        case MOD:
+            length = tele_mods[value]->name_length;
+            memcpy(out, tele_mods[value]->name, length);
+            break;
+        case PRE_SEP: out[length++] = ':'; break;
+        case SUB_SEP: out[length++] = ';'; break;
     }
+
+    // do we need to add a space?
+    // first check if we're not at the end
+    if (i < cmd->length - 1) {
+        // otherwise, only add a space if the next tag is a not a seperator
+        tele_word_t next_tag = command_tag(cmd, i + 1);
+        if (next_tag != PRE_SEP && next_tag != SUB_SEP) out[length++] = ' ';
+    }
+
+    return length;
+}
+
+size_t print_command(const tele_command_t *cmd, char *out) {
+    size_t length = 0;
+    for (uint8_t i = 0; i < cmd->length; i++)
+        length += print_word(cmd, i, out + length);
+    out[length] = 0;
+    return length;
 }
@@ -1,25 +1,63 @@
 #ifndef _COMMAND_H_
 #define _COMMAND_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define COMMAND_MAX_LENGTH 16
 
 typedef enum { NUMBER, OP, MOD, PRE_SEP, SUB_SEP } tele_word_t;
 
+// a single word, as matched by match_token
 typedef struct {
     tele_word_t tag;
     int16_t value;
 } tele_data_t;
 
+// Commands are stored in every script line, delay and stack slot, and in
+// flash, so the words are packed: the values are kept as an int16_t array,
+// and the tags as a nibble each. Use the command_ functions below to read and
+// write words rather than the arrays.
 typedef struct {
     uint8_t length;
     int8_t separator;
-    tele_data_t data[COMMAND_MAX_LENGTH];
+    // the tag of word i is in the low nibble of tags[i / 2] if i is even, and
+    // the high nibble if i is odd
+    uint8_t tags[COMMAND_MAX_LENGTH / 2];
+    int16_t values[COMMAND_MAX_LENGTH];
 } tele_command_t;
 
+static inline tele_word_t command_tag(const tele_command_t *c, uint8_t i) {
+    return (tele_word_t)((c->tags[i >> 1] >> ((i & 1) << 2)) & 0xF);
+}
+
+static inline int16_t command_value(const tele_command_t *c, uint8_t i) {
+    return c->values[i];
+}
+
+static inline tele_data_t command_word(const tele_command_t *c, uint8_t i) {
+    tele_data_t d = { .tag = command_tag(c, i), .value = command_value(c, i) };
+    return d;
+}
+
+static inline void command_set(tele_command_t *c, uint8_t i, tele_word_t tag,
+                               int16_t value) {
+    const uint8_t shift = (i & 1) << 2;
+    c->tags[i >> 1] = (c->tags[i >> 1] & ~(0xF << shift)) | (tag << shift);
+    c->values[i] = value;
+}
+
 void copy_command(tele_command_t *dst, const tele_command_t *src);
 void copy_post_command(tele_command_t *dst, const tele_command_t *src);
-void print_command(const tele_command_t *c, char *out);
+
+// the most chars print_word can print, the longest name and a space
+#define WORD_PRINT_MAX 20
+
+// print_number and print_word don't terminate out, and return the number of
+// chars printed, print_word includes the space after the word if it needs one
+uint8_t print_number(int16_t value, char *out);
+uint8_t print_word(const tele_command_t *c, uint8_t i, char *out);
+// returns the length of the command, out is terminated
+size_t print_command(const tele_command_t *c, char *out);
 
 #endif
@@ -0,0 +1,84 @@
+#include "cv_out.h"
+
+#include <string.h>
+
+#include "teletype_io.h"
+
+void cv_out_init(cv_out_t *o) {
+    memset(o, 0, sizeof(cv_out_t));
+}
+
+void cv_out_begin(cv_out_t *o) {
+    o->depth++;
+}
+
+void cv_out_commit(cv_out_t *o) {
+    if (o->depth == 0 || --o->depth) return;
+
+    bool changed = false;
+    for (uint8_t i = 0; i < CV_OUT_COUNT; i++)
+        if (o->channels[i].changed) changed = true;
+    if (!changed) return;
+
+    tele_cv_begin();
+    for (uint8_t i = 0; i < CV_OUT_COUNT; i++) {
+        cv_out_channel_t *c = &o->channels[i];
+        if (c->changed & CV_OUT_OFF) tele_cv_off(i, c->off);
+        if (c->changed & CV_OUT_CURVE) tele_cv_curve(i, c->curve);
+        if (c->changed & CV_OUT_VALUE_SLEW) tele_cv_slew(i, c->value_slew);
+        if (c->changed & CV_OUT_VALUE) {
+            tele_cv(i, c->value, c->slewed);
+            o->writes++;
+        }
+        if (c->changed & CV_OUT_SLEW) tele_cv_slew(i, c->slew);
+        c->changed = 0;
+    }
+    tele_cv_end();
+    o->commits++;
+}
+
+void cv_out_set(cv_out_t *o, uint8_t i, int16_t value, bool slewed) {
+    if (o->depth == 0) {
+        tele_cv(i, value, slewed);
+        return;
+    }
+    cv_out_channel_t *c = &o->channels[i];
+    c->value = value;
+    c->slewed = slewed;
+    c->changed |= CV_OUT_VALUE;
+    // a slew set before the value goes before it
+    if (c->changed & CV_OUT_SLEW) {
+        c->value_slew = c->slew;
+        c->changed = (c->changed & ~CV_OUT_SLEW) | CV_OUT_VALUE_SLEW;
+    }
+}
+
+void cv_out_set_slew(cv_out_t *o, uint8_t i, int16_t slew) {
+    if (o->depth == 0) {
+        tele_cv_slew(i, slew);
+        return;
+    }
+    cv_out_channel_t *c = &o->channels[i];
+    c->slew = slew;
+    c->changed |= CV_OUT_SLEW;
+}
+
+void cv_out_set_curve(cv_out_t *o, uint8_t i, uint8_t curve) {
+    if (o->depth == 0) {
+        tele_cv_curve(i, curve);
+        return;
+    }
+    cv_out_channel_t *c = &o->channels[i];
+    c->curve = curve;
+    c->changed |= CV_OUT_CURVE;
+}
+
+void cv_out_set_off(cv_out_t *o, uint8_t i, int16_t off) {
+    if (o->depth == 0) {
+        tele_cv_off(i, off);
+        return;
+    }
+    cv_out_channel_t *c = &o->channels[i];
+    c->off = off;
+    c->changed |= CV_OUT_OFF;
+}
@@ -0,0 +1,59 @@
+#ifndef _CV_OUT_H_
+#define _CV_OUT_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The changes ops make to the 4 CV outputs are kept here while a script runs,
+// and passed on to the hardware by cv_out_commit once the outermost script
+// (or a tick's delays) has finished, between tele_cv_begin and tele_cv_end,
+// so the hardware can apply them all on the same DAC update.
+//
+// Only the last value and offset set for each output are passed on, with the
+// slew the value was set with before it, and the last slew after it if it was
+// set after the value, so the value slews as it would have if each change
+// went straight to the hardware. The last curve set goes before the value.
+//
+// With no transaction open changes are passed on straight away.
+
+#define CV_OUT_COUNT 4
+
+enum {
+    CV_OUT_VALUE = 1 << 0,
+    CV_OUT_SLEW = 1 << 1,
+    CV_OUT_OFF = 1 << 2,
+    CV_OUT_VALUE_SLEW = 1 << 3,
+    CV_OUT_CURVE = 1 << 4,
+};
+
+typedef struct {
+    int16_t value;
+    int16_t value_slew;  // the slew when the value was set
+    int16_t slew;
+    int16_t off;
+    uint8_t curve;
+    bool slewed;  // whether the value slews to its target or jumps to it
+    uint8_t changed;
+} cv_out_channel_t;
+
+typedef struct {
+    cv_out_channel_t channels[CV_OUT_COUNT];
+    uint8_t depth;
+    // transactions that changed an output, and the values they passed on
+    uint32_t commits;
+    uint32_t writes;
+} cv_out_t;
+
+void cv_out_init(cv_out_t *o);
+
+// transactions can be nested, only the outermost commit passes the changes on
+void cv_out_begin(cv_out_t *o);
+void cv_out_commit(cv_out_t *o);
+
+// as tele_cv, tele_cv_slew, tele_cv_curve and tele_cv_off
+void cv_out_set(cv_out_t *o, uint8_t i, int16_t value, bool slewed);
+void cv_out_set_slew(cv_out_t *o, uint8_t i, int16_t slew);
+void cv_out_set_curve(cv_out_t *o, uint8_t i, uint8_t curve);
+void cv_out_set_off(cv_out_t *o, uint8_t i, int16_t off);
+
+#endif
@@ -0,0 +1,115 @@
+#include "ii_poll.h"
+
+#include <string.h>
+
+void ii_poll_init(ii_poll_t *p) {
+    p->count = 0;
+    p->next = 0;
+    p->period = II_POLL_PERIOD;
+    p->reads = 0;
+    p->hits = 0;
+}
+
+static ii_poll_entry_t *find(ii_poll_t *p, uint8_t addr, uint8_t query) {
+    for (uint8_t i = 0; i < p->count; i++) {
+        ii_poll_entry_t *e = &p->entries[i];
+        if (e->addr == addr && e->query == query) return e;
+    }
+    return NULL;
+}
+
+static int16_t fetch(ii_queue_t *q, uint8_t addr, uint8_t query) {
+    // tell the device what value we're going to read, then read it
+    uint8_t buffer[2] = { query, 0 };
+    ii_tx(q, addr, buffer, 1);
+    buffer[0] = 0;
+    buffer[1] = 0;
+    ii_rx(q, addr, buffer, 2);
+    return (buffer[0] << 8) + buffer[1];
+}
+
+bool ii_poll_add(ii_poll_t *p, uint8_t addr, uint8_t query) {
+    if (find(p, addr, query)) return true;
+    if (p->count == II_POLL_SIZE) return false;
+
+    ii_poll_entry_t *e = &p->entries[p->count++];
+    e->addr = addr;
+    e->query = query;
+    e->valid = false;
+    e->value = 0;
+    e->age = 0;
+    return true;
+}
+
+void ii_poll_remove(ii_poll_t *p, uint8_t addr, uint8_t query) {
+    ii_poll_entry_t *e = find(p, addr, query);
+    if (!e) return;
+    uint8_t i = e - p->entries;
+    memmove(e, e + 1, (p->count - i - 1) * sizeof(ii_poll_entry_t));
+    p->count--;
+    if (p->next >= p->count) p->next = 0;
+}
+
+bool ii_poll_contains(ii_poll_t *p, uint8_t addr, uint8_t query) {
+    return find(p, addr, query) != NULL;
+}
+
+int16_t ii_poll_age(ii_poll_t *p, uint8_t addr, uint8_t query) {
+    ii_poll_entry_t *e = find(p, addr, query);
+    if (!e || !e->valid) return -1;
+    return e->age > INT16_MAX ? INT16_MAX : e->age;
+}
+
+int16_t ii_poll_read(ii_poll_t *p, ii_queue_t *q, uint8_t addr,
+                     uint8_t query) {
+    ii_poll_entry_t *e = p->period ? find(p, addr, query) : NULL;
+    if (e && e->valid) {
+        p->hits++;
+        return e->value;
+    }
+
+    // not polled, or not read yet, so wait for it (and keep it if polled)
+    int16_t value = fetch(q, addr, query);
+    if (e) {
+        e->value = value;
+        e->valid = true;
+        e->age = 0;
+    }
+    return value;
+}
+
+void ii_poll_tick(ii_poll_t *p, ii_queue_t *q, uint16_t time) {
+    for (uint8_t i = 0; i < p->count; i++) {
+        ii_poll_entry_t *e = &p->entries[i];
+        e->age = e->age > UINT16_MAX - time ? UINT16_MAX : e->age + time;
+    }
+    if (p->period == 0 || p->count == 0) return;
+
+    // read the inputs that are due, at most II_POLL_BATCH of them, starting
+    // after the last one read so they all get a turn
+    uint8_t start = p->next, batch = 0;
+    for (uint8_t n = 0; n < p->count && batch < II_POLL_BATCH; n++) {
+        uint8_t i = (start + n) % p->count;
+        ii_poll_entry_t *e = &p->entries[i];
+        if (e->valid && e->age < p->period) continue;
+
+        e->value = fetch(q, e->addr, e->query);
+        e->valid = true;
+        e->age = 0;
+        p->reads++;
+        p->next = (i + 1) % p->count;
+        batch++;
+    }
+}
+
+int16_t ii_poll_next_due(ii_poll_t *p) {
+    if (p->period == 0 || p->count == 0) return -1;
+
+    int16_t due = INT16_MAX;
+    for (uint8_t i = 0; i < p->count; i++) {
+        ii_poll_entry_t *e = &p->entries[i];
+        if (!e->valid || e->age >= p->period) return 0;
+        if (p->period - e->age < due) due = p->period - e->age;
+    }
+    return due;
+}
@@ -0,0 +1,62 @@
+#ifndef _II_POLL_H_
+#define _II_POLL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ii_queue.h"
+
+// A cache of remote inputs (e.g. TI.IN, TI.PARAM) that are read from the bus
+// by tele_tick, between scripts, rather than when a script asks for them.
+//
+// An input is polled once it's added to the set: reading it from a script
+// returns the cached value, and ii_poll_tick reads again each input whose
+// value is older than the period, a few at a time so one tick doesn't hold
+// the bus for long. The age of each value is kept so scripts can tell how
+// stale it is.
+//
+// An input is named by its address and the byte written to ask for it.
+
+#define II_POLL_SIZE 16
+#define II_POLL_BATCH 4
+#define II_POLL_PERIOD 20
+
+typedef struct {
+    uint8_t addr;
+    uint8_t query;
+    bool valid;
+    int16_t value;
+    uint16_t age;  // ms since the value was read
+} ii_poll_entry_t;
+
+typedef struct {
+    ii_poll_entry_t entries[II_POLL_SIZE];
+    uint8_t count;
+    uint8_t next;     // where the next tick starts looking, round robin
+    uint16_t period;  // ms between reads of an input, 0 stops polling
+    // reads of the bus made by ii_poll_tick, and reads served from the cache
+    uint32_t reads;
+    uint32_t hits;
+} ii_poll_t;
+
+void ii_poll_init(ii_poll_t *p);
+
+// adds an input to the set, returns false if the set is full
+bool ii_poll_add(ii_poll_t *p, uint8_t addr, uint8_t query);
+void ii_poll_remove(ii_poll_t *p, uint8_t addr, uint8_t query);
+bool ii_poll_contains(ii_poll_t *p, uint8_t addr, uint8_t query);
+
+// the age of an input's value in ms (up to INT16_MAX), -1 if it isn't polled
+// or hasn't been read yet
+int16_t ii_poll_age(ii_poll_t *p, uint8_t addr, uint8_t query);
+
+// the value of an input, from the cache if it's polled, otherwise from the bus
+int16_t ii_poll_read(ii_poll_t *p, ii_queue_t *q, uint8_t addr, uint8_t query);
+
+// ages the cache by time ms, and reads the inputs that are due
+void ii_poll_tick(ii_poll_t *p, ii_queue_t *q, uint16_t time);
+
+// ms until an input is due, -1 if none are polled
+int16_t ii_poll_next_due(ii_poll_t *p);
+
+#endif
@@ -0,0 +1,183 @@
+#include "ii_queue.h"
+
+#include <string.h>
+
+#include "teletype_io.h"
+
+static ii_device_t *find_device(ii_queue_t *q, uint8_t addr) {
+    for (uint8_t i = 0; i < q->device_count; i++)
+        if (q->devices[i].addr == addr) return &q->devices[i];
+    return NULL;
+}
+
+void ii_queue_init(ii_queue_t *q, const ii_device_t *devices, uint8_t count) {
+    memset(q, 0, sizeof(ii_queue_t));
+    for (uint8_t i = 0; i < count; i++)
+        ii_set_device(q, devices[i].addr, devices[i].priority,
+                      devices[i].rate);
+}
+
+bool ii_set_device(ii_queue_t *q, uint8_t addr, ii_priority_t priority,
+                   uint8_t rate) {
+    ii_device_t *d = find_device(q, addr);
+    if (!d) {
+        if (q->device_count == II_DEVICE_COUNT) return false;
+        d = &q->devices[q->device_count++];
+        d->addr = addr;
+        d->sent = 0;
+    }
+    d->priority = priority;
+    d->rate = rate;
+    return true;
+}
+
+ii_priority_t ii_get_priority(ii_queue_t *q, uint8_t addr) {
+    ii_device_t *d = find_device(q, addr);
+    return d ? d->priority : II_PRIORITY_NORMAL;
+}
+
+uint8_t ii_get_rate(ii_queue_t *q, uint8_t addr) {
+    ii_device_t *d = find_device(q, addr);
+    return d ? d->rate : 0;
+}
+
+// lower is sent first
+static uint8_t priority(ii_queue_t *q, const ii_message_t *m) {
+    return ii_get_priority(q, m->addr) * 2 + (m->key_length ? 1 : 0);
+}
+
+static void send(ii_queue_t *q, bool limit) {
+    if (q->count == 0) return;
+
+    // a message can't go before the ones queued ahead of it for the same
+    // address, so it takes the highest priority of those queued after it
+    uint8_t p[II_QUEUE_SIZE];
+    for (uint8_t i = q->count; i-- > 0;) {
+        p[i] = priority(q, &q->messages[i]);
+        for (uint8_t j = i + 1; j < q->count; j++) {
+            if (q->messages[j].addr != q->messages[i].addr) continue;
+            if (p[j] < p[i]) p[i] = p[j];
+            break;
+        }
+    }
+
+    // a stable insertion sort keeps the order for each address
+    uint8_t order[II_QUEUE_SIZE];
+    for (uint8_t i = 0; i < q->count; i++) {
+        uint8_t j = i;
+        for (; j > 0 && p[order[j - 1]] > p[i]; j--) order[j] = order[j - 1];
+        order[j] = i;
+    }
+
+    bool held[II_QUEUE_SIZE] = { false };
+    for (uint8_t n = 0; n < q->count; n++) {
+        ii_message_t *m = &q->messages[order[n]];
+        ii_device_t *d = find_device(q, m->addr);
+        if (limit && d && d->rate && d->sent >= d->rate) {
+            held[order[n]] = true;
+            continue;
+        }
+        tele_ii_tx(m->addr, m->data, m->length);
+        if (d) d->sent++;
+        if (m->late) q->late++;
+        q->sent++;
+    }
+
+    // keep the messages that were held back, in the order they were queued
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < q->count; i++) {
+        if (!held[i]) continue;
+        q->messages[count] = q->messages[i];
+        q->messages[count++].late = true;
+    }
+    q->count = count;
+}
+
+// sends the messages queued for addr now, in order and whatever its limit
+static void send_to(ii_queue_t *q, uint8_t addr) {
+    ii_device_t *d = find_device(q, addr);
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < q->count; i++) {
+        ii_message_t *m = &q->messages[i];
+        if (m->addr != addr) {
+            q->messages[count++] = *m;
+            continue;
+        }
+        tele_ii_tx(m->addr, m->data, m->length);
+        if (d) d->sent++;
+        if (m->late) q->late++;
+        q->sent++;
+    }
+    q->count = count;
+}
+
+static void push(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length,
+                 uint8_t key_length) {
+    q->queued++;
+
+    // too long to queue (no op sends one), so it's sent in order now
+    if (length > II_MESSAGE_MAX) {
+        send_to(q, addr);
+        tele_ii_tx(addr, data, length);
+        q->sent++;
+        return;
+    }
+    if (q->count == II_QUEUE_SIZE) send(q, true);
+    if (q->count == II_QUEUE_SIZE) {
+        q->dropped++;
+        return;
+    }
+
+    ii_message_t *m = &q->messages[q->count++];
+    m->addr = addr;
+    m->length = length;
+    m->key_length = key_length;
+    m->late = false;
+    memcpy(m->data, data, length);
+}
+
+void ii_tx(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length) {
+    push(q, addr, data, length, 0);
+}
+
+void ii_tx_value(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length,
+                 uint8_t key_length) {
+    // look back for the same value, but not past another kind of message to
+    // the same address
+    for (uint8_t i = q->count; i-- > 0;) {
+        const ii_message_t *m = &q->messages[i];
+        if (m->addr != addr) continue;
+        if (m->key_length == 0) break;
+        if (m->key_length != key_length || memcmp(m->data, data, key_length))
+            continue;
+
+        // the later value is queued at the end, where it was set
+        memmove(&q->messages[i], &q->messages[i + 1],
+                (q->count - i - 1) * sizeof(ii_message_t));
+        q->count--;
+        q->coalesced++;
+        break;
+    }
+    push(q, addr, data, length, key_length);
+}
+
+void ii_rx(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length) {
+    send_to(q, addr);
+    tele_ii_rx(addr, data, length);
+}
+
+void ii_flush(ii_queue_t *q) {
+    send(q, true);
+}
+
+void ii_queue_tick(ii_queue_t *q, uint16_t time) {
+    q->window += time;
+    if (q->window < II_RATE_WINDOW) return;
+    q->window %= II_RATE_WINDOW;
+    for (uint8_t i = 0; i < q->device_count; i++) q->devices[i].sent = 0;
+}
+
+int16_t ii_queue_next_due(ii_queue_t *q) {
+    if (q->count == 0) return -1;
+    return II_RATE_WINDOW - q->window;
+}
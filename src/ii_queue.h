@@ -0,0 +1,111 @@
+#ifndef _II_QUEUE_H_
+#define _II_QUEUE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// I2C messages from ops are queued rather than sent as each op runs, and
+// sent by ii_flush, which teletype.c calls once a script (or a tick's delays)
+// has finished.
+//
+// A message that sets a value (e.g. TO.CV) replaces one still in the queue
+// with the same address and key (the command, and the port if there is one),
+// so a loop that sets the same output many times only sends the last value.
+// It's only replaced if no other kind of message to that address has been
+// queued since, so a command that depends on the value (e.g. TO.TR.PULSE
+// after TO.TR.TIME) still sees the value it would have.
+//
+// Messages to the same address are always sent in the order they were
+// queued, but ii_flush sends the messages for one device ahead of another's
+// by priority: first by the priority of the device (set with II.PRI, see
+// ii_default_devices for the defaults), then events (notes, triggers) ahead
+// of value sets, so a JF.NOTE isn't held up behind a screen of TO.CV. A
+// device can also be limited (with II.RATE) to a number of messages per
+// II_RATE_WINDOW ms, the rest wait in the queue for a later flush.
+//
+// A read first sends what is queued for the device it reads from, ignoring
+// its limit, so that the reply reflects every write to it before the read.
+// Messages to other devices stay queued, so that reads (such as TXi polling)
+// don't let them past their limits.
+
+#define II_QUEUE_SIZE 32
+#define II_MESSAGE_MAX 6
+#define II_DEVICE_COUNT 16
+#define II_RATE_WINDOW 10
+
+typedef enum {
+    II_PRIORITY_HIGH,
+    II_PRIORITY_NORMAL,
+    II_PRIORITY_LOW,
+} ii_priority_t;
+
+typedef struct {
+    uint8_t addr;
+    uint8_t length;
+    uint8_t key_length;  // 0 if the message doesn't replace others
+    bool late;           // held back by a rate limit
+    uint8_t data[II_MESSAGE_MAX];
+} ii_message_t;
+
+typedef struct {
+    uint8_t addr;
+    uint8_t priority;  // ii_priority_t
+    uint8_t rate;      // messages per II_RATE_WINDOW, 0 for no limit
+    uint8_t sent;      // in this window
+} ii_device_t;
+
+typedef struct {
+    ii_message_t messages[II_QUEUE_SIZE];
+    uint8_t count;
+    // devices that don't have the defaults (normal priority, no limit)
+    ii_device_t devices[II_DEVICE_COUNT];
+    uint8_t device_count;
+    uint16_t window;  // ms into the rate window
+    // messages queued, sent, replaced by a later one, dropped because the
+    // queue was full of messages held back by a limit, and sent after being
+    // held back
+    uint32_t queued;
+    uint32_t sent;
+    uint32_t coalesced;
+    uint32_t dropped;
+    uint32_t late;
+} ii_queue_t;
+
+// the devices the ops know the addresses of start with these, defined with
+// the ops in ops/hardware.c, so that the queue doesn't depend on them
+extern const ii_device_t ii_default_devices[];
+extern const uint8_t ii_default_device_count;
+
+// empties the queue, the devices start with the priorities and limits in
+// devices (e.g. ii_default_devices), any other with the defaults
+void ii_queue_init(ii_queue_t *q, const ii_device_t *devices, uint8_t count);
+
+// sets the priority and rate limit of a device, returns false if there are
+// already II_DEVICE_COUNT devices set
+bool ii_set_device(ii_queue_t *q, uint8_t addr, ii_priority_t priority,
+                   uint8_t rate);
+ii_priority_t ii_get_priority(ii_queue_t *q, uint8_t addr);
+uint8_t ii_get_rate(ii_queue_t *q, uint8_t addr);
+
+// queues a message, if the queue is full it's flushed first
+void ii_tx(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length);
+
+// queues a message that sets a value, key_length is the number of bytes at
+// the start of data that say which value
+void ii_tx_value(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length,
+                 uint8_t key_length);
+
+// sends the messages queued for addr, then reads length bytes from it into
+// data
+void ii_rx(ii_queue_t *q, uint8_t addr, uint8_t *data, uint8_t length);
+
+// sends what the rate limits allow with tele_ii_tx, in priority order
+void ii_flush(ii_queue_t *q);
+
+// moves the rate window on by time ms
+void ii_queue_tick(ii_queue_t *q, uint16_t time);
+
+// ms until the messages held back by a limit can be sent, -1 if there are none
+int16_t ii_queue_next_due(ii_queue_t *q);
+
+#endif
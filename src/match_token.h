@@ -6,6 +6,12 @@
 
 #include "command.h"
 
+// matches a number, op or mod, the ragel matcher needs the token to be
+// terminated (numbers are read with strtol), the hash one only reads len chars
 bool match_token(const char *token, const size_t len, tele_data_t *out);
 
+// the perfect hash matcher in match_token_hash.c, which is used as match_token
+// instead of the ragel one when MATCH_TOKEN_HASH is defined
+bool match_token_hash(const char *token, const size_t len, tele_data_t *out);
+
 #endif
@@ -8,6 +8,14 @@
 #include "ops/op.h"
 #include "ops/op_enum.h"
 
+#ifdef MATCH_TOKEN_HASH
+
+bool match_token(const char *token, const size_t len, tele_data_t *out) {
+    return match_token_hash(token, len, out);
+}
+
+#else
+
 %%{
     machine match_token; # declare our ragel machine
 
@@ -55,7 +63,7 @@
         "INIT.TR.ALL"     => { MATCH_OP(E_OP_INIT_TR_ALL); };
         "INIT.DATA"       => { MATCH_OP(E_OP_INIT_DATA); };
         "INIT.TIME"       => { MATCH_OP(E_OP_INIT_TIME); };
-        
+
         # turtle
         "@"           => { MATCH_OP(E_OP_TURTLE); };
         "@X"          => { MATCH_OP(E_OP_TURTLE_X); };
@@ -114,31 +122,37 @@
         "Q"           => { MATCH_OP(E_OP_Q); };
         "Q.AVG"       => { MATCH_OP(E_OP_Q_AVG); };
         "Q.N"         => { MATCH_OP(E_OP_Q_N); };
+        "Q.MIN"       => { MATCH_OP(E_OP_Q_MIN); };
+        "Q.MAX"       => { MATCH_OP(E_OP_Q_MAX); };
+        "Q.SUM"       => { MATCH_OP(E_OP_Q_SUM); };
 
         # hardware
-        "CV"          => { MATCH_OP(E_OP_CV); };
-        "CV.OFF"      => { MATCH_OP(E_OP_CV_OFF); };
-        "CV.SLEW"     => { MATCH_OP(E_OP_CV_SLEW); };
-        "IN"          => { MATCH_OP(E_OP_IN); };
-        "IN.SCALE"    => { MATCH_OP(E_OP_IN_SCALE); };
-        "IN.CAL.MIN"  => { MATCH_OP(E_OP_IN_CAL_MIN); };
-        "IN.CAL.MAX"  => { MATCH_OP(E_OP_IN_CAL_MAX); };
-        "IN.CAL.RESET" => { MATCH_OP(E_OP_IN_CAL_RESET); };
-        "PARAM"       => { MATCH_OP(E_OP_PARAM); };
-        "PARAM.SCALE" => { MATCH_OP(E_OP_PARAM_SCALE); };
-        "PARAM.CAL.MIN"  => { MATCH_OP(E_OP_PARAM_CAL_MIN); };
-        "PARAM.CAL.MAX"  => { MATCH_OP(E_OP_PARAM_CAL_MAX); };
+        "CV"              => { MATCH_OP(E_OP_CV); };
+        "CV.OFF"          => { MATCH_OP(E_OP_CV_OFF); };
+        "CV.SLEW"         => { MATCH_OP(E_OP_CV_SLEW); };
+        "CV.CURVE"        => { MATCH_OP(E_OP_CV_CURVE); };
+        "IN"              => { MATCH_OP(E_OP_IN); };
+        "IN.SCALE"        => { MATCH_OP(E_OP_IN_SCALE); };
+        "PARAM"           => { MATCH_OP(E_OP_PARAM); };
+        "PARAM.SCALE"     => { MATCH_OP(E_OP_PARAM_SCALE); };
+        "IN.CAL.MIN"      => { MATCH_OP(E_OP_IN_CAL_MIN); };
+        "IN.CAL.MAX"      => { MATCH_OP(E_OP_IN_CAL_MAX); };
+        "IN.CAL.RESET"    => { MATCH_OP(E_OP_IN_CAL_RESET); };
+        "PARAM.CAL.MIN"   => { MATCH_OP(E_OP_PARAM_CAL_MIN); };
+        "PARAM.CAL.MAX"   => { MATCH_OP(E_OP_PARAM_CAL_MAX); };
         "PARAM.CAL.RESET" => { MATCH_OP(E_OP_PARAM_CAL_RESET); };
-        "PRM"         => { MATCH_OP(E_OP_PRM); };
-        "TR"          => { MATCH_OP(E_OP_TR); };
-        "TR.POL"      => { MATCH_OP(E_OP_TR_POL); };
-        "TR.TIME"     => { MATCH_OP(E_OP_TR_TIME); };
-        "TR.TOG"      => { MATCH_OP(E_OP_TR_TOG); };
-        "TR.PULSE"    => { MATCH_OP(E_OP_TR_PULSE); };
-        "TR.P"        => { MATCH_OP(E_OP_TR_P); };
-        "CV.SET"      => { MATCH_OP(E_OP_CV_SET); };
-        "MUTE"        => { MATCH_OP(E_OP_MUTE); };
-        "STATE"       => { MATCH_OP(E_OP_STATE); };
+        "PRM"             => { MATCH_OP(E_OP_PRM); };
+        "TR"              => { MATCH_OP(E_OP_TR); };
+        "TR.POL"          => { MATCH_OP(E_OP_TR_POL); };
+        "TR.TIME"         => { MATCH_OP(E_OP_TR_TIME); };
+        "TR.TOG"          => { MATCH_OP(E_OP_TR_TOG); };
+        "TR.PULSE"        => { MATCH_OP(E_OP_TR_PULSE); };
+        "TR.P"            => { MATCH_OP(E_OP_TR_P); };
+        "CV.SET"          => { MATCH_OP(E_OP_CV_SET); };
+        "MUTE"            => { MATCH_OP(E_OP_MUTE); };
+        "STATE"           => { MATCH_OP(E_OP_STATE); };
+        "II.PRI"          => { MATCH_OP(E_OP_II_PRI); };
+        "II.RATE"         => { MATCH_OP(E_OP_II_RATE); };
 
         # maths
         "ADD"         => { MATCH_OP(E_OP_ADD); };
@@ -178,14 +192,14 @@
         "V"           => { MATCH_OP(E_OP_V); };
         "VV"          => { MATCH_OP(E_OP_VV); };
         "ER"          => { MATCH_OP(E_OP_ER); };
-        "BPM"         => { MATCH_OP(E_OP_BPM);; };
-        "|"           => { MATCH_OP(E_OP_BIT_OR);; };
-        "&"           => { MATCH_OP(E_OP_BIT_AND);; };
-        "~"           => { MATCH_OP(E_OP_BIT_NOT);; };
-        "^"           => { MATCH_OP(E_OP_BIT_XOR);; };
-        "BSET"        => { MATCH_OP(E_OP_BSET);; };
-        "BGET"        => { MATCH_OP(E_OP_BGET);; };
-        "BCLR"        => { MATCH_OP(E_OP_BCLR);; };
+        "BPM"         => { MATCH_OP(E_OP_BPM); };
+        "|"           => { MATCH_OP(E_OP_BIT_OR); };
+        "&"           => { MATCH_OP(E_OP_BIT_AND); };
+        "~"           => { MATCH_OP(E_OP_BIT_NOT); };
+        "^"           => { MATCH_OP(E_OP_BIT_XOR); };
+        "BSET"        => { MATCH_OP(E_OP_BSET); };
+        "BGET"        => { MATCH_OP(E_OP_BGET); };
+        "BCLR"        => { MATCH_OP(E_OP_BCLR); };
         "XOR"         => { MATCH_OP(E_OP_XOR); };
         "CHAOS"       => { MATCH_OP(E_OP_CHAOS); };
         "CHAOS.R"     => { MATCH_OP(E_OP_CHAOS_R); };
@@ -214,12 +228,20 @@
         "S.L"         => { MATCH_OP(E_OP_S_L); };
 
         # controlflow
-        "SCRIPT"      => { MATCH_OP(E_OP_SCRIPT); };
-        "KILL"        => { MATCH_OP(E_OP_KILL); };
-        "SCENE"       => { MATCH_OP(E_OP_SCENE); };
-        "BREAK"       => { MATCH_OP(E_OP_BREAK); };
-        "BRK"         => { MATCH_OP(E_OP_BRK); };
-        "SYNC"        => { MATCH_OP(E_OP_SYNC); };
+        "SCRIPT"       => { MATCH_OP(E_OP_SCRIPT); };
+        "KILL"         => { MATCH_OP(E_OP_KILL); };
+        "SCENE"        => { MATCH_OP(E_OP_SCENE); };
+        "BREAK"        => { MATCH_OP(E_OP_BREAK); };
+        "BRK"          => { MATCH_OP(E_OP_BRK); };
+        "SYNC"         => { MATCH_OP(E_OP_SYNC); };
+        "BUDGET"       => { MATCH_OP(E_OP_BUDGET); };
+        "BUDGET.ABORT" => { MATCH_OP(E_OP_BUDGET_ABORT); };
+        "BUDGET.OVER"  => { MATCH_OP(E_OP_BUDGET_OVER); };
+        "BUDGET.OPS"   => { MATCH_OP(E_OP_BUDGET_OPS); };
+        "BUDGET.DEPTH" => { MATCH_OP(E_OP_BUDGET_DEPTH); };
+        "BUDGET.STACK" => { MATCH_OP(E_OP_BUDGET_STACK); };
+        "BUDGET.W"     => { MATCH_OP(E_OP_BUDGET_W); };
+        "BUDGET.CLR"   => { MATCH_OP(E_OP_BUDGET_CLR); };
 
         # delay
         "DEL.CLR"     => { MATCH_OP(E_OP_DEL_CLR); };
@@ -377,8 +399,8 @@
         "TO.INIT"          => { MATCH_OP(E_OP_TO_INIT); };
 
         "TO.TR.P"          => { MATCH_OP(E_OP_TO_TR_P); };
-        "TO.TR.P.DIV"      => { MATCH_OP(E_OP_TO_TR_P_DIV); }; 
-        "TO.TR.P.MUTE"     => { MATCH_OP(E_OP_TO_TR_P_MUTE); };       
+        "TO.TR.P.DIV"      => { MATCH_OP(E_OP_TO_TR_P_DIV); };
+        "TO.TR.P.MUTE"     => { MATCH_OP(E_OP_TO_TR_P_MUTE); };
 
         "TO.OSC"           => { MATCH_OP(E_OP_TO_OSC); };
         "TO.OSC.SET"       => { MATCH_OP(E_OP_TO_OSC_SET); };
@@ -415,10 +437,9 @@
         "TO.ENV.DEC.S"     => { MATCH_OP(E_OP_TO_ENV_DEC_S); };
         "TO.ENV.DEC.M"     => { MATCH_OP(E_OP_TO_ENV_DEC_M); };
         "TO.ENV.TRIG"      => { MATCH_OP(E_OP_TO_ENV_TRIG); };
-
         "TO.ENV.EOR"       => { MATCH_OP(E_OP_TO_ENV_EOR); };
         "TO.ENV.EOC"       => { MATCH_OP(E_OP_TO_ENV_EOC); };
-        "TO.ENV.LOOP"       => { MATCH_OP(E_OP_TO_ENV_LOOP); };
+        "TO.ENV.LOOP"      => { MATCH_OP(E_OP_TO_ENV_LOOP); };
 
         "TI.PARAM"         => { MATCH_OP(E_OP_TI_PARAM); };
         "TI.PARAM.QT"      => { MATCH_OP(E_OP_TI_PARAM_QT); };
@@ -439,6 +460,12 @@
         "TI.IN.INIT"       => { MATCH_OP(E_OP_TI_IN_INIT); };
         "TI.INIT"          => { MATCH_OP(E_OP_TI_INIT); };
 
+        "TI.POLL"          => { MATCH_OP(E_OP_TI_POLL); };
+        "TI.PARAM.POLL"    => { MATCH_OP(E_OP_TI_PARAM_POLL); };
+        "TI.IN.POLL"       => { MATCH_OP(E_OP_TI_IN_POLL); };
+        "TI.PARAM.AGE"     => { MATCH_OP(E_OP_TI_PARAM_AGE); };
+        "TI.IN.AGE"        => { MATCH_OP(E_OP_TI_IN_AGE); };
+
         "TI.PRM"           => { MATCH_OP(E_OP_TI_PRM); };
         "TI.PRM.QT"        => { MATCH_OP(E_OP_TI_PRM_QT); };
         "TI.PRM.N"         => { MATCH_OP(E_OP_TI_PRM_N); };
@@ -456,9 +483,9 @@
         "EVERY"       => { MATCH_MOD(E_MOD_EVERY); };
         "SKIP"        => { MATCH_MOD(E_MOD_SKIP); };
         "OTHER"       => { MATCH_MOD(E_MOD_OTHER); };
+        "PROB"        => { MATCH_MOD(E_MOD_PROB); };
 
         # delay
-        "PROB"        => { MATCH_MOD(E_MOD_PROB); };
         "DEL"         => { MATCH_MOD(E_MOD_DEL); };
 
         # stack
@@ -515,3 +542,5 @@ bool match_token(const char *token, const size_t len, tele_data_t *out) {
     }
 
 }
+
+#endif
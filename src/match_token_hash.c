@@ -0,0 +1,83 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "match_token.h"
+#include "ops/op.h"
+#include "ops/op_enum.h"
+#include "ops/op_hash.h"
+
+// A lookup in the minimal perfect hash generated by utils/op_enums.py, an
+// alternative to the ragel state machine in match_token.rl that is smaller
+// and doesn't need the token to be copied or terminated.
+//
+// The hash sends every op and mod name to its own slot, so a name is looked up
+// by hashing it twice (once for its bucket, then with that bucket's seed for
+// its slot) and comparing it with the one name in the slot.
+
+// 32 bit FNV-1a, must match fnv1a in utils/op_enums.py
+static uint32_t op_hash(const char *token, size_t len, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)token[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// '-'? digit+, read like strtol with a base of 0 (so a leading 0 is octal,
+// and the number stops at the first digit that isn't), clamped to an int16_t
+static bool match_number(const char *token, size_t len, int16_t *out) {
+    size_t i = 0;
+    bool negative = false;
+    if (len && token[0] == '-') {
+        negative = true;
+        i++;
+    }
+    if (i == len) return false;
+    for (size_t j = i; j < len; j++)
+        if (token[j] < '0' || token[j] > '9') return false;
+
+    const uint8_t base = token[i] == '0' ? 8 : 10;
+    int32_t value = 0;
+    for (; i < len && token[i] - '0' < base; i++) {
+        value = value * base + token[i] - '0';
+        if (value > -(int32_t)INT16_MIN) value = -(int32_t)INT16_MIN;
+    }
+    if (negative) value = -value;
+
+    *out = value > INT16_MAX ? INT16_MAX : value;
+    return true;
+}
+
+bool match_token_hash(const char *token, const size_t len, tele_data_t *out) {
+    int16_t number;
+    if (match_number(token, len, &number)) {
+        out->tag = NUMBER;
+        out->value = number;
+        return true;
+    }
+
+    const uint16_t bucket = op_hash(token, len, 0) % OP_HASH_BUCKETS;
+    const uint16_t slot =
+        op_hash(token, len, op_hash_displace[bucket]) % OP_HASH_SIZE;
+    const uint16_t word = op_hash_words[slot];
+
+    const char *name;
+    uint8_t name_length;
+    if (word & OP_HASH_MOD) {
+        const tele_mod_t *mod = tele_mods[word & ~OP_HASH_MOD];
+        name = mod->name;
+        name_length = mod->name_length;
+        out->tag = MOD;
+    }
+    else {
+        const tele_op_t *op = tele_ops[word];
+        name = op->name;
+        name_length = op->name_length;
+        out->tag = OP;
+    }
+
+    if (name_length != len || memcmp(name, token, len)) return false;
+    out->value = word & ~OP_HASH_MOD;
+    return true;
+}
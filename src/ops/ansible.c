@@ -169,263 +169,263 @@ const tele_op_t op_ARP_ER      = MAKE_GET_OP(ARP.ER         , op_ARP_ER_get
 // clang-format on
 
 
-static void op_KR_PRE_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_PRE_set(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_KR_PRESET, a };
-    tele_ii_tx(II_KR_ADDR, d, 2);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 2);
 }
 
-static void op_KR_PRE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_PRE_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_KR_PRESET | II_GET };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
-static void op_KR_PAT_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_PAT_set(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_KR_PATTERN, a };
-    tele_ii_tx(II_KR_ADDR, d, 2);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 2);
 }
 
-static void op_KR_PAT_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_PAT_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_KR_PATTERN | II_GET };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
 static void op_KR_SCALE_set(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_KR_SCALE, a };
-    tele_ii_tx(II_KR_ADDR, d, 2);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 2);
 }
 
 static void op_KR_SCALE_get(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_KR_SCALE | II_GET };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
 static void op_KR_PERIOD_set(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_KR_PERIOD, a >> 8, a & 0xff };
-    tele_ii_tx(II_KR_ADDR, d, 3);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 3);
 }
 
 static void op_KR_PERIOD_get(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_KR_PERIOD | II_GET, 0 };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
     d[1] = 0;
-    tele_ii_rx(addr, d, 2);
+    ii_rx(&ss->ii, addr, d, 2);
     cs_push(cs, (d[0] << 8) + d[1]);
 }
 
-static void op_KR_POS_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_POS_set(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     int16_t c = cs_pop(cs);
     uint8_t d[] = { II_KR_POS, a, b, c };
-    tele_ii_tx(II_KR_ADDR, d, 4);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 4);
 }
 
-static void op_KR_POS_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_POS_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_KR_POS | II_GET, a, b };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 3);
+    ii_tx(&ss->ii, addr, d, 3);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
 static void op_KR_L_ST_set(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     int16_t c = cs_pop(cs);
     uint8_t d[] = { II_KR_LOOP_ST, a, b, c };
-    tele_ii_tx(II_KR_ADDR, d, 4);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 4);
 }
 
 static void op_KR_L_ST_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_KR_LOOP_ST | II_GET, a, b };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 3);
+    ii_tx(&ss->ii, addr, d, 3);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
 static void op_KR_L_LEN_set(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     int16_t c = cs_pop(cs);
     uint8_t d[] = { II_KR_LOOP_LEN, a, b, c };
-    tele_ii_tx(II_KR_ADDR, d, 4);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 4);
 }
 
 static void op_KR_L_LEN_get(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_KR_LOOP_LEN | II_GET, a, b };
     uint8_t addr = II_KR_ADDR;
-    tele_ii_tx(addr, d, 3);
+    ii_tx(&ss->ii, addr, d, 3);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
-static void op_KR_RES_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_KR_RES_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_KR_RESET, a, b };
-    tele_ii_tx(II_KR_ADDR, d, 3);
+    ii_tx(&ss->ii, II_KR_ADDR, d, 3);
 }
 
-static void op_ME_PRE_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_ME_PRE_set(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MP_PRESET, a };
-    tele_ii_tx(II_MP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_MP_ADDR, d, 2);
 }
 
-static void op_ME_PRE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_ME_PRE_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_MP_PRESET | II_GET };
     uint8_t addr = II_MP_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
-static void op_ME_RES_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_ME_RES_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MP_RESET, a };
-    tele_ii_tx(II_MP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_MP_ADDR, d, 2);
 }
 
 static void op_ME_STOP_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MP_STOP, a };
-    tele_ii_tx(II_MP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_MP_ADDR, d, 2);
 }
 
 static void op_ME_SCALE_set(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MP_SCALE, a };
-    tele_ii_tx(II_MP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_MP_ADDR, d, 2);
 }
 
 static void op_ME_SCALE_get(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_MP_SCALE | II_GET };
     uint8_t addr = II_MP_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
 static void op_ME_PERIOD_set(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MP_PERIOD, a >> 8, a & 0xff };
-    tele_ii_tx(II_MP_ADDR, d, 3);
+    ii_tx(&ss->ii, II_MP_ADDR, d, 3);
 }
 
 static void op_ME_PERIOD_get(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_MP_PERIOD | II_GET, 0 };
     uint8_t addr = II_MP_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
     d[1] = 0;
-    tele_ii_rx(addr, d, 2);
+    ii_rx(&ss->ii, addr, d, 2);
     cs_push(cs, (d[0] << 8) + d[1]);
 }
 
-static void op_LV_PRE_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_LV_PRE_set(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_LV_PRESET, a };
-    tele_ii_tx(II_LV_ADDR, d, 2);
+    ii_tx(&ss->ii, II_LV_ADDR, d, 2);
 }
 
-static void op_LV_PRE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_LV_PRE_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_LV_PRESET | II_GET };
     uint8_t addr = II_LV_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
-static void op_LV_RES_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_LV_RES_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_LV_RESET, a };
-    tele_ii_tx(II_LV_ADDR, d, 2);
+    ii_tx(&ss->ii, II_LV_ADDR, d, 2);
 }
 
 static void op_LV_POS_set(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_LV_POS, a };
-    tele_ii_tx(II_LV_ADDR, d, 2);
+    ii_tx(&ss->ii, II_LV_ADDR, d, 2);
 }
 
 static void op_LV_POS_get(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs) {
     uint8_t d[] = { II_LV_POS | II_GET };
     uint8_t addr = II_LV_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
@@ -433,16 +433,16 @@ static void op_LV_L_ST_set(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_LV_L_ST, a };
-    tele_ii_tx(II_LV_ADDR, d, 2);
+    ii_tx(&ss->ii, II_LV_ADDR, d, 2);
 }
 
 static void op_LV_L_ST_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs) {
     uint8_t d[] = { II_LV_L_ST | II_GET };
     uint8_t addr = II_LV_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
@@ -450,16 +450,16 @@ static void op_LV_L_LEN_set(const void *data, scene_state_t *ss,
                             exec_state_t *es, command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_LV_L_LEN, a };
-    tele_ii_tx(II_LV_ADDR, d, 2);
+    ii_tx(&ss->ii, II_LV_ADDR, d, 2);
 }
 
 static void op_LV_L_LEN_get(const void *data, scene_state_t *ss,
                             exec_state_t *es, command_state_t *cs) {
     uint8_t d[] = { II_LV_L_LEN | II_GET };
     uint8_t addr = II_LV_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
@@ -467,16 +467,16 @@ static void op_LV_L_DIR_set(const void *data, scene_state_t *ss,
                             exec_state_t *es, command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_LV_L_DIR, a };
-    tele_ii_tx(II_LV_ADDR, d, 2);
+    ii_tx(&ss->ii, II_LV_ADDR, d, 2);
 }
 
 static void op_LV_L_DIR_get(const void *data, scene_state_t *ss,
                             exec_state_t *es, command_state_t *cs) {
     uint8_t d[] = { II_LV_L_DIR | II_GET };
     uint8_t addr = II_LV_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
@@ -486,10 +486,10 @@ static void op_LV_CV_get(const void *data, scene_state_t *ss, exec_state_t *es,
     a--;
     uint8_t d[] = { II_LV_CV | II_GET, a & 0x3 };
     uint8_t addr = II_LV_ADDR;
-    tele_ii_tx(addr, d, 2);
+    ii_tx(&ss->ii, addr, d, 2);
     d[0] = 0;
     d[1] = 0;
-    tele_ii_rx(addr, d, 2);
+    ii_rx(&ss->ii, addr, d, 2);
     cs_push(cs, (d[0] << 8) + d[1]);
 }
 
@@ -497,50 +497,50 @@ static void op_CY_PRE_set(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_CY_PRESET, a };
-    tele_ii_tx(II_CY_ADDR, d, 2);
+    ii_tx(&ss->ii, II_CY_ADDR, d, 2);
 }
 
-static void op_CY_PRE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CY_PRE_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t d[] = { II_CY_PRESET | II_GET };
     uint8_t addr = II_CY_ADDR;
-    tele_ii_tx(addr, d, 1);
+    ii_tx(&ss->ii, addr, d, 1);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
-static void op_CY_RES_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CY_RES_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_CY_RESET, a };
-    tele_ii_tx(II_CY_ADDR, d, 2);
+    ii_tx(&ss->ii, II_CY_ADDR, d, 2);
 }
 
-static void op_CY_POS_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CY_POS_set(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_CY_POS, a, b };
-    tele_ii_tx(II_CY_ADDR, d, 3);
+    ii_tx(&ss->ii, II_CY_ADDR, d, 3);
 }
 
-static void op_CY_POS_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CY_POS_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_CY_POS | II_GET, a };
     uint8_t addr = II_CY_ADDR;
-    tele_ii_tx(addr, d, 2);
+    ii_tx(&ss->ii, addr, d, 2);
     d[0] = 0;
-    tele_ii_rx(addr, d, 1);
+    ii_rx(&ss->ii, addr, d, 1);
     cs_push(cs, d[0]);
 }
 
-static void op_CY_REV_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CY_REV_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_CY_REV, a };
-    tele_ii_tx(II_CY_ADDR, d, 2);
+    ii_tx(&ss->ii, II_CY_ADDR, d, 2);
 }
 
 static void op_CY_CV_get(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -549,122 +549,122 @@ static void op_CY_CV_get(const void *data, scene_state_t *ss, exec_state_t *es,
     a--;
     uint8_t d[] = { II_CY_CV | II_GET, a & 0x3 };
     uint8_t addr = II_CY_ADDR;
-    tele_ii_tx(addr, d, 2);
+    ii_tx(&ss->ii, addr, d, 2);
     d[0] = 0;
     d[1] = 0;
-    tele_ii_rx(addr, d, 2);
+    ii_rx(&ss->ii, addr, d, 2);
     cs_push(cs, (d[0] << 8) + d[1]);
 }
 
 static void op_MID_SHIFT_get(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MID_SHIFT, a >> 8, a & 0xff };
-    tele_ii_tx(II_MID_ADDR, d, 3);
+    ii_tx(&ss->ii, II_MID_ADDR, d, 3);
 }
 
 static void op_MID_SLEW_get(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_MID_SLEW, a >> 8, a & 0xff };
-    tele_ii_tx(II_MID_ADDR, d, 3);
+    ii_tx(&ss->ii, II_MID_ADDR, d, 3);
 }
 
 static void op_ARP_STY_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_ARP_STYLE, a };
-    tele_ii_tx(II_ARP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 2);
 }
 
 static void op_ARP_HLD_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_ARP_HOLD, a & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 2);
 }
 
 static void op_ARP_RPT_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     int16_t c = cs_pop(cs);
     uint8_t d[] = { II_ARP_RPT, a, b, c >> 8, c & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 5);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 5);
 }
 
-static void op_ARP_GT_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_ARP_GT_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_ARP_GATE, a & 0xff, b & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 3);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 3);
 }
 
 static void op_ARP_DIV_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_ARP_DIV, a & 0xff, b & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 3);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 3);
 }
 
 static void op_ARP_RES_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     uint8_t d[] = { II_ARP_RESET, a };
-    tele_ii_tx(II_ARP_ADDR, d, 2);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 2);
 }
 
 static void op_ARP_SHIFT_get(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_ARP_SHIFT, a, b >> 8, b & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 4);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 4);
 }
 
 static void op_ARP_SLEW_get(const void *NOTUSED(data),
-                            scene_state_t *NOTUSED(ss),
+                            scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_ARP_SLEW, a, b >> 8, b & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 4);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 4);
 }
 
 static void op_ARP_FIL_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_ARP_FILL, a, b };
-    tele_ii_tx(II_ARP_ADDR, d, 3);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 3);
 }
 
 static void op_ARP_ROT_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     uint8_t d[] = { II_ARP_ROT, a, b >> 8, b & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 4);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 4);
 }
 
-static void op_ARP_ER_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_ARP_ER_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     int16_t b = cs_pop(cs);
     int16_t c = cs_pop(cs);
     int16_t e = cs_pop(cs);
     uint8_t d[] = { II_ARP_ER, a, b, c, e >> 8, e & 0xff };
-    tele_ii_tx(II_ARP_ADDR, d, 6);
+    ii_tx(&ss->ii, II_ARP_ADDR, d, 6);
 }
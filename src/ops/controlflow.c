@@ -46,6 +46,26 @@ static void op_BREAK_get(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
 static void op_SYNC_get(const void *data, scene_state_t *ss, exec_state_t *es,
                         command_state_t *cs);
+static void op_BUDGET_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_set(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_ABORT_get(const void *data, scene_state_t *ss,
+                                exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_ABORT_set(const void *data, scene_state_t *ss,
+                                exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_OVER_get(const void *data, scene_state_t *ss,
+                               exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_OPS_get(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_DEPTH_get(const void *data, scene_state_t *ss,
+                                exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_STACK_get(const void *data, scene_state_t *ss,
+                                exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_W_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_BUDGET_CLR_get(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
 
 
 const tele_mod_t mod_PROB = MAKE_MOD(PROB, mod_PROB_func, 1);
@@ -66,6 +86,21 @@ const tele_op_t op_SCENE =
 const tele_op_t op_BREAK = MAKE_GET_OP(BREAK, op_BREAK_get, 0, false);
 const tele_op_t op_BRK = MAKE_ALIAS_OP(BRK, op_BREAK_get, NULL, 0, false);
 const tele_op_t op_SYNC = MAKE_GET_OP(SYNC, op_SYNC_get, 1, false);
+const tele_op_t op_BUDGET =
+    MAKE_GET_SET_OP(BUDGET, op_BUDGET_get, op_BUDGET_set, 1, true);
+const tele_op_t op_BUDGET_ABORT = MAKE_GET_SET_OP(
+    BUDGET.ABORT, op_BUDGET_ABORT_get, op_BUDGET_ABORT_set, 1, true);
+const tele_op_t op_BUDGET_OVER =
+    MAKE_GET_OP(BUDGET.OVER, op_BUDGET_OVER_get, 1, true);
+const tele_op_t op_BUDGET_OPS =
+    MAKE_GET_OP(BUDGET.OPS, op_BUDGET_OPS_get, 1, true);
+const tele_op_t op_BUDGET_DEPTH =
+    MAKE_GET_OP(BUDGET.DEPTH, op_BUDGET_DEPTH_get, 1, true);
+const tele_op_t op_BUDGET_STACK =
+    MAKE_GET_OP(BUDGET.STACK, op_BUDGET_STACK_get, 1, true);
+const tele_op_t op_BUDGET_W = MAKE_GET_OP(BUDGET.W, op_BUDGET_W_get, 1, true);
+const tele_op_t op_BUDGET_CLR =
+    MAKE_GET_OP(BUDGET.CLR, op_BUDGET_CLR_get, 0, false);
 
 
 static void mod_PROB_func(scene_state_t *ss, exec_state_t *es,
@@ -73,7 +108,7 @@ static void mod_PROB_func(scene_state_t *ss, exec_state_t *es,
                           const tele_command_t *post_command) {
     int16_t a = cs_pop(cs);
 
-    if (rand() % 101 < a) { process_command(ss, es, post_command); }
+    if (ss_rand(ss) % 101 < a) { process_command(ss, es, post_command); }
 }
 
 static void mod_IF_func(scene_state_t *ss, exec_state_t *es,
@@ -147,6 +182,8 @@ static void mod_W_func(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
     if (a) {
         process_command(ss, es, post_command);
         es_variables(es)->while_depth++;
+        if (es_variables(es)->while_depth > es->while_high)
+            es->while_high = es_variables(es)->while_depth;
         if (es_variables(es)->while_depth < WHILE_DEPTH)
             es_variables(es)->while_continue = true;
         else
@@ -237,6 +274,8 @@ static void op_KILL_get(const void *NOTUSED(data), scene_state_t *ss,
     ss->variables.m_act = 0;
     tele_metro_updated();
     clear_delays(ss);
+    // and W loops waiting to carry on
+    ss_resume_clear(ss);
     tele_kill();
 }
 
@@ -244,3 +283,95 @@ static void op_BREAK_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                          exec_state_t *es, command_state_t *NOTUSED(cs)) {
     es_variables(es)->breaking = true;
 }
+
+// BUDGET n: the ops script n (1-8, 9 for M, 10 for I) may run in a tick before
+// a W loop at its top level yields, 0 for no limit
+static void op_BUDGET_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    uint16_t a = cs_pop(cs) - 1;
+    if (a > INIT_SCRIPT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss_get_script_budget(ss, a));
+}
+
+static void op_BUDGET_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    uint16_t a = cs_pop(cs) - 1;
+    int16_t b = cs_pop(cs);
+    if (a > INIT_SCRIPT) return;
+    ss_set_script_budget(ss, a, b < 0 ? 0 : b);
+}
+
+// BUDGET.ABORT n: 1 to stop script n where it is when its budget is spent,
+// rather than let a W loop yield
+static void op_BUDGET_ABORT_get(const void *NOTUSED(data), scene_state_t *ss,
+                                exec_state_t *NOTUSED(es),
+                                command_state_t *cs) {
+    uint16_t a = cs_pop(cs) - 1;
+    if (a > INIT_SCRIPT)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ss_get_script_abort(ss, a));
+}
+
+static void op_BUDGET_ABORT_set(const void *NOTUSED(data), scene_state_t *ss,
+                                exec_state_t *NOTUSED(es),
+                                command_state_t *cs) {
+    uint16_t a = cs_pop(cs) - 1;
+    int16_t b = cs_pop(cs);
+    if (a > INIT_SCRIPT) return;
+    ss_set_script_abort(ss, a, b != 0);
+}
+
+// the stats of the script numbered on the stack, or NULL
+static const scene_script_stats_t *pop_stats(scene_state_t *ss,
+                                             command_state_t *cs) {
+    uint16_t a = cs_pop(cs) - 1;
+    if (a > INIT_SCRIPT) return NULL;
+    return ss_get_script_stats(ss, a);
+}
+
+static void op_BUDGET_OVER_get(const void *NOTUSED(data), scene_state_t *ss,
+                               exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const scene_script_stats_t *s = pop_stats(ss, cs);
+    if (!s)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, s->overruns > INT16_MAX ? INT16_MAX : s->overruns);
+}
+
+static void op_BUDGET_OPS_get(const void *NOTUSED(data), scene_state_t *ss,
+                              exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const scene_script_stats_t *s = pop_stats(ss, cs);
+    if (!s)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, s->ops > INT16_MAX ? INT16_MAX : s->ops);
+}
+
+static void op_BUDGET_DEPTH_get(const void *NOTUSED(data), scene_state_t *ss,
+                                exec_state_t *NOTUSED(es),
+                                command_state_t *cs) {
+    const scene_script_stats_t *s = pop_stats(ss, cs);
+    cs_push(cs, s ? s->depth : 0);
+}
+
+static void op_BUDGET_STACK_get(const void *NOTUSED(data), scene_state_t *ss,
+                                exec_state_t *NOTUSED(es),
+                                command_state_t *cs) {
+    const scene_script_stats_t *s = pop_stats(ss, cs);
+    cs_push(cs, s ? s->stack : 0);
+}
+
+static void op_BUDGET_W_get(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    const scene_script_stats_t *s = pop_stats(ss, cs);
+    cs_push(cs, s ? s->w : 0);
+}
+
+static void op_BUDGET_CLR_get(const void *NOTUSED(data), scene_state_t *ss,
+                              exec_state_t *NOTUSED(es),
+                              command_state_t *NOTUSED(cs)) {
+    ss_stats_clear(ss);
+}
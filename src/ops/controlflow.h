@@ -19,6 +19,14 @@ extern const tele_op_t op_SCENE;
 extern const tele_op_t op_BREAK;
 extern const tele_op_t op_BRK;
 extern const tele_op_t op_SYNC;
+extern const tele_op_t op_BUDGET;
+extern const tele_op_t op_BUDGET_ABORT;
+extern const tele_op_t op_BUDGET_OVER;
+extern const tele_op_t op_BUDGET_OPS;
+extern const tele_op_t op_BUDGET_DEPTH;
+extern const tele_op_t op_BUDGET_STACK;
+extern const tele_op_t op_BUDGET_W;
+extern const tele_op_t op_BUDGET_CLR;
 
 
 #endif
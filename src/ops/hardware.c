@@ -2,8 +2,27 @@
 
 #include "helpers.h"
 #include "ii.h"
+#include "ops/telex.h"
+#include "slew.h"
 #include "teletype_io.h"
 
+// Just Friends plays notes, so its messages go ahead of other devices', and
+// the TXo are mostly used for CV so theirs wait. No device is rate limited
+// until a scene sets one with II.RATE.
+const ii_device_t ii_default_devices[] = {
+    { .addr = JF_ADDR, .priority = II_PRIORITY_HIGH },
+    { .addr = TO_0, .priority = II_PRIORITY_LOW },
+    { .addr = TO_1, .priority = II_PRIORITY_LOW },
+    { .addr = TO_2, .priority = II_PRIORITY_LOW },
+    { .addr = TO_3, .priority = II_PRIORITY_LOW },
+    { .addr = TO_4, .priority = II_PRIORITY_LOW },
+    { .addr = TO_5, .priority = II_PRIORITY_LOW },
+    { .addr = TO_6, .priority = II_PRIORITY_LOW },
+    { .addr = TO_7, .priority = II_PRIORITY_LOW },
+};
+const uint8_t ii_default_device_count =
+    sizeof(ii_default_devices) / sizeof(ii_default_devices[0]);
+
 static void op_CV_get(const void *data, scene_state_t *ss, exec_state_t *es,
                       command_state_t *cs);
 static void op_CV_set(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -12,6 +31,10 @@ static void op_CV_SLEW_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
 static void op_CV_SLEW_set(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
+static void op_CV_CURVE_get(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
+static void op_CV_CURVE_set(const void *data, scene_state_t *ss,
+                            exec_state_t *es, command_state_t *cs);
 static void op_CV_OFF_get(const void *data, scene_state_t *ss, exec_state_t *es,
                           command_state_t *cs);
 static void op_CV_OFF_set(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -63,12 +86,21 @@ static void op_MUTE_set(const void *data, scene_state_t *ss, exec_state_t *es,
                         command_state_t *cs);
 static void op_STATE_get(const void *data, scene_state_t *ss, exec_state_t *es,
                          command_state_t *cs);
+static void op_II_PRI_get(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_II_PRI_set(const void *data, scene_state_t *ss,
+                          exec_state_t *es, command_state_t *cs);
+static void op_II_RATE_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_II_RATE_set(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
 
 
 // clang-format off
 const tele_op_t op_CV       = MAKE_GET_SET_OP(CV      , op_CV_get      , op_CV_set     , 1, true);
 const tele_op_t op_CV_OFF   = MAKE_GET_SET_OP(CV.OFF  , op_CV_OFF_get  , op_CV_OFF_set , 1, true);
 const tele_op_t op_CV_SLEW  = MAKE_GET_SET_OP(CV.SLEW , op_CV_SLEW_get , op_CV_SLEW_set, 1, true);
+const tele_op_t op_CV_CURVE = MAKE_GET_SET_OP(CV.CURVE, op_CV_CURVE_get, op_CV_CURVE_set, 1, true);
 const tele_op_t op_IN       = MAKE_GET_OP    (IN      , op_IN_get      , 0, true);
 const tele_op_t op_IN_SCALE = MAKE_GET_OP    (IN.SCALE, op_IN_SCALE_set, 2, false);
 const tele_op_t op_PARAM    = MAKE_GET_OP    (PARAM   , op_PARAM_get   , 0, true);
@@ -89,6 +121,8 @@ const tele_op_t op_IN_CAL_RESET  = MAKE_GET_OP (IN.CAL.RESET, op_IN_CAL_RESET_se
 const tele_op_t op_PARAM_CAL_MIN = MAKE_GET_OP (PARAM.CAL.MIN, op_PARAM_CAL_MIN_set, 0, true);
 const tele_op_t op_PARAM_CAL_MAX = MAKE_GET_OP (PARAM.CAL.MAX, op_PARAM_CAL_MAX_set, 0, true);
 const tele_op_t op_PARAM_CAL_RESET  = MAKE_GET_OP (PARAM.CAL.RESET, op_PARAM_CAL_RESET_set, 0, false);
+const tele_op_t op_II_PRI   = MAKE_GET_SET_OP(II.PRI  , op_II_PRI_get  , op_II_PRI_set , 1, true);
+const tele_op_t op_II_RATE  = MAKE_GET_SET_OP(II.RATE , op_II_RATE_get , op_II_RATE_set, 1, true);
 // clang-format on
 
 static void op_CV_get(const void *NOTUSED(data), scene_state_t *ss,
@@ -102,10 +136,10 @@ static void op_CV_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(&ss->ii, addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -122,13 +156,13 @@ static void op_CV_set(const void *NOTUSED(data), scene_state_t *ss,
         return;
     else if (a < 4) {
         ss->variables.cv[a] = b;
-        tele_cv(a, b, 1);
+        cv_out_set(&ss->cv_out, a, b, true);
     }
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
 
-        tele_ii_tx(addr, d, 4);
+        ii_tx_value(&ss->ii, addr, d, 4, 2);
     }
 }
 
@@ -143,10 +177,10 @@ static void op_CV_SLEW_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_SLEW | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(&ss->ii, addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -163,15 +197,37 @@ static void op_CV_SLEW_set(const void *NOTUSED(data), scene_state_t *ss,
         return;
     else if (a < 4) {
         ss->variables.cv_slew[a] = b;
-        tele_cv_slew(a, b);
+        cv_out_set_slew(&ss->cv_out, a, b);
     }
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_SLEW, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx_value(&ss->ii, addr, d, 4, 2);
     }
 }
 
+static void op_CV_CURVE_get(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    a--;
+    if (a >= 0 && a < 4)
+        cs_push(cs, ss->variables.cv_curve[a]);
+    else
+        cs_push(cs, 0);
+}
+
+// ansible has no curves, so only the module's outputs have one
+static void op_CV_CURVE_set(const void *NOTUSED(data), scene_state_t *ss,
+                            exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    b = normalise_value(0, SLEW_SHAPE_COUNT - 1, 0, b);
+    a--;
+    if (a < 0 || a >= 4) return;
+    ss->variables.cv_curve[a] = b;
+    cv_out_set_curve(&ss->cv_out, a, b);
+}
+
 static void op_CV_OFF_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
@@ -183,10 +239,10 @@ static void op_CV_OFF_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_OFF | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(&ss->ii, addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -203,13 +259,13 @@ static void op_CV_OFF_set(const void *NOTUSED(data), scene_state_t *ss,
         return;
     else if (a < 4) {
         ss->variables.cv_off[a] = b;
-        tele_cv_off(a, b);
-        tele_cv(a, ss->variables.cv[a], 1);
+        cv_out_set_off(&ss->cv_out, a, b);
+        cv_out_set(&ss->cv_out, a, ss->variables.cv[a], true);
     }
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_OFF, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx_value(&ss->ii, addr, d, 4, 2);
     }
 }
 
@@ -288,9 +344,9 @@ static void op_TR_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
-        tele_ii_rx(addr, d, 1);
+        ii_rx(&ss->ii, addr, d, 1);
         cs_push(cs, d[0]);
     }
     else
@@ -311,7 +367,7 @@ static void op_TR_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR, a & 0x3, b };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 3);
+        ii_tx(&ss->ii, addr, d, 3);
     }
 }
 
@@ -326,9 +382,9 @@ static void op_TR_POL_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_POL | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
-        tele_ii_rx(addr, d, 1);
+        ii_rx(&ss->ii, addr, d, 1);
         cs_push(cs, d[0]);
     }
     else
@@ -348,7 +404,7 @@ static void op_TR_POL_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_POL, a & 0x3, b > 0 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 3);
+        ii_tx(&ss->ii, addr, d, 3);
     }
 }
 
@@ -363,10 +419,10 @@ static void op_TR_TIME_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_TIME | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
         d[1] = 0;
-        tele_ii_rx(addr, d, 2);
+        ii_rx(&ss->ii, addr, d, 2);
         cs_push(cs, (d[0] << 8) + d[1]);
     }
     else
@@ -387,7 +443,7 @@ static void op_TR_TIME_set(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_TIME, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx(&ss->ii, addr, d, 4);
     }
 }
 
@@ -407,7 +463,7 @@ static void op_TR_TOG_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_TOG, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
     }
 }
 
@@ -427,7 +483,7 @@ static void op_TR_PULSE_get(const void *NOTUSED(data), scene_state_t *ss,
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_TR_PULSE, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
     }
 }
 
@@ -446,12 +502,12 @@ static void op_CV_SET_get(const void *NOTUSED(data), scene_state_t *ss,
         return;
     else if (a < 4) {
         ss->variables.cv[a] = b;
-        tele_cv(a, b, 0);
+        cv_out_set(&ss->cv_out, a, b, false);
     }
     else if (a < 20) {
         uint8_t d[] = { II_ANSIBLE_CV_SET, a & 0x3, b >> 8, b & 0xff };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 4) >> 2) << 1);
-        tele_ii_tx(addr, d, 4);
+        ii_tx(&ss->ii, addr, d, 4);
     }
 }
 
@@ -471,7 +527,7 @@ static void op_MUTE_set(const void *NOTUSED(data), scene_state_t *ss,
     if (a >= 0 && a < TRIGGER_INPUTS) { ss_set_mute(ss, a, b); }
 }
 
-static void op_STATE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_STATE_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     a--;
@@ -482,11 +538,52 @@ static void op_STATE_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
     else if (a < 24) {
         uint8_t d[] = { II_ANSIBLE_INPUT | II_GET, a & 0x3 };
         uint8_t addr = II_ANSIBLE_ADDR + (((a - 8) >> 2) << 1);
-        tele_ii_tx(addr, d, 2);
+        ii_tx(&ss->ii, addr, d, 2);
         d[0] = 0;
-        tele_ii_rx(addr, d, 1);
+        ii_rx(&ss->ii, addr, d, 1);
         cs_push(cs, d[0]);
     }
     else
         cs_push(cs, 0);
 }
+
+// devices are set by their i2c address, the priority is 0 (high), 1 (normal)
+// or 2 (low), and the rate the messages sent per II_RATE_WINDOW ms (0 for no
+// limit)
+static void op_II_PRI_get(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    if (a < 0 || a > 127)
+        cs_push(cs, II_PRIORITY_NORMAL);
+    else
+        cs_push(cs, ii_get_priority(&ss->ii, a));
+}
+
+static void op_II_PRI_set(const void *NOTUSED(data), scene_state_t *ss,
+                          exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    if (a < 0 || a > 127) return;
+    if (b < II_PRIORITY_HIGH) b = II_PRIORITY_HIGH;
+    if (b > II_PRIORITY_LOW) b = II_PRIORITY_LOW;
+    ii_set_device(&ss->ii, a, b, ii_get_rate(&ss->ii, a));
+}
+
+static void op_II_RATE_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    if (a < 0 || a > 127)
+        cs_push(cs, 0);
+    else
+        cs_push(cs, ii_get_rate(&ss->ii, a));
+}
+
+static void op_II_RATE_set(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t a = cs_pop(cs);
+    int16_t b = cs_pop(cs);
+    if (a < 0 || a > 127) return;
+    if (b < 0) b = 0;
+    if (b > 255) b = 255;
+    ii_set_device(&ss->ii, a, ii_get_priority(&ss->ii, a), b);
+}
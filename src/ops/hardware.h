@@ -6,6 +6,7 @@
 extern const tele_op_t op_CV;
 extern const tele_op_t op_CV_OFF;
 extern const tele_op_t op_CV_SLEW;
+extern const tele_op_t op_CV_CURVE;
 extern const tele_op_t op_IN;
 extern const tele_op_t op_IN_SCALE;
 extern const tele_op_t op_IN_CAL_MIN;
@@ -26,5 +27,7 @@ extern const tele_op_t op_TR_P;
 extern const tele_op_t op_CV_SET;
 extern const tele_op_t op_MUTE;
 extern const tele_op_t op_STATE;
+extern const tele_op_t op_II_PRI;
+extern const tele_op_t op_II_RATE;
 
 #endif
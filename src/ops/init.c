@@ -59,11 +59,14 @@ static void op_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                         command_state_t *NOTUSED(cs)) {
     // Because we can't see the flash from this context, we cache calibration
     cal_data_t caldata = ss->cal;
+    // keep the RNG going, otherwise every INIT repeats the same numbers
+    uint32_t rand_state = ss->rand_state;
     // At boot, all data is zeroed
     memset(ss, 0, sizeof(scene_state_t));
     ss_init(ss);
     
     ss->cal = caldata;
+    ss->rand_state = rand_state;
     // Once calibration data is loaded, the scales need to be reset
     ss_update_param_scale(ss);
     ss_update_in_scale(ss);
@@ -75,9 +78,11 @@ static void op_INIT_SCENE_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es),
                               command_state_t *NOTUSED(cs)) {
     cal_data_t caldata = ss->cal;
+    uint32_t rand_state = ss->rand_state;
     memset(ss, 0, sizeof(scene_state_t));
     ss_init(ss);
     ss->cal = caldata;
+    ss->rand_state = rand_state;
     ss_update_param_scale(ss);
     ss_update_in_scale(ss);
     tele_vars_updated();
@@ -114,7 +119,9 @@ static void op_INIT_CV_get(const void *NOTUSED(data), scene_state_t *ss,
         ss->variables.cv[v] = 0;
         ss->variables.cv_off[v] = 0;
         ss->variables.cv_slew[v] = 1;
-        tele_cv(v, 0, 1);
+        ss->variables.cv_curve[v] = 0;
+        cv_out_set_curve(&ss->cv_out, v, 0);
+        cv_out_set(&ss->cv_out, v, 0, true);
     }
 }
 
@@ -125,7 +132,9 @@ static void op_INIT_CV_ALL_get(const void *NOTUSED(data), scene_state_t *ss,
         ss->variables.cv[i] = 0;
         ss->variables.cv_off[i] = 0;
         ss->variables.cv_slew[i] = 1;
-        tele_cv(i, 0, 1);
+        ss->variables.cv_curve[i] = 0;
+        cv_out_set_curve(&ss->cv_out, i, 0);
+        cv_out_set(&ss->cv_out, i, 0, true);
     }
 }
 
@@ -1,6 +1,6 @@
 #include "ops/maths.h"
 
-#include <stdlib.h>  // rand
+#include <stdlib.h>
 
 #include "chaos.h"
 #include "euclidean/euclidean.h"
@@ -220,16 +220,16 @@ static void op_MOD_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
     cs_push(cs, out);
 }
 
-static void op_RAND_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_RAND_get(const void *NOTUSED(data), scene_state_t *ss,
                         exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a = cs_pop(cs);
     if (a == -1)
         cs_push(cs, 0);
     else
-        cs_push(cs, rand() % (a + 1));
+        cs_push(cs, ss_rand(ss) % (a + 1));
 }
 
-static void op_RRAND_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_RRAND_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
     int16_t a, b, min, max, range;
     a = cs_pop(cs);
@@ -246,7 +246,7 @@ static void op_RRAND_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
     if (range == 0)
         cs_push(cs, a);
     else
-        cs_push(cs, rand() % range + min);
+        cs_push(cs, ss_rand(ss) % range + min);
 }
 
 
@@ -263,7 +263,7 @@ static void op_R_get(const void *NOTUSED(data), scene_state_t *ss,
     if (range == 0)
         cs_push(cs, min);
     else
-        cs_push(cs, rand() % range + min);
+        cs_push(cs, ss_rand(ss) % range + min);
 }
 
 static void op_R_MIN_get(const void *NOTUSED(data), scene_state_t *ss,
@@ -286,9 +286,9 @@ static void op_R_MAX_set(const void *NOTUSED(data), scene_state_t *ss,
     ss->variables.r_max = cs_pop(cs);
 }
 
-static void op_TOSS_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_TOSS_get(const void *NOTUSED(data), scene_state_t *ss,
                         exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, rand() & 1);
+    cs_push(cs, ss_rand(ss) & 1);
 }
 
 static void op_MIN_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
@@ -471,7 +471,7 @@ static void op_JI_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
                       exec_state_t *NOTUSED(es), command_state_t *cs) {
     const uint8_t prime[5] = { 3, 5, 7, 11, 13 };
     const int16_t ji_const[5] = { 15331, 8437, 21159, 12041, 18357 };
-    int32_t result;
+    int32_t result = 0;
     int16_t n = abs(cs_pop(cs));
     int16_t d = abs(cs_pop(cs));
 
@@ -644,36 +644,36 @@ static void op_BCLR_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
     cs_push(cs, v & ~(1 << b));
 }
 
-static void op_CHAOS_get(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CHAOS_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, chaos_get_val());
+    cs_push(cs, chaos_get_val(&ss->chaos));
 }
 
-static void op_CHAOS_set(const void *NOTUSED(data), scene_state_t *NOTUSED(ss),
+static void op_CHAOS_set(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    chaos_set_val(cs_pop(cs));
+    chaos_set_val(&ss->chaos, cs_pop(cs));
 }
 
 static void op_CHAOS_R_get(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, chaos_get_r());
+    cs_push(cs, chaos_get_r(&ss->chaos));
 }
 
 static void op_CHAOS_R_set(const void *NOTUSED(data),
-                           scene_state_t *NOTUSED(ss),
+                           scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    chaos_set_r(cs_pop(cs));
+    chaos_set_r(&ss->chaos, cs_pop(cs));
 }
 
 static void op_CHAOS_ALG_get(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    cs_push(cs, chaos_get_alg());
+    cs_push(cs, chaos_get_alg(&ss->chaos));
 }
 
 static void op_CHAOS_ALG_set(const void *NOTUSED(data),
-                             scene_state_t *NOTUSED(ss),
+                             scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    chaos_set_alg(cs_pop(cs));
+    chaos_set_alg(&ss->chaos, cs_pop(cs));
 }
@@ -8,45 +8,88 @@
 #include "op_enum.h"
 #include "state.h"
 
+// what running an op (either its get or set) or mod can affect, each one
+// includes the ones before it
+typedef enum {
+    OP_EFFECT_NONE,     // pure, only depends on its params, so it can be
+                        // evaluated when a command is compiled
+    OP_EFFECT_READ,     // reads the scene or the hardware, but changes nothing
+    OP_EFFECT_SCENE,    // changes the scene (variables, patterns, the RNG...)
+    OP_EFFECT_OUTPUT,   // changes a CV or trigger, the metro, or sends I2C
+    OP_EFFECT_CONTROL,  // runs commands or scripts, or changes what will run
+    OP_EFFECT__LENGTH,
+} tele_op_effect_t;
+
+// a rough idea of how long an op or mod takes
+typedef enum {
+    OP_COST_LOW,     // a few instructions
+    OP_COST_MEDIUM,  // a loop over a pattern, a table, the stack or the delays
+    OP_COST_BUS,     // waits for an I2C transaction
+    OP_COST_HIGH,    // runs commands, or resets a lot of state
+    OP_COST__LENGTH,
+} tele_op_cost_t;
+
+// the fields used to validate, compile and run a command come first, the name
+// is only needed to parse and print one
 typedef struct {
-    const char *name;
     void (*const get)(const void *data, scene_state_t *ss, exec_state_t *es,
                       command_state_t *cs);
     void (*const set)(const void *data, scene_state_t *ss, exec_state_t *es,
                       command_state_t *cs);
+    const void *data;
     const uint8_t params;
     const bool returns;
-    const void *data;
+    // kept so that printing a command doesn't need to measure every name
+    const uint8_t name_length;
+    const char *name;
 } tele_op_t;
 
 typedef struct {
-    const char *name;
     void (*const func)(scene_state_t *ss, exec_state_t *es, command_state_t *cs,
                        const tele_command_t *post_command);
     const uint8_t params;
+    const uint8_t name_length;
+    const char *name;
 } tele_mod_t;
 
+// from op_list.h, kept in their own tables so that passes over every op (or
+// every word of a command) read a byte or two each, rather than a tele_op_t
+typedef struct {
+    uint8_t effect;  // tele_op_effect_t
+    uint8_t cost;    // tele_op_cost_t
+} tele_op_info_t;
+
 extern const tele_op_t *tele_ops[E_OP__LENGTH];
 extern const tele_mod_t *tele_mods[E_MOD__LENGTH];
+extern const tele_op_info_t tele_op_info[E_OP__LENGTH];
+extern const tele_op_info_t tele_mod_info[E_MOD__LENGTH];
+
+static inline bool op_is_pure(tele_op_idx_t op) {
+    return tele_op_info[op].effect == OP_EFFECT_NONE;
+}
 
 // Get only ops
-#define MAKE_GET_OP(n, g, p, r)                                       \
-    {                                                                 \
-        .name = #n, .get = g, .set = NULL, .params = p, .returns = r, \
-        .data = NULL                                                  \
+#define MAKE_GET_OP(n, g, p, r)                                           \
+    {                                                                     \
+        .name = #n, .name_length = sizeof(#n) - 1, .get = g, .set = NULL, \
+        .params = p, .returns = r, .data = NULL                           \
     }
 
 
 // Get & set ops
-#define MAKE_GET_SET_OP(n, g, s, p, r) \
-    { .name = #n, .get = g, .set = s, .params = p, .returns = r, .data = NULL }
+#define MAKE_GET_SET_OP(n, g, s, p, r)                                 \
+    {                                                                  \
+        .name = #n, .name_length = sizeof(#n) - 1, .get = g, .set = s, \
+        .params = p, .returns = r, .data = NULL                        \
+    }
 
 
 // Variables, peek & poke
-#define MAKE_SIMPLE_VARIABLE_OP(n, v)                                    \
-    {                                                                    \
-        .name = #n, .get = op_peek_i16, .set = op_poke_i16, .params = 0, \
-        .returns = 1, .data = (void *)offsetof(scene_state_t, v)         \
+#define MAKE_SIMPLE_VARIABLE_OP(n, v)                                  \
+    {                                                                  \
+        .name = #n, .name_length = sizeof(#n) - 1, .get = op_peek_i16, \
+        .set = op_poke_i16, .params = 0, .returns = 1,                 \
+        .data = (void *)offsetof(scene_state_t, v)                     \
     }
 
 void op_peek_i16(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -56,15 +99,18 @@ void op_poke_i16(const void *data, scene_state_t *ss, exec_state_t *es,
 
 
 // Alias one OP to another
-#define MAKE_ALIAS_OP(n, g, s, p, r) \
-    { .name = #n, .get = g, .set = s, .params = p, .returns = r, .data = NULL }
+#define MAKE_ALIAS_OP(n, g, s, p, r)                                   \
+    {                                                                  \
+        .name = #n, .name_length = sizeof(#n) - 1, .get = g, .set = s, \
+        .params = p, .returns = r, .data = NULL                        \
+    }
 
 
 // Simple I2C op (to support the original Trilogy modules)
-#define MAKE_SIMPLE_I2C_OP(n, v)                                    \
-    {                                                               \
-        .name = #n, .get = op_simple_i2c, .set = NULL, .params = 1, \
-        .returns = 0, .data = (void *)v                             \
+#define MAKE_SIMPLE_I2C_OP(n, v)                                         \
+    {                                                                    \
+        .name = #n, .name_length = sizeof(#n) - 1, .get = op_simple_i2c, \
+        .set = NULL, .params = 1, .returns = 0, .data = (void *)v        \
     }
 
 void op_simple_i2c(const void *data, scene_state_t *ss, exec_state_t *es,
@@ -73,7 +119,7 @@ void op_simple_i2c(const void *data, scene_state_t *ss, exec_state_t *es,
 
 // Mods
 #define MAKE_MOD(n, f, p) \
-    { .name = #n, .func = f, .params = p }
+    { .name = #n, .name_length = sizeof(#n) - 1, .func = f, .params = p }
 
 
 #endif
@@ -91,9 +91,13 @@ typedef enum {
     E_OP_Q,
     E_OP_Q_AVG,
     E_OP_Q_N,
+    E_OP_Q_MIN,
+    E_OP_Q_MAX,
+    E_OP_Q_SUM,
     E_OP_CV,
     E_OP_CV_OFF,
     E_OP_CV_SLEW,
+    E_OP_CV_CURVE,
     E_OP_IN,
     E_OP_IN_SCALE,
     E_OP_PARAM,
@@ -114,6 +118,8 @@ typedef enum {
     E_OP_CV_SET,
     E_OP_MUTE,
     E_OP_STATE,
+    E_OP_II_PRI,
+    E_OP_II_RATE,
     E_OP_ADD,
     E_OP_SUB,
     E_OP_MUL,
@@ -189,6 +195,14 @@ typedef enum {
     E_OP_BREAK,
     E_OP_BRK,
     E_OP_SYNC,
+    E_OP_BUDGET,
+    E_OP_BUDGET_ABORT,
+    E_OP_BUDGET_OVER,
+    E_OP_BUDGET_OPS,
+    E_OP_BUDGET_DEPTH,
+    E_OP_BUDGET_STACK,
+    E_OP_BUDGET_W,
+    E_OP_BUDGET_CLR,
     E_OP_DEL_CLR,
     E_OP_WW_PRESET,
     E_OP_WW_POS,
@@ -380,6 +394,11 @@ typedef enum {
     E_OP_TI_PARAM_INIT,
     E_OP_TI_IN_INIT,
     E_OP_TI_INIT,
+    E_OP_TI_POLL,
+    E_OP_TI_PARAM_POLL,
+    E_OP_TI_IN_POLL,
+    E_OP_TI_PARAM_AGE,
+    E_OP_TI_IN_AGE,
     E_OP_TI_PRM,
     E_OP_TI_PRM_QT,
     E_OP_TI_PRM_N,
@@ -0,0 +1,486 @@
+// clang-format off
+
+#ifndef _OPS_OP_LIST_H_
+#define _OPS_OP_LIST_H_
+
+// Every op and mod, in the order of tele_op_idx_t and tele_mod_idx_t, with
+// what running it can affect and roughly how long it takes:
+//
+//   OP(name, effect, cost)
+//   MOD(name, effect, cost)
+//
+// name is the suffix of the op_ or mod_ struct (made with one of the MAKE_
+// macros in op.h next to its functions), effect is a tele_op_effect_t and cost
+// a tele_op_cost_t, both without their prefix.
+//
+// This is the one place an op is listed: the tables in op.c are built from
+// it, and utils/op_enums.py reads it to generate op_enum.h, op_hash.h and the
+// names matched in match_token.rl.
+
+#define TELE_OP_LIST(OP)                                                      \
+    /* variables */                                                           \
+    OP(A,                      SCENE,   LOW)                                  \
+    OP(B,                      SCENE,   LOW)                                  \
+    OP(C,                      SCENE,   LOW)                                  \
+    OP(D,                      SCENE,   LOW)                                  \
+    OP(DRUNK,                  SCENE,   LOW)                                  \
+    OP(DRUNK_MAX,              SCENE,   LOW)                                  \
+    OP(DRUNK_MIN,              SCENE,   LOW)                                  \
+    OP(DRUNK_WRAP,             SCENE,   LOW)                                  \
+    OP(FLIP,                   SCENE,   LOW)                                  \
+    OP(I,                      SCENE,   LOW)                                  \
+    OP(O,                      SCENE,   LOW)                                  \
+    OP(O_INC,                  SCENE,   LOW)                                  \
+    OP(O_MAX,                  SCENE,   LOW)                                  \
+    OP(O_MIN,                  SCENE,   LOW)                                  \
+    OP(O_WRAP,                 SCENE,   LOW)                                  \
+    OP(T,                      SCENE,   LOW)                                  \
+    OP(TIME,                   SCENE,   LOW)                                  \
+    OP(TIME_ACT,               SCENE,   LOW)                                  \
+    OP(LAST,                   READ,    LOW)                                  \
+    OP(X,                      SCENE,   LOW)                                  \
+    OP(Y,                      SCENE,   LOW)                                  \
+    OP(Z,                      SCENE,   LOW)                                  \
+                                                                              \
+    /* init */                                                                \
+    OP(INIT,                   CONTROL, HIGH)                                 \
+    OP(INIT_SCENE,             CONTROL, HIGH)                                 \
+    OP(INIT_SCRIPT,            CONTROL, MEDIUM)                               \
+    OP(INIT_SCRIPT_ALL,        CONTROL, HIGH)                                 \
+    OP(INIT_P,                 SCENE,   MEDIUM)                               \
+    OP(INIT_P_ALL,             SCENE,   HIGH)                                 \
+    OP(INIT_CV,                OUTPUT,  LOW)                                  \
+    OP(INIT_CV_ALL,            OUTPUT,  MEDIUM)                               \
+    OP(INIT_TR,                OUTPUT,  LOW)                                  \
+    OP(INIT_TR_ALL,            OUTPUT,  MEDIUM)                               \
+    OP(INIT_DATA,              SCENE,   MEDIUM)                               \
+    OP(INIT_TIME,              SCENE,   LOW)                                  \
+                                                                              \
+    /* turtle */                                                              \
+    OP(TURTLE,                 SCENE,   LOW)                                  \
+    OP(TURTLE_X,               SCENE,   LOW)                                  \
+    OP(TURTLE_Y,               SCENE,   LOW)                                  \
+    OP(TURTLE_MOVE,            SCENE,   LOW)                                  \
+    OP(TURTLE_F,               SCENE,   LOW)                                  \
+    OP(TURTLE_FX1,             SCENE,   LOW)                                  \
+    OP(TURTLE_FY1,             SCENE,   LOW)                                  \
+    OP(TURTLE_FX2,             SCENE,   LOW)                                  \
+    OP(TURTLE_FY2,             SCENE,   LOW)                                  \
+    OP(TURTLE_SPEED,           SCENE,   LOW)                                  \
+    OP(TURTLE_DIR,             SCENE,   LOW)                                  \
+    OP(TURTLE_STEP,            SCENE,   LOW)                                  \
+    OP(TURTLE_BUMP,            SCENE,   LOW)                                  \
+    OP(TURTLE_WRAP,            SCENE,   LOW)                                  \
+    OP(TURTLE_BOUNCE,          SCENE,   LOW)                                  \
+    OP(TURTLE_SCRIPT,          SCENE,   LOW)                                  \
+    OP(TURTLE_SHOW,            SCENE,   LOW)                                  \
+                                                                              \
+    /* metronome */                                                           \
+    OP(M,                      OUTPUT,  LOW)                                  \
+    OP(M_SYM_EXCLAMATION,      OUTPUT,  LOW)                                  \
+    OP(M_ACT,                  OUTPUT,  LOW)                                  \
+    OP(M_RESET,                OUTPUT,  LOW)                                  \
+                                                                              \
+    /* patterns */                                                            \
+    OP(P_N,                    SCENE,   LOW)                                  \
+    OP(P,                      SCENE,   LOW)                                  \
+    OP(PN,                     SCENE,   LOW)                                  \
+    OP(P_L,                    SCENE,   LOW)                                  \
+    OP(PN_L,                   SCENE,   LOW)                                  \
+    OP(P_WRAP,                 SCENE,   LOW)                                  \
+    OP(PN_WRAP,                SCENE,   LOW)                                  \
+    OP(P_START,                SCENE,   LOW)                                  \
+    OP(PN_START,               SCENE,   LOW)                                  \
+    OP(P_END,                  SCENE,   LOW)                                  \
+    OP(PN_END,                 SCENE,   LOW)                                  \
+    OP(P_I,                    SCENE,   LOW)                                  \
+    OP(PN_I,                   SCENE,   LOW)                                  \
+    OP(P_HERE,                 SCENE,   LOW)                                  \
+    OP(PN_HERE,                SCENE,   LOW)                                  \
+    OP(P_NEXT,                 SCENE,   LOW)                                  \
+    OP(PN_NEXT,                SCENE,   LOW)                                  \
+    OP(P_PREV,                 SCENE,   LOW)                                  \
+    OP(PN_PREV,                SCENE,   LOW)                                  \
+    OP(P_INS,                  SCENE,   MEDIUM)                               \
+    OP(PN_INS,                 SCENE,   MEDIUM)                               \
+    OP(P_RM,                   SCENE,   MEDIUM)                               \
+    OP(PN_RM,                  SCENE,   MEDIUM)                               \
+    OP(P_PUSH,                 SCENE,   MEDIUM)                               \
+    OP(PN_PUSH,                SCENE,   MEDIUM)                               \
+    OP(P_POP,                  SCENE,   MEDIUM)                               \
+    OP(PN_POP,                 SCENE,   MEDIUM)                               \
+                                                                              \
+    /* queue */                                                               \
+    OP(Q,                      SCENE,   LOW)                                  \
+    OP(Q_AVG,                  SCENE,   MEDIUM)                               \
+    OP(Q_N,                    SCENE,   MEDIUM)                               \
+    OP(Q_MIN,                  READ,    LOW)                                  \
+    OP(Q_MAX,                  READ,    LOW)                                  \
+    OP(Q_SUM,                  READ,    LOW)                                  \
+                                                                              \
+    /* hardware */                                                            \
+    OP(CV,                     OUTPUT,  LOW)                                  \
+    OP(CV_OFF,                 OUTPUT,  LOW)                                  \
+    OP(CV_SLEW,                OUTPUT,  LOW)                                  \
+    OP(CV_CURVE,               OUTPUT,  LOW)                                  \
+    OP(IN,                     READ,    LOW)                                  \
+    OP(IN_SCALE,               SCENE,   LOW)                                  \
+    OP(PARAM,                  READ,    LOW)                                  \
+    OP(PARAM_SCALE,            SCENE,   LOW)                                  \
+    OP(IN_CAL_MIN,             SCENE,   LOW)                                  \
+    OP(IN_CAL_MAX,             SCENE,   LOW)                                  \
+    OP(IN_CAL_RESET,           SCENE,   LOW)                                  \
+    OP(PARAM_CAL_MIN,          SCENE,   LOW)                                  \
+    OP(PARAM_CAL_MAX,          SCENE,   LOW)                                  \
+    OP(PARAM_CAL_RESET,        SCENE,   LOW)                                  \
+    OP(PRM,                    READ,    LOW)                                  \
+    OP(TR,                     OUTPUT,  LOW)                                  \
+    OP(TR_POL,                 OUTPUT,  LOW)                                  \
+    OP(TR_TIME,                OUTPUT,  LOW)                                  \
+    OP(TR_TOG,                 OUTPUT,  LOW)                                  \
+    OP(TR_PULSE,               OUTPUT,  LOW)                                  \
+    OP(TR_P,                   OUTPUT,  LOW)                                  \
+    OP(CV_SET,                 OUTPUT,  LOW)                                  \
+    OP(MUTE,                   SCENE,   LOW)                                  \
+    OP(STATE,                  READ,    LOW)                                  \
+    OP(II_PRI,                 SCENE,   LOW)                                  \
+    OP(II_RATE,                SCENE,   LOW)                                  \
+                                                                              \
+    /* maths */                                                               \
+    OP(ADD,                    NONE,    LOW)                                  \
+    OP(SUB,                    NONE,    LOW)                                  \
+    OP(MUL,                    NONE,    LOW)                                  \
+    OP(DIV,                    NONE,    LOW)                                  \
+    OP(MOD,                    NONE,    LOW)                                  \
+    OP(RAND,                   SCENE,   LOW)                                  \
+    OP(RRAND,                  SCENE,   LOW)                                  \
+    OP(R,                      SCENE,   LOW)                                  \
+    OP(R_MIN,                  SCENE,   LOW)                                  \
+    OP(R_MAX,                  SCENE,   LOW)                                  \
+    OP(TOSS,                   SCENE,   LOW)                                  \
+    OP(MIN,                    NONE,    LOW)                                  \
+    OP(MAX,                    NONE,    LOW)                                  \
+    OP(LIM,                    NONE,    LOW)                                  \
+    OP(WRAP,                   NONE,    LOW)                                  \
+    OP(QT,                     NONE,    LOW)                                  \
+    OP(AVG,                    NONE,    LOW)                                  \
+    OP(EQ,                     NONE,    LOW)                                  \
+    OP(NE,                     NONE,    LOW)                                  \
+    OP(LT,                     NONE,    LOW)                                  \
+    OP(GT,                     NONE,    LOW)                                  \
+    OP(LTE,                    NONE,    LOW)                                  \
+    OP(GTE,                    NONE,    LOW)                                  \
+    OP(NZ,                     NONE,    LOW)                                  \
+    OP(EZ,                     NONE,    LOW)                                  \
+    OP(RSH,                    NONE,    LOW)                                  \
+    OP(LSH,                    NONE,    LOW)                                  \
+    OP(EXP,                    NONE,    LOW)                                  \
+    OP(ABS,                    NONE,    LOW)                                  \
+    OP(AND,                    NONE,    LOW)                                  \
+    OP(OR,                     NONE,    LOW)                                  \
+    OP(JI,                     NONE,    LOW)                                  \
+    OP(SCALE,                  NONE,    LOW)                                  \
+    OP(N,                      NONE,    LOW)                                  \
+    OP(V,                      NONE,    LOW)                                  \
+    OP(VV,                     NONE,    LOW)                                  \
+    OP(ER,                     NONE,    LOW)                                  \
+    OP(BPM,                    NONE,    LOW)                                  \
+    OP(BIT_OR,                 NONE,    LOW)                                  \
+    OP(BIT_AND,                NONE,    LOW)                                  \
+    OP(BIT_NOT,                NONE,    LOW)                                  \
+    OP(BIT_XOR,                NONE,    LOW)                                  \
+    OP(BSET,                   NONE,    LOW)                                  \
+    OP(BGET,                   NONE,    LOW)                                  \
+    OP(BCLR,                   NONE,    LOW)                                  \
+    OP(XOR,                    NONE,    LOW)                                  \
+    OP(CHAOS,                  SCENE,   LOW)                                  \
+    OP(CHAOS_R,                SCENE,   LOW)                                  \
+    OP(CHAOS_ALG,              SCENE,   LOW)                                  \
+    OP(SYM_PLUS,               NONE,    LOW)                                  \
+    OP(SYM_DASH,               NONE,    LOW)                                  \
+    OP(SYM_STAR,               NONE,    LOW)                                  \
+    OP(SYM_FORWARD_SLASH,      NONE,    LOW)                                  \
+    OP(SYM_PERCENTAGE,         NONE,    LOW)                                  \
+    OP(SYM_EQUAL_x2,           NONE,    LOW)                                  \
+    OP(SYM_EXCLAMATION_EQUAL,  NONE,    LOW)                                  \
+    OP(SYM_LEFT_ANGLED,        NONE,    LOW)                                  \
+    OP(SYM_RIGHT_ANGLED,       NONE,    LOW)                                  \
+    OP(SYM_LEFT_ANGLED_EQUAL,  NONE,    LOW)                                  \
+    OP(SYM_RIGHT_ANGLED_EQUAL, NONE,    LOW)                                  \
+    OP(SYM_EXCLAMATION,        NONE,    LOW)                                  \
+    OP(SYM_LEFT_ANGLED_x2,     NONE,    LOW)                                  \
+    OP(SYM_RIGHT_ANGLED_x2,    NONE,    LOW)                                  \
+    OP(SYM_AMPERSAND_x2,       NONE,    LOW)                                  \
+    OP(SYM_PIPE_x2,            NONE,    LOW)                                  \
+                                                                              \
+    /* stack */                                                               \
+    OP(S_ALL,                  CONTROL, HIGH)                                 \
+    OP(S_POP,                  CONTROL, HIGH)                                 \
+    OP(S_CLR,                  SCENE,   LOW)                                  \
+    OP(S_L,                    READ,    LOW)                                  \
+                                                                              \
+    /* controlflow */                                                         \
+    OP(SCRIPT,                 CONTROL, HIGH)                                 \
+    OP(KILL,                   CONTROL, MEDIUM)                               \
+    OP(SCENE,                  CONTROL, HIGH)                                 \
+    OP(BREAK,                  CONTROL, LOW)                                  \
+    OP(BRK,                    CONTROL, LOW)                                  \
+    OP(SYNC,                   CONTROL, LOW)                                  \
+    OP(BUDGET,                 SCENE,   LOW)                                  \
+    OP(BUDGET_ABORT,           SCENE,   LOW)                                  \
+    OP(BUDGET_OVER,            READ,    LOW)                                  \
+    OP(BUDGET_OPS,             READ,    LOW)                                  \
+    OP(BUDGET_DEPTH,           READ,    LOW)                                  \
+    OP(BUDGET_STACK,           READ,    LOW)                                  \
+    OP(BUDGET_W,               READ,    LOW)                                  \
+    OP(BUDGET_CLR,             SCENE,   LOW)                                  \
+                                                                              \
+    /* delay */                                                               \
+    OP(DEL_CLR,                CONTROL, MEDIUM)                               \
+                                                                              \
+    /* whitewhale */                                                          \
+    OP(WW_PRESET,              OUTPUT,  BUS)                                  \
+    OP(WW_POS,                 OUTPUT,  BUS)                                  \
+    OP(WW_SYNC,                OUTPUT,  BUS)                                  \
+    OP(WW_START,               OUTPUT,  BUS)                                  \
+    OP(WW_END,                 OUTPUT,  BUS)                                  \
+    OP(WW_PMODE,               OUTPUT,  BUS)                                  \
+    OP(WW_PATTERN,             OUTPUT,  BUS)                                  \
+    OP(WW_QPATTERN,            OUTPUT,  BUS)                                  \
+    OP(WW_MUTE1,               OUTPUT,  BUS)                                  \
+    OP(WW_MUTE2,               OUTPUT,  BUS)                                  \
+    OP(WW_MUTE3,               OUTPUT,  BUS)                                  \
+    OP(WW_MUTE4,               OUTPUT,  BUS)                                  \
+    OP(WW_MUTEA,               OUTPUT,  BUS)                                  \
+    OP(WW_MUTEB,               OUTPUT,  BUS)                                  \
+                                                                              \
+    /* meadowphysics */                                                       \
+    OP(MP_PRESET,              OUTPUT,  BUS)                                  \
+    OP(MP_RESET,               OUTPUT,  BUS)                                  \
+    OP(MP_STOP,                OUTPUT,  BUS)                                  \
+                                                                              \
+    /* earthsea */                                                            \
+    OP(ES_PRESET,              OUTPUT,  BUS)                                  \
+    OP(ES_MODE,                OUTPUT,  BUS)                                  \
+    OP(ES_CLOCK,               OUTPUT,  BUS)                                  \
+    OP(ES_RESET,               OUTPUT,  BUS)                                  \
+    OP(ES_PATTERN,             OUTPUT,  BUS)                                  \
+    OP(ES_TRANS,               OUTPUT,  BUS)                                  \
+    OP(ES_STOP,                OUTPUT,  BUS)                                  \
+    OP(ES_TRIPLE,              OUTPUT,  BUS)                                  \
+    OP(ES_MAGIC,               OUTPUT,  BUS)                                  \
+                                                                              \
+    /* orca */                                                                \
+    OP(OR_TRK,                 OUTPUT,  BUS)                                  \
+    OP(OR_CLK,                 OUTPUT,  BUS)                                  \
+    OP(OR_DIV,                 OUTPUT,  BUS)                                  \
+    OP(OR_PHASE,               OUTPUT,  BUS)                                  \
+    OP(OR_RST,                 OUTPUT,  BUS)                                  \
+    OP(OR_WGT,                 OUTPUT,  BUS)                                  \
+    OP(OR_MUTE,                OUTPUT,  BUS)                                  \
+    OP(OR_SCALE,               OUTPUT,  BUS)                                  \
+    OP(OR_BANK,                OUTPUT,  BUS)                                  \
+    OP(OR_PRESET,              OUTPUT,  BUS)                                  \
+    OP(OR_RELOAD,              OUTPUT,  BUS)                                  \
+    OP(OR_ROTS,                OUTPUT,  BUS)                                  \
+    OP(OR_ROTW,                OUTPUT,  BUS)                                  \
+    OP(OR_GRST,                OUTPUT,  BUS)                                  \
+    OP(OR_CVA,                 OUTPUT,  BUS)                                  \
+    OP(OR_CVB,                 OUTPUT,  BUS)                                  \
+                                                                              \
+    /* ansible */                                                             \
+    OP(KR_PRE,                 OUTPUT,  BUS)                                  \
+    OP(KR_PAT,                 OUTPUT,  BUS)                                  \
+    OP(KR_SCALE,               OUTPUT,  BUS)                                  \
+    OP(KR_PERIOD,              OUTPUT,  BUS)                                  \
+    OP(KR_POS,                 OUTPUT,  BUS)                                  \
+    OP(KR_L_ST,                OUTPUT,  BUS)                                  \
+    OP(KR_L_LEN,               OUTPUT,  BUS)                                  \
+    OP(KR_RES,                 OUTPUT,  BUS)                                  \
+    OP(ME_PRE,                 OUTPUT,  BUS)                                  \
+    OP(ME_RES,                 OUTPUT,  BUS)                                  \
+    OP(ME_STOP,                OUTPUT,  BUS)                                  \
+    OP(ME_SCALE,               OUTPUT,  BUS)                                  \
+    OP(ME_PERIOD,              OUTPUT,  BUS)                                  \
+    OP(LV_PRE,                 OUTPUT,  BUS)                                  \
+    OP(LV_RES,                 OUTPUT,  BUS)                                  \
+    OP(LV_POS,                 OUTPUT,  BUS)                                  \
+    OP(LV_L_ST,                OUTPUT,  BUS)                                  \
+    OP(LV_L_LEN,               OUTPUT,  BUS)                                  \
+    OP(LV_L_DIR,               OUTPUT,  BUS)                                  \
+    OP(LV_CV,                  READ,    BUS)                                  \
+    OP(CY_PRE,                 OUTPUT,  BUS)                                  \
+    OP(CY_RES,                 OUTPUT,  BUS)                                  \
+    OP(CY_POS,                 OUTPUT,  BUS)                                  \
+    OP(CY_REV,                 OUTPUT,  BUS)                                  \
+    OP(CY_CV,                  READ,    BUS)                                  \
+    OP(MID_SHIFT,              OUTPUT,  BUS)                                  \
+    OP(MID_SLEW,               OUTPUT,  BUS)                                  \
+    OP(ARP_STY,                OUTPUT,  BUS)                                  \
+    OP(ARP_HLD,                OUTPUT,  BUS)                                  \
+    OP(ARP_RPT,                OUTPUT,  BUS)                                  \
+    OP(ARP_GT,                 OUTPUT,  BUS)                                  \
+    OP(ARP_DIV,                OUTPUT,  BUS)                                  \
+    OP(ARP_RES,                OUTPUT,  BUS)                                  \
+    OP(ARP_SHIFT,              OUTPUT,  BUS)                                  \
+    OP(ARP_SLEW,               OUTPUT,  BUS)                                  \
+    OP(ARP_FIL,                OUTPUT,  BUS)                                  \
+    OP(ARP_ROT,                OUTPUT,  BUS)                                  \
+    OP(ARP_ER,                 OUTPUT,  BUS)                                  \
+                                                                              \
+    /* justfriends */                                                         \
+    OP(JF_TR,                  OUTPUT,  BUS)                                  \
+    OP(JF_RMODE,               OUTPUT,  BUS)                                  \
+    OP(JF_RUN,                 OUTPUT,  BUS)                                  \
+    OP(JF_SHIFT,               OUTPUT,  BUS)                                  \
+    OP(JF_VTR,                 OUTPUT,  BUS)                                  \
+    OP(JF_MODE,                OUTPUT,  BUS)                                  \
+    OP(JF_TICK,                OUTPUT,  BUS)                                  \
+    OP(JF_VOX,                 OUTPUT,  BUS)                                  \
+    OP(JF_NOTE,                OUTPUT,  BUS)                                  \
+    OP(JF_GOD,                 OUTPUT,  BUS)                                  \
+    OP(JF_TUNE,                OUTPUT,  BUS)                                  \
+    OP(JF_QT,                  OUTPUT,  BUS)                                  \
+                                                                              \
+    /* telex */                                                               \
+    OP(TO_TR,                  OUTPUT,  BUS)                                  \
+    OP(TO_TR_TOG,              OUTPUT,  BUS)                                  \
+    OP(TO_TR_PULSE,            OUTPUT,  BUS)                                  \
+    OP(TO_TR_TIME,             OUTPUT,  BUS)                                  \
+    OP(TO_TR_TIME_S,           OUTPUT,  BUS)                                  \
+    OP(TO_TR_TIME_M,           OUTPUT,  BUS)                                  \
+    OP(TO_TR_POL,              OUTPUT,  BUS)                                  \
+    OP(TO_KILL,                OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_TR_PULSE_DIV,        OUTPUT,  BUS)                                  \
+    OP(TO_TR_PULSE_MUTE,       OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_MUL,            OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_M,                   OUTPUT,  BUS)                                  \
+    OP(TO_M_S,                 OUTPUT,  BUS)                                  \
+    OP(TO_M_M,                 OUTPUT,  BUS)                                  \
+    OP(TO_M_BPM,               OUTPUT,  BUS)                                  \
+    OP(TO_M_ACT,               OUTPUT,  BUS)                                  \
+    OP(TO_M_SYNC,              OUTPUT,  BUS)                                  \
+    OP(TO_M_COUNT,             OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_TR_M,                OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_S,              OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_M,              OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_BPM,            OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_ACT,            OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_SYNC,           OUTPUT,  BUS)                                  \
+    OP(TO_TR_WIDTH,            OUTPUT,  BUS)                                  \
+    OP(TO_TR_M_COUNT,          OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_CV,                  OUTPUT,  BUS)                                  \
+    OP(TO_CV_SLEW,             OUTPUT,  BUS)                                  \
+    OP(TO_CV_SLEW_S,           OUTPUT,  BUS)                                  \
+    OP(TO_CV_SLEW_M,           OUTPUT,  BUS)                                  \
+    OP(TO_CV_SET,              OUTPUT,  BUS)                                  \
+    OP(TO_CV_OFF,              OUTPUT,  BUS)                                  \
+    OP(TO_CV_QT,               OUTPUT,  BUS)                                  \
+    OP(TO_CV_QT_SET,           OUTPUT,  BUS)                                  \
+    OP(TO_CV_N,                OUTPUT,  BUS)                                  \
+    OP(TO_CV_N_SET,            OUTPUT,  BUS)                                  \
+    OP(TO_CV_SCALE,            OUTPUT,  BUS)                                  \
+    OP(TO_CV_LOG,              OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_CV_INIT,             OUTPUT,  BUS)                                  \
+    OP(TO_TR_INIT,             OUTPUT,  BUS)                                  \
+    OP(TO_INIT,                OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_TR_P,                OUTPUT,  BUS)                                  \
+    OP(TO_TR_P_DIV,            OUTPUT,  BUS)                                  \
+    OP(TO_TR_P_MUTE,           OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_OSC,                 OUTPUT,  BUS)                                  \
+    OP(TO_OSC_SET,             OUTPUT,  BUS)                                  \
+    OP(TO_OSC_QT,              OUTPUT,  BUS)                                  \
+    OP(TO_OSC_QT_SET,          OUTPUT,  BUS)                                  \
+    OP(TO_OSC_FQ,              OUTPUT,  BUS)                                  \
+    OP(TO_OSC_FQ_SET,          OUTPUT,  BUS)                                  \
+    OP(TO_OSC_N,               OUTPUT,  BUS)                                  \
+    OP(TO_OSC_N_SET,           OUTPUT,  BUS)                                  \
+    OP(TO_OSC_LFO,             OUTPUT,  BUS)                                  \
+    OP(TO_OSC_LFO_SET,         OUTPUT,  BUS)                                  \
+    OP(TO_OSC_WAVE,            OUTPUT,  BUS)                                  \
+    OP(TO_OSC_SYNC,            OUTPUT,  BUS)                                  \
+    OP(TO_OSC_PHASE,           OUTPUT,  BUS)                                  \
+    OP(TO_OSC_WIDTH,           OUTPUT,  BUS)                                  \
+    OP(TO_OSC_RECT,            OUTPUT,  BUS)                                  \
+    OP(TO_OSC_SLEW,            OUTPUT,  BUS)                                  \
+    OP(TO_OSC_SLEW_S,          OUTPUT,  BUS)                                  \
+    OP(TO_OSC_SLEW_M,          OUTPUT,  BUS)                                  \
+    OP(TO_OSC_SCALE,           OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CYC,             OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CYC_S,           OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CYC_M,           OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CYC_SET,         OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CYC_S_SET,       OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CYC_M_SET,       OUTPUT,  BUS)                                  \
+    OP(TO_OSC_CTR,             OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TO_ENV_ACT,             OUTPUT,  BUS)                                  \
+    OP(TO_ENV_ATT,             OUTPUT,  BUS)                                  \
+    OP(TO_ENV_ATT_S,           OUTPUT,  BUS)                                  \
+    OP(TO_ENV_ATT_M,           OUTPUT,  BUS)                                  \
+    OP(TO_ENV_DEC,             OUTPUT,  BUS)                                  \
+    OP(TO_ENV_DEC_S,           OUTPUT,  BUS)                                  \
+    OP(TO_ENV_DEC_M,           OUTPUT,  BUS)                                  \
+    OP(TO_ENV_TRIG,            OUTPUT,  BUS)                                  \
+    OP(TO_ENV_EOR,             OUTPUT,  BUS)                                  \
+    OP(TO_ENV_EOC,             OUTPUT,  BUS)                                  \
+    OP(TO_ENV_LOOP,            OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TI_PARAM,               READ,    BUS)                                  \
+    OP(TI_PARAM_QT,            READ,    BUS)                                  \
+    OP(TI_PARAM_N,             READ,    BUS)                                  \
+    OP(TI_PARAM_SCALE,         OUTPUT,  BUS)                                  \
+    OP(TI_PARAM_MAP,           OUTPUT,  BUS)                                  \
+    OP(TI_IN,                  READ,    BUS)                                  \
+    OP(TI_IN_QT,               READ,    BUS)                                  \
+    OP(TI_IN_N,                READ,    BUS)                                  \
+    OP(TI_IN_SCALE,            OUTPUT,  BUS)                                  \
+    OP(TI_IN_MAP,              OUTPUT,  BUS)                                  \
+    OP(TI_PARAM_CALIB,         OUTPUT,  BUS)                                  \
+    OP(TI_IN_CALIB,            OUTPUT,  BUS)                                  \
+    OP(TI_STORE,               OUTPUT,  BUS)                                  \
+    OP(TI_RESET,               OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TI_PARAM_INIT,          OUTPUT,  BUS)                                  \
+    OP(TI_IN_INIT,             OUTPUT,  BUS)                                  \
+    OP(TI_INIT,                OUTPUT,  BUS)                                  \
+                                                                              \
+    OP(TI_POLL,                SCENE,   LOW)                                  \
+    OP(TI_PARAM_POLL,          SCENE,   LOW)                                  \
+    OP(TI_IN_POLL,             SCENE,   LOW)                                  \
+    OP(TI_PARAM_AGE,           READ,    LOW)                                  \
+    OP(TI_IN_AGE,              READ,    LOW)                                  \
+                                                                              \
+    OP(TI_PRM,                 READ,    BUS)                                  \
+    OP(TI_PRM_QT,              READ,    BUS)                                  \
+    OP(TI_PRM_N,               READ,    BUS)                                  \
+    OP(TI_PRM_SCALE,           OUTPUT,  BUS)                                  \
+    OP(TI_PRM_MAP,             OUTPUT,  BUS)                                  \
+    OP(TI_PRM_INIT,            OUTPUT,  BUS)
+
+#define TELE_MOD_LIST(MOD)                                                    \
+    /* controlflow */                                                         \
+    MOD(IF,                     CONTROL, LOW)                                 \
+    MOD(ELIF,                   CONTROL, LOW)                                 \
+    MOD(ELSE,                   CONTROL, LOW)                                 \
+    MOD(L,                      CONTROL, HIGH)                                \
+    MOD(W,                      CONTROL, HIGH)                                \
+    MOD(EVERY,                  CONTROL, LOW)                                 \
+    MOD(SKIP,                   CONTROL, LOW)                                 \
+    MOD(OTHER,                  CONTROL, LOW)                                 \
+    MOD(PROB,                   CONTROL, LOW)                                 \
+                                                                              \
+    /* delay */                                                               \
+    MOD(DEL,                    CONTROL, MEDIUM)                              \
+                                                                              \
+    /* stack */                                                               \
+    MOD(S,                      CONTROL, MEDIUM)
+
+#endif
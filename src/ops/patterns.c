@@ -456,6 +456,8 @@ static void p_prev_dec_i(scene_state_t *ss, int16_t pn) {
     else
         idx--;
 
+    if (idx < 0 || idx >= PATTERN_LENGTH) idx = 0;
+
     ss_set_pattern_idx(ss, pn, idx);
 }
 
@@ -470,7 +472,7 @@ static void op_P_PREV_get(const void *NOTUSED(data), scene_state_t *ss,
 
 static void op_PN_PREV_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    const int16_t pn = cs_pop(cs);
+    const int16_t pn = normalise_pn(cs_pop(cs));
     p_prev_dec_i(ss, pn);
     cs_push(cs, ss_get_pattern_val(ss, pn, ss_get_pattern_idx(ss, pn)));
     tele_pattern_updated();
@@ -488,7 +490,7 @@ static void op_P_PREV_set(const void *NOTUSED(data), scene_state_t *ss,
 
 static void op_PN_PREV_set(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    const int16_t pn = cs_pop(cs);
+    const int16_t pn = normalise_pn(cs_pop(cs));
     const int16_t a = cs_pop(cs);
     p_prev_dec_i(ss, pn);
     ss_set_pattern_val(ss, pn, ss_get_pattern_idx(ss, pn), a);
@@ -6,5 +6,8 @@
 extern const tele_op_t op_Q;
 extern const tele_op_t op_Q_AVG;
 extern const tele_op_t op_Q_N;
+extern const tele_op_t op_Q_MIN;
+extern const tele_op_t op_Q_MAX;
+extern const tele_op_t op_Q_SUM;
 
 #endif
@@ -212,6 +212,23 @@ static void op_TI_IN_INIT_get(const void *data, scene_state_t *ss,
 static void op_TI_INIT_get(const void *data, scene_state_t *ss,
                            exec_state_t *es, command_state_t *cs);
 
+static void op_TI_POLL_get(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_TI_POLL_set(const void *data, scene_state_t *ss,
+                           exec_state_t *es, command_state_t *cs);
+static void op_TI_PARAM_POLL_get(const void *data, scene_state_t *ss,
+                                 exec_state_t *es, command_state_t *cs);
+static void op_TI_PARAM_POLL_set(const void *data, scene_state_t *ss,
+                                 exec_state_t *es, command_state_t *cs);
+static void op_TI_IN_POLL_get(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
+static void op_TI_IN_POLL_set(const void *data, scene_state_t *ss,
+                              exec_state_t *es, command_state_t *cs);
+static void op_TI_PARAM_AGE_get(const void *data, scene_state_t *ss,
+                                exec_state_t *es, command_state_t *cs);
+static void op_TI_IN_AGE_get(const void *data, scene_state_t *ss,
+                             exec_state_t *es, command_state_t *cs);
+
 // clang-format off
 
 // TXo Operators
@@ -330,6 +347,12 @@ const tele_op_t op_TI_PARAM_INIT      = MAKE_GET_OP(TI.PARAM.INIT       , op_TI_
 const tele_op_t op_TI_IN_INIT         = MAKE_GET_OP(TI.IN.INIT          , op_TI_IN_INIT_get         , 1, false);
 const tele_op_t op_TI_INIT            = MAKE_GET_OP(TI.INIT             , op_TI_INIT_get            , 1, false);
 
+const tele_op_t op_TI_POLL            = MAKE_GET_SET_OP(TI.POLL         , op_TI_POLL_get            , op_TI_POLL_set            , 0, true);
+const tele_op_t op_TI_PARAM_POLL      = MAKE_GET_SET_OP(TI.PARAM.POLL   , op_TI_PARAM_POLL_get      , op_TI_PARAM_POLL_set      , 1, true);
+const tele_op_t op_TI_IN_POLL         = MAKE_GET_SET_OP(TI.IN.POLL      , op_TI_IN_POLL_get         , op_TI_IN_POLL_set         , 1, true);
+const tele_op_t op_TI_PARAM_AGE       = MAKE_GET_OP(TI.PARAM.AGE        , op_TI_PARAM_AGE_get       , 1, true);
+const tele_op_t op_TI_IN_AGE          = MAKE_GET_OP(TI.IN.AGE           , op_TI_IN_AGE_get          , 1, true);
+
 // TXi Aliases
 const tele_op_t op_TI_PRM             = MAKE_ALIAS_OP(TI.PRM            , op_TI_PARAM_get           , NULL, 1, true);
 const tele_op_t op_TI_PRM_QT          = MAKE_ALIAS_OP(TI.PRM.QT         , op_TI_PARAM_QT_get        , NULL, 1, true);
@@ -341,8 +364,8 @@ const tele_op_t op_TI_PRM_INIT        = MAKE_ALIAS_OP(TI.PRM.INIT       , op_TI_
 // clang-format on
 
 // telex helpers
-void TXSend(uint8_t model, uint8_t command, uint8_t output, int16_t value,
-            bool set) {
+void TXSend(scene_state_t *ss, uint8_t model, uint8_t command, uint8_t output,
+            int16_t value, bool set) {
     // zero-index the output
     output -= 1;
     // convert the output to the device and the port
@@ -359,421 +382,441 @@ void TXSend(uint8_t model, uint8_t command, uint8_t output, int16_t value,
         buffer[2] = temp >> 8;
         buffer[3] = temp & 0xff;
     }
-    tele_ii_tx(address, buffer, set ? 4 : 2);
-}
-void TXCmd(uint8_t model, uint8_t command, uint8_t output) {
-    TXSend(model, command, output, 0, false);
-}
-void TXSet(uint8_t model, uint8_t command, command_state_t *cs) {
+    // a value replaces one for the same command and port that hasn't been
+    // sent yet, except for TO.TR, where a gate set high then low is a trigger
+    if (set && command != TO_TR)
+        ii_tx_value(&ss->ii, address, buffer, 4, 2);
+    else
+        ii_tx(&ss->ii, address, buffer, set ? 4 : 2);
+}
+void TXCmd(scene_state_t *ss, uint8_t model, uint8_t command, uint8_t output) {
+    TXSend(ss, model, command, output, 0, false);
+}
+void TXSet(scene_state_t *ss, uint8_t model, uint8_t command,
+           command_state_t *cs) {
     uint8_t output = cs_pop(cs);
     int16_t value = cs_pop(cs);
-    TXSend(model, command, output, value, true);
+    TXSend(ss, model, command, output, value, true);
 }
-void TXDeviceSet(uint8_t model, uint8_t command, command_state_t *cs) {
+void TXDeviceSet(scene_state_t *ss, uint8_t model, uint8_t command,
+                 command_state_t *cs) {
     uint8_t output = DeviceToOutput(cs_pop(cs));
     int16_t value = cs_pop(cs);
-    TXSend(model, command, output, value, true);
+    TXSend(ss, model, command, output, value, true);
 }
-void TXReceive(uint8_t model, command_state_t *cs, uint8_t mode, bool shift) {
-    // zero-index the output
-    uint8_t input = cs_pop(cs) - 1;
-    // send the port, device and address
-    uint8_t port = input & 3;
+void TXInput(uint8_t model, uint8_t input, uint8_t mode, bool shift,
+             uint8_t *address, uint8_t *port) {
+    // zero-index the input
+    input -= 1;
+    // find the port, device and address
     uint8_t device = input >> 2;
-    uint8_t address = model + device;
+    *address = model + device;
     // inputs are numbered 0-7 for each device - shift is for the second half
     // mode pushes it up so it can read quantized values and note numbers
-    port += (shift ? 4 : 0) + (mode << 3);
-    // tell the device what value you are going to query
-    uint8_t buffer[2];
-    buffer[0] = port;
-    tele_ii_tx(address, buffer, 1);
-    // now read the value
-    buffer[0] = 0;
-    buffer[1] = 0;
-    tele_ii_rx(address, buffer, 2);
-    int16_t value = (buffer[0] << 8) + buffer[1];
-    cs_push(cs, value);
+    *port = (input & 3) + (shift ? 4 : 0) + (mode << 3);
+}
+void TXReceive(scene_state_t *ss, uint8_t model, command_state_t *cs,
+               uint8_t mode, bool shift) {
+    uint8_t address, port;
+    TXInput(model, cs_pop(cs), mode, shift, &address, &port);
+    // read from the cache if the input is polled, otherwise from the device
+    cs_push(cs, ii_poll_read(&ss->ii_poll, &ss->ii, address, port));
+}
+void TXPoll(scene_state_t *ss, uint8_t model, command_state_t *cs, bool shift,
+            bool set) {
+    uint8_t address, port;
+    TXInput(model, cs_pop(cs), 0, shift, &address, &port);
+    if (!set)
+        cs_push(cs, ii_poll_contains(&ss->ii_poll, address, port));
+    else if (cs_pop(cs))
+        ii_poll_add(&ss->ii_poll, address, port);
+    else
+        ii_poll_remove(&ss->ii_poll, address, port);
+}
+void TXAge(scene_state_t *ss, uint8_t model, command_state_t *cs, bool shift) {
+    uint8_t address, port;
+    TXInput(model, cs_pop(cs), 0, shift, &address, &port);
+    cs_push(cs, ii_poll_age(&ss->ii_poll, address, port));
 }
 uint8_t DeviceToOutput(int16_t device) {
     return ((device - 1) * 4) + 1;
 }
 // Temporary Init Functions (will refactor to the TELEX soon)
-void INInit(uint8_t input) {
-    TXSend(TI, TI_IN_SCALE, input, 0, true);
-    TXSend(TI, TI_IN_TOP, input, 16383, true);
-    TXSend(TI, TI_IN_BOT, input, -16384, true);
+void INInit(scene_state_t *ss, uint8_t input) {
+    TXSend(ss, TI, TI_IN_SCALE, input, 0, true);
+    TXSend(ss, TI, TI_IN_TOP, input, 16383, true);
+    TXSend(ss, TI, TI_IN_BOT, input, -16384, true);
 }
-void PRMInit(uint8_t input) {
-    TXSend(TI, TI_PARAM_SCALE, input, 0, true);
-    TXSend(TI, TI_PARAM_TOP, input, 16383, true);
-    TXSend(TI, TI_PARAM_BOT, input, 0, true);
+void PRMInit(scene_state_t *ss, uint8_t input) {
+    TXSend(ss, TI, TI_PARAM_SCALE, input, 0, true);
+    TXSend(ss, TI, TI_PARAM_TOP, input, 16383, true);
+    TXSend(ss, TI, TI_PARAM_BOT, input, 0, true);
 }
 
 // TELEX get and set methods
 // TXo
 static void op_TO_TR_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR, cs);
+    TXSet(ss, TO, TO_TR, cs);
 }
 static void op_TO_TR_TOG_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_TR_TOG, cs_pop(cs));
+    TXCmd(ss, TO, TO_TR_TOG, cs_pop(cs));
 }
 static void op_TO_TR_PULSE_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_TR_PULSE, cs_pop(cs));
+    TXCmd(ss, TO, TO_TR_PULSE, cs_pop(cs));
 }
 static void op_TO_TR_TIME_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_TIME, cs);
+    TXSet(ss, TO, TO_TR_TIME, cs);
 }
 static void op_TO_TR_TIME_S_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_TR_TIME_S, cs);
+    TXSet(ss, TO, TO_TR_TIME_S, cs);
 }
 static void op_TO_TR_TIME_M_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_TR_TIME_M, cs);
+    TXSet(ss, TO, TO_TR_TIME_M, cs);
 }
 static void op_TO_TR_POL_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_POL, cs);
+    TXSet(ss, TO, TO_TR_POL, cs);
 }
 static void op_TO_KILL_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_KILL, cs_pop(cs));
+    TXCmd(ss, TO, TO_KILL, cs_pop(cs));
 }
 static void op_TO_TR_PULSE_DIV_get(const void *NOTUSED(data), scene_state_t *ss,
                                    exec_state_t *NOTUSED(es),
                                    command_state_t *cs) {
-    TXSet(TO, TO_TR_PULSE_DIV, cs);
+    TXSet(ss, TO, TO_TR_PULSE_DIV, cs);
 }
 static void op_TO_TR_PULSE_MUTE_get(const void *NOTUSED(data),
                                     scene_state_t *ss,
                                     exec_state_t *NOTUSED(es),
                                     command_state_t *cs) {
-    TXSet(TO, TO_TR_PULSE_MUTE, cs);
+    TXSet(ss, TO, TO_TR_PULSE_MUTE, cs);
 }
 static void op_TO_TR_M_MUL_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_M_MUL, cs);
+    TXSet(ss, TO, TO_TR_M_MUL, cs);
 }
 static void op_TO_M_get(const void *NOTUSED(data), scene_state_t *ss,
                         exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXDeviceSet(TO, TO_M, cs);
+    TXDeviceSet(ss, TO, TO_M, cs);
 }
 static void op_TO_M_S_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXDeviceSet(TO, TO_M_S, cs);
+    TXDeviceSet(ss, TO, TO_M_S, cs);
 }
 static void op_TO_M_M_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXDeviceSet(TO, TO_M_M, cs);
+    TXDeviceSet(ss, TO, TO_M_M, cs);
 }
 static void op_TO_M_BPM_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXDeviceSet(TO, TO_M_BPM, cs);
+    TXDeviceSet(ss, TO, TO_M_BPM, cs);
 }
 static void op_TO_M_ACT_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXDeviceSet(TO, TO_M_ACT, cs);
+    TXDeviceSet(ss, TO, TO_M_ACT, cs);
 }
 
 static void op_TO_M_SYNC_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_M_SYNC, DeviceToOutput(cs_pop(cs)));
+    TXCmd(ss, TO, TO_M_SYNC, DeviceToOutput(cs_pop(cs)));
 }
 
 static void op_TO_M_COUNT_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXDeviceSet(TO, TO_M_COUNT, cs);
+    TXDeviceSet(ss, TO, TO_M_COUNT, cs);
 }
 static void op_TO_TR_M_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_M, cs);
+    TXSet(ss, TO, TO_TR_M, cs);
 }
 static void op_TO_TR_M_S_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_M_S, cs);
+    TXSet(ss, TO, TO_TR_M_S, cs);
 }
 static void op_TO_TR_M_M_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_M_M, cs);
+    TXSet(ss, TO, TO_TR_M_M, cs);
 }
 static void op_TO_TR_M_BPM_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_M_BPM, cs);
+    TXSet(ss, TO, TO_TR_M_BPM, cs);
 }
 static void op_TO_TR_M_ACT_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_M_ACT, cs);
+    TXSet(ss, TO, TO_TR_M_ACT, cs);
 }
 static void op_TO_TR_M_SYNC_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXCmd(TO, TO_TR_M_SYNC, cs_pop(cs));
+    TXCmd(ss, TO, TO_TR_M_SYNC, cs_pop(cs));
 }
 static void op_TO_TR_WIDTH_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_TR_WIDTH, cs);
+    TXSet(ss, TO, TO_TR_WIDTH, cs);
 }
 static void op_TO_TR_M_COUNT_get(const void *NOTUSED(data), scene_state_t *ss,
                                  exec_state_t *NOTUSED(es),
                                  command_state_t *cs) {
-    TXSet(TO, TO_TR_M_COUNT, cs);
+    TXSet(ss, TO, TO_TR_M_COUNT, cs);
 }
 static void op_TO_CV_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV, cs);
+    TXSet(ss, TO, TO_CV, cs);
 }
 static void op_TO_CV_SLEW_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_SLEW, cs);
+    TXSet(ss, TO, TO_CV_SLEW, cs);
 }
 static void op_TO_CV_SLEW_S_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_CV_SLEW_S, cs);
+    TXSet(ss, TO, TO_CV_SLEW_S, cs);
 }
 static void op_TO_CV_SLEW_M_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_CV_SLEW_M, cs);
+    TXSet(ss, TO, TO_CV_SLEW_M, cs);
 }
 static void op_TO_CV_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_SET, cs);
+    TXSet(ss, TO, TO_CV_SET, cs);
 }
 static void op_TO_CV_OFF_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_OFF, cs);
+    TXSet(ss, TO, TO_CV_OFF, cs);
 }
 static void op_TO_CV_QT_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_QT, cs);
+    TXSet(ss, TO, TO_CV_QT, cs);
 }
 static void op_TO_CV_QT_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_CV_QT_SET, cs);
+    TXSet(ss, TO, TO_CV_QT_SET, cs);
 }
 static void op_TO_CV_N_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_N, cs);
+    TXSet(ss, TO, TO_CV_N, cs);
 }
 static void op_TO_CV_N_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_N_SET, cs);
+    TXSet(ss, TO, TO_CV_N_SET, cs);
 }
 static void op_TO_CV_SCALE_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_SCALE, cs);
+    TXSet(ss, TO, TO_CV_SCALE, cs);
 }
 static void op_TO_CV_LOG_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_CV_LOG, cs);
+    TXSet(ss, TO, TO_CV_LOG, cs);
 }
 static void op_TO_OSC_get(const void *NOTUSED(data), scene_state_t *ss,
                           exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC, cs);
+    TXSet(ss, TO, TO_OSC, cs);
 }
 static void op_TO_OSC_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_SET, cs);
+    TXSet(ss, TO, TO_OSC_SET, cs);
 }
 static void op_TO_OSC_QT_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_QT, cs);
+    TXSet(ss, TO, TO_OSC_QT, cs);
 }
 static void op_TO_OSC_QT_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                  exec_state_t *NOTUSED(es),
                                  command_state_t *cs) {
-    TXSet(TO, TO_OSC_QT_SET, cs);
+    TXSet(ss, TO, TO_OSC_QT_SET, cs);
 }
 static void op_TO_OSC_FQ_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_FQ, cs);
+    TXSet(ss, TO, TO_OSC_FQ, cs);
 }
 static void op_TO_OSC_FQ_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                  exec_state_t *NOTUSED(es),
                                  command_state_t *cs) {
-    TXSet(TO, TO_OSC_FQ_SET, cs);
+    TXSet(ss, TO, TO_OSC_FQ_SET, cs);
 }
 static void op_TO_OSC_N_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_N, cs);
+    TXSet(ss, TO, TO_OSC_N, cs);
 }
 static void op_TO_OSC_N_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_OSC_N_SET, cs);
+    TXSet(ss, TO, TO_OSC_N_SET, cs);
 }
 static void op_TO_OSC_LFO_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_LFO, cs);
+    TXSet(ss, TO, TO_OSC_LFO, cs);
 }
 static void op_TO_OSC_LFO_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                   exec_state_t *NOTUSED(es),
                                   command_state_t *cs) {
-    TXSet(TO, TO_OSC_LFO_SET, cs);
+    TXSet(ss, TO, TO_OSC_LFO_SET, cs);
 }
 static void op_TO_OSC_WAVE_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_WAVE, cs);
+    TXSet(ss, TO, TO_OSC_WAVE, cs);
 }
 static void op_TO_OSC_SYNC_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_OSC_SYNC, cs_pop(cs));
+    TXCmd(ss, TO, TO_OSC_SYNC, cs_pop(cs));
 }
 static void op_TO_OSC_PHASE_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_OSC_PHASE, cs);
+    TXSet(ss, TO, TO_OSC_PHASE, cs);
 }
 static void op_TO_OSC_WIDTH_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_OSC_WIDTH, cs);
+    TXSet(ss, TO, TO_OSC_WIDTH, cs);
 }
 static void op_TO_OSC_RECT_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_RECT, cs);
+    TXSet(ss, TO, TO_OSC_RECT, cs);
 }
 static void op_TO_OSC_SLEW_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_SLEW, cs);
+    TXSet(ss, TO, TO_OSC_SLEW, cs);
 }
 static void op_TO_OSC_SLEW_S_get(const void *NOTUSED(data), scene_state_t *ss,
                                  exec_state_t *NOTUSED(es),
                                  command_state_t *cs) {
-    TXSet(TO, TO_OSC_SLEW_S, cs);
+    TXSet(ss, TO, TO_OSC_SLEW_S, cs);
 }
 static void op_TO_OSC_SLEW_M_get(const void *NOTUSED(data), scene_state_t *ss,
                                  exec_state_t *NOTUSED(es),
                                  command_state_t *cs) {
-    TXSet(TO, TO_OSC_SLEW_M, cs);
+    TXSet(ss, TO, TO_OSC_SLEW_M, cs);
 }
 static void op_TO_OSC_SCALE_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_OSC_SCALE, cs);
+    TXSet(ss, TO, TO_OSC_SCALE, cs);
 }
 static void op_TO_OSC_CYC_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_CYC, cs);
+    TXSet(ss, TO, TO_OSC_CYC, cs);
 }
 static void op_TO_OSC_CYC_S_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_OSC_CYC_S, cs);
+    TXSet(ss, TO, TO_OSC_CYC_S, cs);
 }
 static void op_TO_OSC_CYC_M_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_OSC_CYC_M, cs);
+    TXSet(ss, TO, TO_OSC_CYC_M, cs);
 }
 static void op_TO_OSC_CYC_SET_get(const void *NOTUSED(data), scene_state_t *ss,
                                   exec_state_t *NOTUSED(es),
                                   command_state_t *cs) {
-    TXSet(TO, TO_OSC_CYC_SET, cs);
+    TXSet(ss, TO, TO_OSC_CYC_SET, cs);
 }
 static void op_TO_OSC_CYC_S_SET_get(const void *NOTUSED(data),
                                     scene_state_t *ss,
                                     exec_state_t *NOTUSED(es),
                                     command_state_t *cs) {
-    TXSet(TO, TO_OSC_CYC_S_SET, cs);
+    TXSet(ss, TO, TO_OSC_CYC_S_SET, cs);
 }
 static void op_TO_OSC_CYC_M_SET_get(const void *NOTUSED(data),
                                     scene_state_t *ss,
                                     exec_state_t *NOTUSED(es),
                                     command_state_t *cs) {
-    TXSet(TO, TO_OSC_CYC_M_SET, cs);
+    TXSet(ss, TO, TO_OSC_CYC_M_SET, cs);
 }
 static void op_TO_OSC_CTR_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_OSC_CTR, cs);
+    TXSet(ss, TO, TO_OSC_CTR, cs);
 }
 static void op_TO_ENV_ACT_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_ENV_ACT, cs);
+    TXSet(ss, TO, TO_ENV_ACT, cs);
 }
 static void op_TO_ENV_ATT_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_ENV_ATT, cs);
+    TXSet(ss, TO, TO_ENV_ATT, cs);
 }
 static void op_TO_ENV_ATT_S_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_ENV_ATT_S, cs);
+    TXSet(ss, TO, TO_ENV_ATT_S, cs);
 }
 static void op_TO_ENV_ATT_M_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_ENV_ATT_M, cs);
+    TXSet(ss, TO, TO_ENV_ATT_M, cs);
 }
 static void op_TO_ENV_DEC_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_ENV_DEC, cs);
+    TXSet(ss, TO, TO_ENV_DEC, cs);
 }
 static void op_TO_ENV_DEC_S_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_ENV_DEC_S, cs);
+    TXSet(ss, TO, TO_ENV_DEC_S, cs);
 }
 static void op_TO_ENV_DEC_M_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
                                 command_state_t *cs) {
-    TXSet(TO, TO_ENV_DEC_M, cs);
+    TXSet(ss, TO, TO_ENV_DEC_M, cs);
 }
 static void op_TO_ENV_TRIG_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_ENV_TRIG, cs_pop(cs));
+    TXCmd(ss, TO, TO_ENV_TRIG, cs_pop(cs));
 }
 static void op_TO_ENV_EOR_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_ENV_EOR, cs);
+    TXSet(ss, TO, TO_ENV_EOR, cs);
 }
 static void op_TO_ENV_EOC_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_ENV_EOC, cs);
+    TXSet(ss, TO, TO_ENV_EOC, cs);
 }
 static void op_TO_ENV_LOOP_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TO, TO_ENV_LOOP, cs);
+    TXSet(ss, TO, TO_ENV_LOOP, cs);
 }
 static void op_TO_CV_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_CV_INIT, cs_pop(cs));
+    TXCmd(ss, TO, TO_CV_INIT, cs_pop(cs));
 }
 static void op_TO_TR_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_TR_INIT, cs_pop(cs));
+    TXCmd(ss, TO, TO_TR_INIT, cs_pop(cs));
 }
 static void op_TO_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TO, TO_INIT, DeviceToOutput(cs_pop(cs)));
+    TXCmd(ss, TO, TO_INIT, DeviceToOutput(cs_pop(cs)));
 }
 
 // TXi
 static void op_TI_PARAM_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXReceive(TI, cs, 0, false);
+    TXReceive(ss, TI, cs, 0, false);
 }
 static void op_TI_PARAM_QT_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXReceive(TI, cs, 1, false);
+    TXReceive(ss, TI, cs, 1, false);
 }
 static void op_TI_PARAM_N_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXReceive(TI, cs, 2, false);
+    TXReceive(ss, TI, cs, 2, false);
 }
 static void op_TI_PARAM_SCALE_get(const void *NOTUSED(data), scene_state_t *ss,
                                   exec_state_t *NOTUSED(es),
                                   command_state_t *cs) {
-    TXSet(TI, TI_PARAM_SCALE, cs);
+    TXSet(ss, TI, TI_PARAM_SCALE, cs);
 }
 static void op_TI_PARAM_MAP_get(const void *NOTUSED(data), scene_state_t *ss,
                                 exec_state_t *NOTUSED(es),
@@ -781,58 +824,58 @@ static void op_TI_PARAM_MAP_get(const void *NOTUSED(data), scene_state_t *ss,
     uint8_t output = cs_pop(cs);
     int16_t bottom = cs_pop(cs);
     int16_t top = cs_pop(cs);
-    TXSend(TI, TI_PARAM_TOP, output, top, true);
-    TXSend(TI, TI_PARAM_BOT, output, bottom, true);
+    TXSend(ss, TI, TI_PARAM_TOP, output, top, true);
+    TXSend(ss, TI, TI_PARAM_BOT, output, bottom, true);
 }
 static void op_TI_IN_get(const void *NOTUSED(data), scene_state_t *ss,
                          exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXReceive(TI, cs, 0, true);
+    TXReceive(ss, TI, cs, 0, true);
 }
 static void op_TI_IN_QT_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXReceive(TI, cs, 1, true);
+    TXReceive(ss, TI, cs, 1, true);
 }
 static void op_TI_IN_N_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXReceive(TI, cs, 2, true);
+    TXReceive(ss, TI, cs, 2, true);
 }
 static void op_TI_IN_SCALE_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TI, TI_IN_SCALE, cs);
+    TXSet(ss, TI, TI_IN_SCALE, cs);
 }
 static void op_TI_IN_MAP_get(const void *NOTUSED(data), scene_state_t *ss,
                              exec_state_t *NOTUSED(es), command_state_t *cs) {
     uint8_t output = cs_pop(cs);
     int16_t bottom = cs_pop(cs);
     int16_t top = cs_pop(cs);
-    TXSend(TI, TI_IN_TOP, output, top, true);
-    TXSend(TI, TI_IN_BOT, output, bottom, true);
+    TXSend(ss, TI, TI_IN_TOP, output, top, true);
+    TXSend(ss, TI, TI_IN_BOT, output, bottom, true);
 }
 static void op_TI_PARAM_CALIB_get(const void *NOTUSED(data), scene_state_t *ss,
                                   exec_state_t *NOTUSED(es),
                                   command_state_t *cs) {
-    TXSet(TI, TI_PARAM_CALIB, cs);
+    TXSet(ss, TI, TI_PARAM_CALIB, cs);
 }
 static void op_TI_IN_CALIB_get(const void *NOTUSED(data), scene_state_t *ss,
                                exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXSet(TI, TI_IN_CALIB, cs);
+    TXSet(ss, TI, TI_IN_CALIB, cs);
 }
 static void op_TI_STORE_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TI, TI_STORE, DeviceToOutput(cs_pop(cs)));
+    TXCmd(ss, TI, TI_STORE, DeviceToOutput(cs_pop(cs)));
 }
 static void op_TI_RESET_get(const void *NOTUSED(data), scene_state_t *ss,
                             exec_state_t *NOTUSED(es), command_state_t *cs) {
-    TXCmd(TI, TI_RESET, DeviceToOutput(cs_pop(cs)));
+    TXCmd(ss, TI, TI_RESET, DeviceToOutput(cs_pop(cs)));
 }
 static void op_TI_PARAM_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                                  exec_state_t *NOTUSED(es),
                                  command_state_t *cs) {
-    PRMInit(cs_pop(cs));
+    PRMInit(ss, cs_pop(cs));
 }
 static void op_TI_IN_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                               exec_state_t *NOTUSED(es), command_state_t *cs) {
-    INInit(cs_pop(cs));
+    INInit(ss, cs_pop(cs));
 }
 static void op_TI_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
                            exec_state_t *NOTUSED(es), command_state_t *cs) {
@@ -840,7 +883,43 @@ static void op_TI_INIT_get(const void *NOTUSED(data), scene_state_t *ss,
     uint8_t start = end - 3;
     uint8_t i;
     for (i = start; i <= end; i++) {
-        PRMInit(i);
-        INInit(i);
+        PRMInit(ss, i);
+        INInit(ss, i);
     }
 }
+static void op_TI_POLL_get(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    cs_push(cs, ss->ii_poll.period);
+}
+static void op_TI_POLL_set(const void *NOTUSED(data), scene_state_t *ss,
+                           exec_state_t *NOTUSED(es), command_state_t *cs) {
+    int16_t period = cs_pop(cs);
+    ss->ii_poll.period = period < 0 ? 0 : period;
+}
+static void op_TI_PARAM_POLL_get(const void *NOTUSED(data), scene_state_t *ss,
+                                 exec_state_t *NOTUSED(es),
+                                 command_state_t *cs) {
+    TXPoll(ss, TI, cs, false, false);
+}
+static void op_TI_PARAM_POLL_set(const void *NOTUSED(data), scene_state_t *ss,
+                                 exec_state_t *NOTUSED(es),
+                                 command_state_t *cs) {
+    TXPoll(ss, TI, cs, false, true);
+}
+static void op_TI_IN_POLL_get(const void *NOTUSED(data), scene_state_t *ss,
+                              exec_state_t *NOTUSED(es), command_state_t *cs) {
+    TXPoll(ss, TI, cs, true, false);
+}
+static void op_TI_IN_POLL_set(const void *NOTUSED(data), scene_state_t *ss,
+                              exec_state_t *NOTUSED(es), command_state_t *cs) {
+    TXPoll(ss, TI, cs, true, true);
+}
+static void op_TI_PARAM_AGE_get(const void *NOTUSED(data), scene_state_t *ss,
+                                exec_state_t *NOTUSED(es),
+                                command_state_t *cs) {
+    TXAge(ss, TI, cs, false);
+}
+static void op_TI_IN_AGE_get(const void *NOTUSED(data), scene_state_t *ss,
+                             exec_state_t *NOTUSED(es), command_state_t *cs) {
+    TXAge(ss, TI, cs, true);
+}
@@ -122,6 +122,12 @@ extern const tele_op_t op_TI_PARAM_INIT;
 extern const tele_op_t op_TI_IN_INIT;
 extern const tele_op_t op_TI_INIT;
 
+extern const tele_op_t op_TI_POLL;
+extern const tele_op_t op_TI_PARAM_POLL;
+extern const tele_op_t op_TI_IN_POLL;
+extern const tele_op_t op_TI_PARAM_AGE;
+extern const tele_op_t op_TI_IN_AGE;
+
 extern const tele_op_t op_TI_PRM;
 extern const tele_op_t op_TI_PRM_QT;
 extern const tele_op_t op_TI_PRM_N;
@@ -130,16 +136,24 @@ extern const tele_op_t op_TI_PRM_MAP;
 extern const tele_op_t op_TI_PRM_INIT;
 
 // helpers
-void TXSend(uint8_t model, uint8_t command, uint8_t output, int16_t value,
+void TXSend(scene_state_t *ss, uint8_t model, uint8_t command, uint8_t output,
+            int16_t value, bool set);
+void TXCmd(scene_state_t *ss, uint8_t model, uint8_t command, uint8_t output);
+void TXSet(scene_state_t *ss, uint8_t model, uint8_t command,
+           command_state_t *cs);
+void TXDeviceSet(scene_state_t *ss, uint8_t model, uint8_t command,
+                 command_state_t *cs);
+void TXInput(uint8_t model, uint8_t input, uint8_t mode, bool shift,
+             uint8_t *address, uint8_t *port);
+void TXReceive(scene_state_t *ss, uint8_t model, command_state_t *cs,
+               uint8_t mode, bool shift);
+void TXPoll(scene_state_t *ss, uint8_t model, command_state_t *cs, bool shift,
             bool set);
-void TXCmd(uint8_t model, uint8_t command, uint8_t output);
-void TXSet(uint8_t model, uint8_t command, command_state_t *cs);
-void TXDeviceSet(uint8_t model, uint8_t command, command_state_t *cs);
-void TXReceive(uint8_t model, command_state_t *cs, uint8_t mode, bool shift);
+void TXAge(scene_state_t *ss, uint8_t model, command_state_t *cs, bool shift);
 uint8_t DeviceToOutput(int16_t device);
 // temporary init functions
-void INInit(uint8_t input);
-void PRMInit(uint8_t input);
+void INInit(scene_state_t *ss, uint8_t input);
+void PRMInit(scene_state_t *ss, uint8_t input);
 
 // constants
 
@@ -0,0 +1,202 @@
+#include "profiler.h"
+
+#ifdef TELETYPE_PROFILE
+
+#include <string.h>
+
+#include "ops/op.h"
+#include "state.h"
+#include "util.h"
+
+// the simulator can run scenes on several threads at once (tt -j), each
+// thread keeps its own tables, and tt -p prints the main thread's
+#ifdef SIM
+#define PROFILE_TABLE static __thread
+#else
+#define PROFILE_TABLE static
+#endif
+
+PROFILE_TABLE profile_stat_t scripts[SCRIPT_COUNT];
+PROFILE_TABLE profile_stat_t lines[SCRIPT_COUNT][SCRIPT_MAX_COMMANDS];
+PROFILE_TABLE profile_stat_t delays;
+PROFILE_TABLE profile_count_t ops[E_OP__LENGTH];
+PROFILE_TABLE profile_count_t mods[E_MOD__LENGTH];
+
+void profile_clear() {
+    memset(scripts, 0, sizeof(scripts));
+    memset(lines, 0, sizeof(lines));
+    memset(&delays, 0, sizeof(delays));
+    memset(ops, 0, sizeof(ops));
+    memset(mods, 0, sizeof(mods));
+}
+
+static void count(profile_count_t *c, uint32_t ticks) {
+    if (c->count == 0 || ticks < c->min) c->min = ticks;
+    if (ticks > c->max) c->max = ticks;
+    c->total += ticks;
+    c->count++;
+}
+
+static void stat(profile_stat_t *s, uint32_t ticks) {
+    uint8_t b = 0;
+    while (ticks >> b && b < PROFILE_BUCKETS - 1) b++;
+    s->histogram[b]++;
+    count(&s->c, ticks);
+}
+
+void profile_script(size_t script, uint32_t ticks) {
+    if (script < SCRIPT_COUNT) stat(&scripts[script], ticks);
+}
+
+void profile_line(size_t script, size_t line, uint32_t ticks) {
+    if (script < SCRIPT_COUNT && line < SCRIPT_MAX_COMMANDS)
+        stat(&lines[script][line], ticks);
+}
+
+void profile_op(size_t op, uint32_t ticks) {
+    if (op < E_OP__LENGTH) count(&ops[op], ticks);
+}
+
+void profile_mod(size_t mod, uint32_t ticks) {
+    if (mod < E_MOD__LENGTH) count(&mods[mod], ticks);
+}
+
+void profile_delay(uint32_t ticks) {
+    stat(&delays, ticks);
+}
+
+const profile_stat_t *profile_get_script(size_t script) {
+    return &scripts[script];
+}
+
+const profile_stat_t *profile_get_line(size_t script, size_t line) {
+    return &lines[script][line];
+}
+
+const profile_count_t *profile_get_op(size_t op) {
+    return &ops[op];
+}
+
+uint32_t profile_percentile(const profile_stat_t *s, uint8_t pct) {
+    if (s->c.count == 0) return 0;
+
+    // the rank of the sample we want, rounded up
+    uint64_t rank = ((uint64_t)s->c.count * pct + 99) / 100;
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (uint8_t b = 0; b < PROFILE_BUCKETS; b++) {
+        seen += s->histogram[b];
+        if (seen >= rank) {
+            // bucket b holds values below 2^b, the max is always tighter for
+            // the last bucket
+            uint32_t bound = b ? (1UL << b) - 1 : 0;
+            if (b == PROFILE_BUCKETS - 1 || bound > s->c.max) bound = s->c.max;
+            return bound;
+        }
+    }
+    return s->c.max;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// dump
+
+static void append(char *line, const char *label, uint32_t value) {
+    char n[12];
+    strcat(line, label);
+    itoa(value, n, 10);
+    strcat(line, n);
+}
+
+static void dump_count(char *line, const profile_count_t *c) {
+    append(line, " N ", c->count);
+    append(line, " MIN ", c->min);
+    append(line, " MEAN ", c->total / c->count);
+    append(line, " MAX ", c->max);
+}
+
+static void dump_stat(char *line, const profile_stat_t *s) {
+    dump_count(line, &s->c);
+    append(line, " P50 ", profile_percentile(s, 50));
+    append(line, " P90 ", profile_percentile(s, 90));
+    append(line, " P99 ", profile_percentile(s, 99));
+}
+
+// the ops of each effect (see op_list.h) together
+static void sum_effect(profile_count_t *sum, uint8_t effect) {
+    memset(sum, 0, sizeof(profile_count_t));
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const profile_count_t *c = &ops[i];
+        if (c->count == 0 || tele_op_info[i].effect != effect) continue;
+        if (sum->count == 0 || c->min < sum->min) sum->min = c->min;
+        if (c->max > sum->max) sum->max = c->max;
+        sum->total += c->total;
+        sum->count += c->count;
+    }
+}
+
+static const char *script_name(size_t script) {
+    static const char *names[SCRIPT_COUNT] = { "1", "2", "3", "4", "5", "6",
+                                               "7", "8", "M", "I", "T" };
+    return names[script];
+}
+
+void profile_dump(profile_print_t print) {
+    char line[128];
+
+    for (size_t s = 0; s < SCRIPT_COUNT; s++) {
+        if (scripts[s].c.count == 0) continue;
+        strcpy(line, "SCRIPT ");
+        strcat(line, script_name(s));
+        dump_stat(line, &scripts[s]);
+        print(line);
+    }
+
+    for (size_t s = 0; s < SCRIPT_COUNT; s++) {
+        for (size_t l = 0; l < SCRIPT_MAX_COMMANDS; l++) {
+            if (lines[s][l].c.count == 0) continue;
+            strcpy(line, "LINE ");
+            strcat(line, script_name(s));
+            append(line, ".", l + 1);
+            dump_stat(line, &lines[s][l]);
+            print(line);
+        }
+    }
+
+    if (delays.c.count) {
+        strcpy(line, "DEL");
+        dump_stat(line, &delays);
+        print(line);
+    }
+
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        if (ops[i].count == 0) continue;
+        strcpy(line, "OP ");
+        strcat(line, tele_ops[i]->name);
+        dump_count(line, &ops[i]);
+        print(line);
+    }
+
+    static const char *effects[OP_EFFECT__LENGTH] = { "NONE", "READ", "SCENE",
+                                                      "OUTPUT", "CONTROL" };
+    for (uint8_t e = 0; e < OP_EFFECT__LENGTH; e++) {
+        profile_count_t sum;
+        sum_effect(&sum, e);
+        if (sum.count == 0) continue;
+        strcpy(line, "EFFECT ");
+        strcat(line, effects[e]);
+        dump_count(line, &sum);
+        print(line);
+    }
+
+    for (size_t i = 0; i < E_MOD__LENGTH; i++) {
+        if (mods[i].count == 0) continue;
+        strcpy(line, "MOD ");
+        strcat(line, tele_mods[i]->name);
+        dump_count(line, &mods[i]);
+        print(line);
+    }
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+// Execution profiler, compiled in by building with -DTELETYPE_PROFILE.
+//
+// Scripts, script lines, ops, mods and delays are timed with
+// tele_profile_time() (see teletype_io.h), the unit is whatever the target
+// clock counts in (CPU cycles on the module, ns in the simulator).
+
+#ifdef TELETYPE_PROFILE
+
+#include <stddef.h>
+#include <stdint.h>
+
+// log2 buckets, the last one catches everything above 2^22 ticks
+#define PROFILE_BUCKETS 24
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} profile_count_t;
+
+typedef struct {
+    profile_count_t c;
+    uint32_t histogram[PROFILE_BUCKETS];
+} profile_stat_t;
+
+typedef void (*profile_print_t)(const char *line);
+
+void profile_clear(void);
+
+void profile_script(size_t script, uint32_t ticks);
+void profile_line(size_t script, size_t line, uint32_t ticks);
+void profile_op(size_t op, uint32_t ticks);
+void profile_mod(size_t mod, uint32_t ticks);
+void profile_delay(uint32_t ticks);
+
+const profile_stat_t *profile_get_script(size_t script);
+const profile_stat_t *profile_get_line(size_t script, size_t line);
+const profile_count_t *profile_get_op(size_t op);
+
+// upper bound of the histogram bucket holding the pct'th percentile
+uint32_t profile_percentile(const profile_stat_t *s, uint8_t pct);
+
+// one line for each script, line, op and mod that has run, and for the ops of
+// each effect (from op_list.h) together
+void profile_dump(profile_print_t print);
+
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+#include "queue.h"
+
+#include <stdbool.h>
+
+// the position in val of the i-th newest value
+static uint16_t position(scene_queue_t *q, int16_t i) {
+    return (q->head + Q_LENGTH - i) % Q_LENGTH;
+}
+
+// how many values ago the value at pos was pushed
+static int16_t age(scene_queue_t *q, uint16_t pos) {
+    return (q->head + Q_LENGTH - pos) % Q_LENGTH;
+}
+
+// drop positions from the back of a deque that the value at pos replaces as a
+// candidate, then add pos
+static void deque_push(scene_queue_t *q, uint16_t *deque, uint16_t front,
+                       uint16_t *count, uint16_t pos, bool is_min) {
+    const int16_t value = q->val[pos];
+    while (*count) {
+        const int16_t back = q->val[deque[(front + *count - 1) % Q_LENGTH]];
+        if (is_min ? back < value : back > value) break;
+        (*count)--;
+    }
+    deque[(front + *count) % Q_LENGTH] = pos;
+    (*count)++;
+}
+
+// drop the front of a deque if it's about to leave the queue
+static void deque_expire(scene_queue_t *q, uint16_t *deque, uint16_t *front,
+                         uint16_t *count) {
+    if (*count && age(q, deque[*front]) >= q->n - 1) {
+        *front = (*front + 1) % Q_LENGTH;
+        (*count)--;
+    }
+}
+
+static void rebuild(scene_queue_t *q) {
+    q->sum = 0;
+    q->min_front = q->min_count = 0;
+    q->max_front = q->max_count = 0;
+    for (int16_t i = q->n - 1; i >= 0; i--) {
+        const uint16_t pos = position(q, i);
+        q->sum += q->val[pos];
+        deque_push(q, q->min, q->min_front, &q->min_count, pos, true);
+        deque_push(q, q->max, q->max_front, &q->max_count, pos, false);
+    }
+}
+
+void queue_init(scene_queue_t *q) {
+    for (uint16_t i = 0; i < Q_LENGTH; i++) q->val[i] = 0;
+    q->head = 0;
+    q->n = 1;
+    rebuild(q);
+}
+
+void queue_push(scene_queue_t *q, int16_t value) {
+    if (q->n < 1) queue_set_length(q, 1);
+
+    // the oldest value leaves the queue before its slot can be reused
+    deque_expire(q, q->min, &q->min_front, &q->min_count);
+    deque_expire(q, q->max, &q->max_front, &q->max_count);
+    q->sum -= q->val[position(q, q->n - 1)];
+
+    q->head = (q->head + 1) % Q_LENGTH;
+    q->val[q->head] = value;
+    q->sum += value;
+    deque_push(q, q->min, q->min_front, &q->min_count, q->head, true);
+    deque_push(q, q->max, q->max_front, &q->max_count, q->head, false);
+}
+
+void queue_fill(scene_queue_t *q, int16_t value) {
+    for (uint16_t i = 0; i < Q_LENGTH; i++) q->val[i] = value;
+    rebuild(q);
+}
+
+void queue_set_length(scene_queue_t *q, int16_t n) {
+    if (n < 1)
+        n = 1;
+    else if (n > Q_LENGTH)
+        n = Q_LENGTH;
+    q->n = n;
+    rebuild(q);
+}
+
+int16_t queue_length(scene_queue_t *q) {
+    return q->n;
+}
+
+int16_t queue_get(scene_queue_t *q) {
+    if (q->n < 1) return 0;
+    return q->val[position(q, q->n - 1)];
+}
+
+int32_t queue_sum(scene_queue_t *q) {
+    return q->sum;
+}
+
+int16_t queue_avg(scene_queue_t *q) {
+    if (q->n < 1) return 0;
+
+    // halves round up
+    int32_t avg = (q->sum * 2) / q->n;
+    if (avg % 2) avg += 1;
+    return avg / 2;
+}
+
+int16_t queue_min(scene_queue_t *q) {
+    if (!q->min_count) return 0;
+    return q->val[q->min[q->min_front]];
+}
+
+int16_t queue_max(scene_queue_t *q) {
+    if (!q->max_count) return 0;
+    return q->val[q->max[q->max_front]];
+}
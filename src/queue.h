@@ -0,0 +1,45 @@
+#ifndef _QUEUE_H_
+#define _QUEUE_H_
+
+#include <stdint.h>
+
+// the number of values the queue remembers, and so the largest Q.N, can be set
+// at build time (e.g. -DQ_LENGTH=256)
+#ifndef Q_LENGTH
+#define Q_LENGTH 64
+#endif
+
+// The queue is a ring buffer of the last Q_LENGTH values pushed. Only the
+// newest n (Q.N) of them are in the queue, their sum is kept up to date as
+// values are pushed, as are two monotonic deques of positions in val, the
+// values that may yet become the min (or max) of the queue, oldest first. That
+// makes pushing, and reading the sum, min or max, O(1) (amortised for the
+// deques). Changing n, or filling the queue, rebuilds them in O(n).
+
+typedef struct {
+    int16_t val[Q_LENGTH];
+    uint16_t min[Q_LENGTH];  // ring of positions, with increasing values
+    uint16_t max[Q_LENGTH];  // ring of positions, with decreasing values
+    uint16_t min_front;
+    uint16_t min_count;
+    uint16_t max_front;
+    uint16_t max_count;
+    uint16_t head;  // position of the newest value
+    int16_t n;
+    int32_t sum;  // of the newest n values
+} scene_queue_t;
+
+void queue_init(scene_queue_t *q);
+void queue_push(scene_queue_t *q, int16_t value);
+void queue_fill(scene_queue_t *q, int16_t value);
+void queue_set_length(scene_queue_t *q, int16_t n);
+int16_t queue_length(scene_queue_t *q);
+
+// the oldest value in the queue
+int16_t queue_get(scene_queue_t *q);
+int32_t queue_sum(scene_queue_t *q);
+int16_t queue_avg(scene_queue_t *q);
+int16_t queue_min(scene_queue_t *q);
+int16_t queue_max(scene_queue_t *q);
+
+#endif
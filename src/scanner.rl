@@ -32,6 +32,8 @@ error_t scanner(const char *data, tele_command_t *out,
 
     // reset outputs
     error_msg[0] = 0;
+    // clear the unused words too, so that equal commands are equal in memory
+    memset(out, 0, sizeof(tele_command_t));
     out->length = 0;
     out->separator = -1;
 
@@ -49,17 +51,22 @@ error_t scanner(const char *data, tele_command_t *out,
         action token {
             // token matched
 
-            // copy the matched token to buf
-            char buf[kMaxTokenLength];
             size_t len = te-ts;
+#ifdef MATCH_TOKEN_HASH
+            // the hash matcher reads the token where it is
+            const char* buf = ts;
+#else
+            // copy the matched token to buf
+            char buf[kMaxTokenLength + 1];
             if (len > kMaxTokenLength) len = kMaxTokenLength;
             memcpy(buf, ts, len);
             buf[len] = '\0';
+#endif
 
             tele_data_t tele_data;
             if (match_token(buf, len, &tele_data)) {
                 // if we have a match, copy data to the the command
-                out->data[out->length] = tele_data;
+                command_set(out, out->length, tele_data.tag, tele_data.value);
 
                 // increase the command length
                 out->length++;
@@ -69,7 +76,10 @@ error_t scanner(const char *data, tele_command_t *out,
             }
             else {
                 // can't match the token, fail
-                strcpy(error_msg, buf);
+                if (len > TELE_ERROR_MSG_LENGTH - 1)
+                    len = TELE_ERROR_MSG_LENGTH - 1;
+                memcpy(error_msg, buf, len);
+                error_msg[len] = '\0';
                 return E_PARSE;
             }
         }
@@ -79,8 +89,7 @@ error_t scanner(const char *data, tele_command_t *out,
 
             // it's a PRE_SEP, we need to record it's position
             // (validate checks for too many PRE_SEP tokens)
-            out->data[out->length].tag = PRE_SEP;
-            out->data[out->length].value = 0;
+            command_set(out, out->length, PRE_SEP, 0);
             out->separator = out->length;
 
             // increase the command length
@@ -92,8 +101,7 @@ error_t scanner(const char *data, tele_command_t *out,
 
         action sub_separator {
             // ':' mod separator matched
-            out->data[out->length].tag = SUB_SEP;
-            out->data[out->length].value = 0;
+            command_set(out, out->length, SUB_SEP, 0);
 
             // increase the command length
             out->length++;
@@ -0,0 +1,496 @@
+#include "scene_binary.h"
+
+#include <string.h>
+
+#include "match_token.h"
+#include "ops/op.h"
+#include "teletype.h"
+
+// each word is a varint with its kind in the bottom 2 bits, and either a
+// zigzagged number or an index into the dictionary in the rest
+enum { WORD_NUMBER, WORD_NAME, WORD_PRE_SEP, WORD_SUB_SEP };
+#define WORD_KIND_BITS 2
+
+// the bottom 5 bits of the byte before each line are its length
+#define LINE_LENGTH_MASK 0x1F
+#define LINE_COMMENT 0x80
+
+// in a read dictionary entry, marks a mod rather than an op
+#define NAME_MOD 0x8000
+#define NAME_COUNT (E_OP__LENGTH + E_MOD__LENGTH)
+
+#define OP_WORDS ((E_OP__LENGTH + 31) / 32)
+#define MOD_WORDS ((E_MOD__LENGTH + 31) / 32)
+
+static const uint8_t magic[3] = { 'T', 'T', 'S' };
+
+static uint32_t zigzag(int32_t v) {
+    return v < 0 ? ((uint32_t)(-(v + 1)) << 1) | 1 : (uint32_t)v << 1;
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return v & 1 ? -(int32_t)(v >> 1) - 1 : (int32_t)(v >> 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// WRITE ///////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+    const scene_binary_writer_t *w;
+    size_t count;
+    bool counting;  // count the bytes, but don't write them
+    bool ok;
+} out_t;
+
+// the ops and mods used by the scene, in table order
+typedef struct {
+    uint32_t ops[OP_WORDS];
+    uint32_t mods[MOD_WORDS];
+    uint16_t op_count;
+    uint16_t mod_count;
+} dictionary_t;
+
+typedef struct {
+    scene_state_t *ss;
+    const char *text;
+    size_t text_lines;
+    size_t text_chars;
+    dictionary_t dictionary;
+} scene_t;
+
+typedef void (*section_fn_t)(out_t *o, const scene_t *s);
+
+static void put(out_t *o, uint8_t byte) {
+    o->count++;
+    if (!o->counting && o->ok) o->ok = o->w->put(o->w->context, byte);
+}
+
+static void put_varint(out_t *o, uint32_t v) {
+    while (v >= 0x80) {
+        put(o, (v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    put(o, v);
+}
+
+static void put_string(out_t *o, const char *s, size_t length) {
+    put(o, length);
+    for (size_t i = 0; i < length; i++) put(o, s[i]);
+}
+
+static uint8_t count_bits(uint32_t v) {
+    uint8_t count = 0;
+    for (; v; v &= v - 1) count++;
+    return count;
+}
+
+// the number of bits set before bit i
+static uint16_t rank(const uint32_t *bits, uint16_t i) {
+    uint16_t r = 0;
+    for (uint16_t w = 0; w < i / 32; w++) r += count_bits(bits[w]);
+    return r + count_bits(bits[i / 32] & ((1UL << (i % 32)) - 1));
+}
+
+static void build_dictionary(scene_t *s) {
+    dictionary_t *d = &s->dictionary;
+    memset(d, 0, sizeof(dictionary_t));
+
+    for (size_t script = 0; script < TEMP_SCRIPT; script++) {
+        for (size_t l = 0; l < ss_get_script_len(s->ss, script); l++) {
+            const tele_command_t *c = ss_get_script_command(s->ss, script, l);
+            for (uint8_t i = 0; i < c->length; i++) {
+                const int16_t value = command_value(c, i);
+                if (command_tag(c, i) == OP)
+                    d->ops[value / 32] |= 1UL << (value % 32);
+                else if (command_tag(c, i) == MOD)
+                    d->mods[value / 32] |= 1UL << (value % 32);
+            }
+        }
+    }
+
+    for (uint16_t w = 0; w < OP_WORDS; w++)
+        d->op_count += count_bits(d->ops[w]);
+    for (uint16_t w = 0; w < MOD_WORDS; w++)
+        d->mod_count += count_bits(d->mods[w]);
+}
+
+static void write_dictionary(out_t *o, const scene_t *s) {
+    const dictionary_t *d = &s->dictionary;
+
+    put_varint(o, d->op_count + d->mod_count);
+    for (uint16_t i = 0; i < E_OP__LENGTH; i++)
+        if (d->ops[i / 32] & (1UL << (i % 32)))
+            put_string(o, tele_ops[i]->name, strlen(tele_ops[i]->name));
+    for (uint16_t i = 0; i < E_MOD__LENGTH; i++)
+        if (d->mods[i / 32] & (1UL << (i % 32)))
+            put_string(o, tele_mods[i]->name, strlen(tele_mods[i]->name));
+}
+
+static void write_word(out_t *o, const scene_t *s, tele_word_t tag,
+                       int16_t value) {
+    const dictionary_t *d = &s->dictionary;
+    uint32_t kind = WORD_NUMBER, v = 0;
+
+    switch (tag) {
+        case NUMBER: v = zigzag(value); break;
+        case OP:
+            kind = WORD_NAME;
+            v = rank(d->ops, value);
+            break;
+        case MOD:
+            kind = WORD_NAME;
+            v = d->op_count + rank(d->mods, value);
+            break;
+        case PRE_SEP: kind = WORD_PRE_SEP; break;
+        case SUB_SEP: kind = WORD_SUB_SEP; break;
+    }
+
+    put_varint(o, v << WORD_KIND_BITS | kind);
+}
+
+static void write_scripts(out_t *o, const scene_t *s) {
+    put(o, TEMP_SCRIPT);
+    for (size_t script = 0; script < TEMP_SCRIPT; script++) {
+        const uint8_t length = ss_get_script_len(s->ss, script);
+        put(o, length);
+        for (size_t l = 0; l < length; l++) {
+            const tele_command_t *c = ss_get_script_command(s->ss, script, l);
+            const bool comment = ss_get_script_comment(s->ss, script, l);
+            put(o, c->length | (comment ? LINE_COMMENT : 0));
+            for (uint8_t i = 0; i < c->length; i++)
+                write_word(o, s, command_tag(c, i), command_value(c, i));
+        }
+    }
+}
+
+static void write_patterns(out_t *o, const scene_t *s) {
+    put(o, PATTERN_COUNT);
+    for (size_t p = 0; p < PATTERN_COUNT; p++) {
+        const scene_pattern_t *pattern = &ss_patterns_ptr(s->ss)[p];
+        put_varint(o, zigzag(pattern->idx));
+        put_varint(o, pattern->len);
+        put_varint(o, pattern->wrap);
+        put_varint(o, zigzag(pattern->start));
+        put_varint(o, zigzag(pattern->end));
+
+        // trailing zeros aren't stored
+        uint8_t count = PATTERN_LENGTH;
+        while (count && pattern->val[count - 1] == 0) count--;
+        put_varint(o, count);
+        for (uint8_t i = 0; i < count; i++)
+            put_varint(o, zigzag(pattern->val[i]));
+    }
+}
+
+static void write_text(out_t *o, const scene_t *s) {
+    // trailing blank lines aren't stored
+    size_t count = s->text_lines;
+    while (count && !s->text[(count - 1) * s->text_chars]) count--;
+    if (count > UINT8_MAX) count = UINT8_MAX;
+
+    put(o, count);
+    for (size_t l = 0; l < count; l++) {
+        const char *line = &s->text[l * s->text_chars];
+        size_t length = 0;
+        while (length < s->text_chars && length < UINT8_MAX && line[length])
+            length++;
+        put_string(o, line, length);
+    }
+}
+
+// sections are written twice, once to find their length for the header
+static void write_section(out_t *o, const scene_t *s, uint8_t id,
+                          section_fn_t fn) {
+    out_t counter = { .counting = true, .ok = true };
+    fn(&counter, s);
+    if (counter.count > UINT16_MAX) o->ok = false;
+
+    put(o, id);
+    put(o, counter.count & 0xFF);
+    put(o, counter.count >> 8);
+    fn(o, s);
+}
+
+scene_binary_result_t scene_binary_write(scene_state_t *ss, const char *text,
+                                         size_t text_lines, size_t text_chars,
+                                         const scene_binary_writer_t *w,
+                                         size_t *length) {
+    out_t o = { .w = w, .ok = true };
+    scene_t s = { .ss = ss,
+                  .text = text,
+                  .text_lines = text ? text_lines : 0,
+                  .text_chars = text_chars };
+    build_dictionary(&s);
+
+    for (size_t i = 0; i < sizeof(magic); i++) put(&o, magic[i]);
+    put(&o, SCENE_BINARY_VERSION);
+    // the sections that change least often go first, so that saving a scene
+    // again (see flash_write) moves as few bytes as possible
+    write_section(&o, &s, SCENE_BINARY_DICTIONARY, write_dictionary);
+    write_section(&o, &s, SCENE_BINARY_TEXT, write_text);
+    write_section(&o, &s, SCENE_BINARY_SCRIPTS, write_scripts);
+    write_section(&o, &s, SCENE_BINARY_PATTERNS, write_patterns);
+    put(&o, SCENE_BINARY_END);
+
+    if (length) *length = o.count;
+    return o.ok ? SCENE_BINARY_OK : SCENE_BINARY_FULL;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// READ ////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+    const scene_binary_reader_t *r;
+    size_t left;  // in the current section
+    scene_binary_result_t result;
+    // the dictionary, ops by index, mods by index | NAME_MOD
+    uint16_t names[NAME_COUNT];
+    uint16_t name_count;
+} in_t;
+
+static uint8_t get(in_t *in) {
+    uint8_t byte = 0;
+    if (in->result != SCENE_BINARY_OK) return 0;
+    if (in->left == 0)
+        in->result = SCENE_BINARY_CORRUPT;
+    else if (!in->r->get(in->r->context, &byte))
+        in->result = SCENE_BINARY_TRUNCATED;
+    else
+        in->left--;
+    return byte;
+}
+
+static uint32_t get_varint(in_t *in) {
+    uint32_t v = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7) {
+        const uint8_t byte = get(in);
+        v |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+    in->result = SCENE_BINARY_CORRUPT;
+    return 0;
+}
+
+static int16_t get_int16(in_t *in) {
+    const int32_t v = unzigzag(get_varint(in));
+    if (v < INT16_MIN || v > INT16_MAX) in->result = SCENE_BINARY_CORRUPT;
+    return v;
+}
+
+static void fail(in_t *in, scene_binary_result_t result) {
+    if (in->result == SCENE_BINARY_OK) in->result = result;
+}
+
+static void read_dictionary(in_t *in) {
+    const uint32_t count = get_varint(in);
+    if (count > NAME_COUNT) {
+        fail(in, SCENE_BINARY_CORRUPT);
+        return;
+    }
+
+    for (in->name_count = 0; in->name_count < count; in->name_count++) {
+        char name[32];
+        const uint8_t length = get(in);
+        if (length >= sizeof(name)) {
+            fail(in, SCENE_BINARY_CORRUPT);
+            return;
+        }
+        for (uint8_t i = 0; i < length; i++) name[i] = get(in);
+        name[length] = 0;
+        if (in->result != SCENE_BINARY_OK) return;
+
+        tele_data_t data;
+        if (!match_token(name, length, &data) ||
+            (data.tag != OP && data.tag != MOD)) {
+            fail(in, SCENE_BINARY_UNKNOWN_OP);
+            return;
+        }
+        in->names[in->name_count] =
+            data.value | (data.tag == MOD ? NAME_MOD : 0);
+    }
+}
+
+static void read_line(in_t *in, scene_state_t *ss, size_t script, size_t l) {
+    const uint8_t head = get(in);
+    tele_command_t c;
+    memset(&c, 0, sizeof(tele_command_t));
+    c.length = head & LINE_LENGTH_MASK;
+    c.separator = -1;
+    if (c.length > COMMAND_MAX_LENGTH) {
+        fail(in, SCENE_BINARY_CORRUPT);
+        return;
+    }
+
+    for (uint8_t i = 0; i < c.length; i++) {
+        const uint32_t word = get_varint(in);
+        const uint32_t v = word >> WORD_KIND_BITS;
+        switch (word & ((1 << WORD_KIND_BITS) - 1)) {
+            case WORD_NUMBER: {
+                const int32_t number = unzigzag(v);
+                if (number < INT16_MIN || number > INT16_MAX) {
+                    fail(in, SCENE_BINARY_CORRUPT);
+                    return;
+                }
+                command_set(&c, i, NUMBER, number);
+                break;
+            }
+            case WORD_NAME: {
+                if (v >= in->name_count) {
+                    fail(in, SCENE_BINARY_CORRUPT);
+                    return;
+                }
+                const uint16_t name = in->names[v];
+                command_set(&c, i, name & NAME_MOD ? MOD : OP,
+                            name & ~NAME_MOD);
+                break;
+            }
+            case WORD_PRE_SEP:
+                command_set(&c, i, PRE_SEP, 0);
+                if (c.separator == -1) c.separator = i;
+                break;
+            case WORD_SUB_SEP: command_set(&c, i, SUB_SEP, 0); break;
+        }
+    }
+    if (in->result != SCENE_BINARY_OK) return;
+
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    const bool valid = validate(&c, error_msg) == E_OK;
+
+    ss_overwrite_script_command(ss, script, l, &c);
+    if ((head & LINE_COMMENT) || !valid)
+        ss_toggle_script_comment(ss, script, l);
+}
+
+static void read_scripts(in_t *in, scene_state_t *ss) {
+    uint8_t count = get(in);
+    if (count > TEMP_SCRIPT) count = TEMP_SCRIPT;
+
+    for (size_t script = 0; script < count; script++) {
+        const uint8_t length = get(in);
+        if (length > SCRIPT_MAX_COMMANDS) {
+            fail(in, SCENE_BINARY_CORRUPT);
+            return;
+        }
+        for (size_t l = 0; l < length && in->result == SCENE_BINARY_OK; l++)
+            read_line(in, ss, script, l);
+    }
+}
+
+static int16_t clamp(int16_t v, int16_t min, int16_t max) {
+    return v < min ? min : v > max ? max : v;
+}
+
+static void read_patterns(in_t *in, scene_state_t *ss) {
+    uint8_t count = get(in);
+    if (count > PATTERN_COUNT) count = PATTERN_COUNT;
+
+    for (size_t p = 0; p < count; p++) {
+        scene_pattern_t *pattern = &ss_patterns_ptr(ss)[p];
+        pattern->idx = clamp(get_int16(in), 0, PATTERN_LENGTH - 1);
+        pattern->len = clamp(get_varint(in), 0, PATTERN_LENGTH);
+        pattern->wrap = get_varint(in) ? 1 : 0;
+        pattern->start = clamp(get_int16(in), 0, PATTERN_LENGTH - 1);
+        pattern->end = clamp(get_int16(in), 0, PATTERN_LENGTH - 1);
+
+        const uint32_t values = get_varint(in);
+        if (values > PATTERN_LENGTH) {
+            fail(in, SCENE_BINARY_CORRUPT);
+            return;
+        }
+        for (uint8_t i = 0; i < values; i++) pattern->val[i] = get_int16(in);
+    }
+}
+
+static void read_text(in_t *in, char *text, size_t text_lines,
+                      size_t text_chars) {
+    const uint8_t count = get(in);
+
+    for (size_t l = 0; l < count && in->result == SCENE_BINARY_OK; l++) {
+        const uint8_t length = get(in);
+        for (size_t i = 0; i < length; i++) {
+            const char c = get(in);
+            if (l < text_lines && i < text_chars - 1)
+                text[l * text_chars + i] = c;
+        }
+    }
+}
+
+scene_binary_result_t scene_binary_read(scene_state_t *ss, char *text,
+                                        size_t text_lines, size_t text_chars,
+                                        const scene_binary_reader_t *r) {
+    in_t in = { .r = r, .left = SIZE_MAX, .result = SCENE_BINARY_OK };
+
+    for (size_t i = 0; i < sizeof(magic); i++)
+        if (get(&in) != magic[i]) fail(&in, SCENE_BINARY_NOT_SCENE);
+    const uint8_t version = get(&in);
+    if (version > SCENE_BINARY_VERSION) fail(&in, SCENE_BINARY_NEWER);
+    if (in.result != SCENE_BINARY_OK) return in.result;
+
+    if (ss) {
+        for (size_t script = 0; script < TEMP_SCRIPT; script++)
+            ss_clear_script(ss, script);
+        ss_patterns_init(ss);
+    }
+    if (text) memset(text, 0, text_lines * text_chars);
+
+    while (in.result == SCENE_BINARY_OK) {
+        in.left = SIZE_MAX;
+        const uint8_t id = get(&in);
+        if (id == SCENE_BINARY_END) break;
+        const uint8_t low = get(&in);
+        in.left = low | get(&in) << 8;
+
+        switch (id) {
+            case SCENE_BINARY_DICTIONARY:
+                if (ss) read_dictionary(&in);
+                break;
+            case SCENE_BINARY_SCRIPTS:
+                if (ss) read_scripts(&in, ss);
+                break;
+            case SCENE_BINARY_PATTERNS:
+                if (ss) read_patterns(&in, ss);
+                break;
+            case SCENE_BINARY_TEXT:
+                if (text) read_text(&in, text, text_lines, text_chars);
+                break;
+        }
+
+        // skip whatever is left of the section
+        while (in.left && in.result == SCENE_BINARY_OK) get(&in);
+    }
+
+    return in.result;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// BUFFERS /////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+static bool buffer_put(void *context, uint8_t byte) {
+    scene_binary_buffer_t *b = context;
+    if (b->pos >= b->size) return false;
+    b->data[b->pos++] = byte;
+    return true;
+}
+
+static bool buffer_get(void *context, uint8_t *byte) {
+    scene_binary_buffer_t *b = context;
+    if (b->pos >= b->size) return false;
+    *byte = b->data[b->pos++];
+    return true;
+}
+
+scene_binary_writer_t scene_binary_buffer_writer(scene_binary_buffer_t *b) {
+    scene_binary_writer_t w = { .put = buffer_put, .context = b };
+    return w;
+}
+
+scene_binary_reader_t scene_binary_buffer_reader(scene_binary_buffer_t *b) {
+    scene_binary_reader_t r = { .get = buffer_get, .context = b };
+    return r;
+}
@@ -0,0 +1,88 @@
+#ifndef _SCENE_BINARY_H_
+#define _SCENE_BINARY_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "state.h"
+
+// A compact binary form of a scene (scripts, patterns and text), used to store
+// scenes in flash and to export them.
+//
+// Only the lines in use, and the pattern values up to the last non-zero one,
+// are stored, and every field is written byte by byte rather than as a struct,
+// so the format doesn't change when the structs do. A scene is:
+//
+//   'T' 'T' 'S' version
+//   sections, each: id (1 byte), length (2 bytes, little endian), payload
+//   SCENE_BINARY_END (1 byte)
+//
+// Sections a reader doesn't know are skipped, as are bytes at the end of a
+// section it does know, so new fields can be added without a new version.
+// Numbers are LEB128 varints, zigzag encoded if they are signed.
+//
+// Ops and mods are stored by name, once each in the dictionary section, and
+// referred to by their index in it, so that a scene still loads when ops are
+// added to (or moved in) the op table. A line that no longer validates (e.g.
+// an op has changed its number of params) is loaded commented out.
+
+#define SCENE_BINARY_VERSION 1
+
+typedef enum {
+    SCENE_BINARY_END = 0,
+    SCENE_BINARY_DICTIONARY = 1,
+    SCENE_BINARY_SCRIPTS = 2,
+    SCENE_BINARY_PATTERNS = 3,
+    SCENE_BINARY_TEXT = 4,
+} scene_binary_section_t;
+
+typedef enum {
+    SCENE_BINARY_OK,
+    SCENE_BINARY_FULL,        // the writer refused a byte
+    SCENE_BINARY_TRUNCATED,   // the reader ran out of bytes
+    SCENE_BINARY_NOT_SCENE,   // no header
+    SCENE_BINARY_NEWER,       // written by a later version
+    SCENE_BINARY_CORRUPT,     // a section doesn't make sense
+    SCENE_BINARY_UNKNOWN_OP,  // an op or mod in the dictionary doesn't exist
+} scene_binary_result_t;
+
+// scenes are streamed a byte at a time, so that they can go to and from flash
+// or a file without a buffer the size of a scene, put and get return false if
+// there is no more room, or no more bytes
+typedef struct {
+    bool (*put)(void *context, uint8_t byte);
+    void *context;
+} scene_binary_writer_t;
+
+typedef struct {
+    bool (*get)(void *context, uint8_t *byte);
+    void *context;
+} scene_binary_reader_t;
+
+// a writer or reader for a block of memory
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t pos;
+} scene_binary_buffer_t;
+
+scene_binary_writer_t scene_binary_buffer_writer(scene_binary_buffer_t *b);
+scene_binary_reader_t scene_binary_buffer_reader(scene_binary_buffer_t *b);
+
+// writes scripts 1-8, M and I, the patterns and text_lines lines of text
+// (each text_chars long), sets *length to the number of bytes written (which
+// may be NULL)
+scene_binary_result_t scene_binary_write(scene_state_t *ss, const char *text,
+                                         size_t text_lines, size_t text_chars,
+                                         const scene_binary_writer_t *w,
+                                         size_t *length);
+
+// replaces scripts 1-8, M and I and the patterns of ss, and the text, either
+// can be NULL to skip reading them, on error the scene and text are left
+// partly read
+scene_binary_result_t scene_binary_read(scene_state_t *ss, char *text,
+                                        size_t text_lines, size_t text_chars,
+                                        const scene_binary_reader_t *r);
+
+#endif
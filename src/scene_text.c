@@ -0,0 +1,372 @@
+#include "scene_text.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "command.h"
+#include "match_token.h"
+
+void scene_text_writer_init(scene_text_writer_t *w,
+                            bool (*write)(void *context, const uint8_t *data,
+                                          uint16_t length),
+                            void *context) {
+    w->write = write;
+    w->context = context;
+    w->used = 0;
+    w->ok = true;
+}
+
+bool scene_text_flush(scene_text_writer_t *w) {
+    // after a failed write the rest is thrown away
+    if (w->used && w->ok) w->ok = w->write(w->context, w->buffer, w->used);
+    w->used = 0;
+    return w->ok;
+}
+
+// words are printed straight into the buffer, past its end if need be, and
+// only whole buffers are written until the last
+static char *end(scene_text_writer_t *w) {
+    return (char *)&w->buffer[w->used];
+}
+
+static void commit(scene_text_writer_t *w, uint16_t length) {
+    w->used += length;
+    if (w->used < SCENE_TEXT_BUFFER_SIZE) return;
+
+    const uint16_t over = w->used - SCENE_TEXT_BUFFER_SIZE;
+    w->used = SCENE_TEXT_BUFFER_SIZE;
+    scene_text_flush(w);
+    memcpy(w->buffer, &w->buffer[SCENE_TEXT_BUFFER_SIZE], over);
+    w->used = over;
+}
+
+static void put(scene_text_writer_t *w, char c) {
+    *end(w) = c;
+    commit(w, 1);
+}
+
+// strings may be longer than the buffer, so they're split to fill it
+static void put_string(scene_text_writer_t *w, const char *s, size_t length) {
+    while (length) {
+        size_t n = SCENE_TEXT_BUFFER_SIZE - w->used;
+        if (n > length) n = length;
+        memcpy(end(w), s, n);
+        commit(w, n);
+        s += n;
+        length -= n;
+    }
+}
+
+static void put_number(scene_text_writer_t *w, int16_t value) {
+    commit(w, print_number(value, end(w)));
+}
+
+static void put_command(scene_text_writer_t *w, const tele_command_t *cmd) {
+    for (uint8_t i = 0; i < cmd->length; i++)
+        commit(w, print_word(cmd, i, end(w)));
+}
+
+// one row of the pattern header, or of pattern values
+static void put_row(scene_text_writer_t *w, const int16_t *values) {
+    for (uint8_t b = 0; b < PATTERN_COUNT; b++) {
+        put_number(w, values[b]);
+        put(w, b == PATTERN_COUNT - 1 ? '\n' : '\t');
+    }
+}
+
+bool scene_text_write(scene_text_writer_t *w, scene_state_t *ss,
+                      const char *text, size_t text_lines, size_t text_chars) {
+    bool blank = false;
+    for (size_t l = 0; l < text_lines; l++) {
+        const char *line = text + l * text_chars;
+        size_t length = 0;
+        while (length < text_chars && line[length]) length++;
+        if (length) {
+            put_string(w, line, length);
+            put(w, '\n');
+            blank = false;
+        }
+        else if (!blank) {
+            put(w, '\n');
+            blank = true;
+        }
+    }
+
+    for (uint8_t s = TT_SCRIPT_1; s <= INIT_SCRIPT; s++) {
+        put_string(w, "\n\n#", 3);
+        if (s == METRO_SCRIPT)
+            put(w, 'M');
+        else if (s == INIT_SCRIPT)
+            put(w, 'I');
+        else
+            put(w, '1' + s);
+
+        for (uint8_t l = 0; l < ss_get_script_len(ss, s); l++) {
+            put(w, '\n');
+            put_command(w, ss_get_script_command(ss, s, l));
+        }
+    }
+
+    put_string(w, "\n\n#P\n", 5);
+
+    int16_t row[PATTERN_COUNT];
+    for (uint8_t b = 0; b < PATTERN_COUNT; b++)
+        row[b] = ss_get_pattern_len(ss, b);
+    put_row(w, row);
+    for (uint8_t b = 0; b < PATTERN_COUNT; b++)
+        row[b] = ss_get_pattern_wrap(ss, b);
+    put_row(w, row);
+    for (uint8_t b = 0; b < PATTERN_COUNT; b++)
+        row[b] = ss_get_pattern_start(ss, b);
+    put_row(w, row);
+    for (uint8_t b = 0; b < PATTERN_COUNT; b++)
+        row[b] = ss_get_pattern_end(ss, b);
+    put_row(w, row);
+
+    put(w, '\n');
+
+    for (uint8_t i = 0; i < PATTERN_LENGTH; i++) {
+        for (uint8_t b = 0; b < PATTERN_COUNT; b++)
+            row[b] = ss_get_pattern_val(ss, b, i);
+        put_row(w, row);
+    }
+
+    return scene_text_flush(w);
+}
+
+static bool binary_put(void *context, uint8_t byte) {
+    scene_text_writer_t *w = context;
+    put(w, byte);
+    return w->ok;
+}
+
+scene_binary_writer_t scene_text_binary_writer(scene_text_writer_t *w) {
+    scene_binary_writer_t writer = { .put = binary_put, .context = w };
+    return writer;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// READ ////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// sections other than the scripts
+enum { SECTION_TEXT = -1, SECTION_PATTERNS = -2, SECTION_DONE = -3 };
+
+static void report(scene_text_reader_t *r, error_t status,
+                   const char *message) {
+    r->errors++;
+    if (r->error) r->error(r->context, r->file_line, status, message);
+}
+
+static void start_command(scene_text_reader_t *r) {
+    memset(&r->command, 0, sizeof(r->command));
+    r->command.separator = -1;
+    r->status = E_OK;
+    r->error_msg[0] = 0;
+    r->token_length = 0;
+    r->separator = 0;
+}
+
+void scene_text_reader_init(scene_text_reader_t *r, scene_state_t *ss,
+                            char *text, size_t text_lines, size_t text_chars,
+                            scene_text_error_t error, void *context) {
+    memset(r, 0, sizeof(scene_text_reader_t));
+    r->ss = ss;
+    r->text = text;
+    r->text_lines = text ? text_lines : 0;
+    r->text_chars = text_chars;
+    r->error = error;
+    r->context = context;
+    r->file_line = 1;
+    r->section = SECTION_TEXT;
+    if (text) memset(text, 0, text_lines * text_chars);
+    start_command(r);
+}
+
+static void add_word(scene_text_reader_t *r, tele_word_t tag, int16_t value) {
+    tele_command_t *c = &r->command;
+    if (tag == PRE_SEP) c->separator = c->length;
+    command_set(c, c->length, tag, value);
+    if (++c->length >= COMMAND_MAX_LENGTH) r->status = E_LENGTH;
+}
+
+static void end_token(scene_text_reader_t *r) {
+    if (r->token_length == 0 || r->status != E_OK) return;
+
+    tele_data_t data;
+    r->token[r->token_length] = 0;
+    if (match_token(r->token, r->token_length, &data)) {
+        add_word(r, data.tag, data.value);
+    }
+    else {
+        uint8_t n = r->token_length;
+        if (n > TELE_ERROR_MSG_LENGTH - 1) n = TELE_ERROR_MSG_LENGTH - 1;
+        memcpy(r->error_msg, r->token, n);
+        r->error_msg[n] = 0;
+        r->status = E_PARSE;
+    }
+    r->token_length = 0;
+}
+
+static void read_command_char(scene_text_reader_t *r, char c) {
+    if (r->status != E_OK) return;
+
+    // ':' and ';' must be followed by a space
+    if (r->separator) {
+        const char separator = r->separator;
+        r->separator = 0;
+        if (c == ' ')
+            add_word(r, separator == ':' ? PRE_SEP : SUB_SEP, 0);
+        else
+            r->status = separator == ':' ? E_NEED_SPACE_PRE_SEP
+                                         : E_NEED_SPACE_SUB_SEP;
+    }
+    else if (c == ' ' || c == '\t') {
+        end_token(r);
+    }
+    else if (c == ':' || c == ';') {
+        end_token(r);
+        r->separator = c;
+    }
+    else if (r->token_length < SCENE_TEXT_TOKEN_MAX) {
+        r->token[r->token_length++] = c;
+    }
+}
+
+static void end_command(scene_text_reader_t *r) {
+    end_token(r);
+    if (r->status == E_OK && r->separator)
+        r->status = r->separator == ':' ? E_NEED_SPACE_PRE_SEP
+                                        : E_NEED_SPACE_SUB_SEP;
+    if (r->status == E_OK) r->status = validate(&r->command, r->error_msg);
+
+    if (r->status == E_OK) {
+        if (r->ss)
+            ss_overwrite_script_command(r->ss, r->section, r->line,
+                                        &r->command);
+        r->line++;
+    }
+    else {
+        report(r, r->status, r->error_msg);
+    }
+    start_command(r);
+}
+
+static void start_section(scene_text_reader_t *r, char c) {
+    if (c == 'M')
+        r->section = METRO_SCRIPT;
+    else if (c == 'I')
+        r->section = INIT_SCRIPT;
+    else if (c == 'P')
+        r->section = SECTION_PATTERNS;
+    else if (c >= '1' && c <= '8')
+        r->section = TT_SCRIPT_1 + c - '1';
+    else {
+        const char message[3] = { '#', c == '\n' ? 0 : c, 0 };
+        report(r, E_PARSE, message);
+        r->section = SECTION_DONE;
+    }
+    r->line = 0;
+    r->pattern = 0;
+    r->number = 0;
+    r->negative = false;
+}
+
+// rows of the length, wrap, start and end of each pattern, then of values
+static void end_pattern_value(scene_text_reader_t *r) {
+    scene_state_t *ss = r->ss;
+    const uint8_t b = r->pattern;
+    const int16_t value = r->negative ? -r->number : r->number;
+
+    if (ss && b < PATTERN_COUNT) {
+        if (r->line >= 4)
+            ss_set_pattern_val(ss, b, r->line - 4, value);
+        else if (r->line == 0)
+            ss_set_pattern_len(ss, b, value);
+        else if (r->line == 1)
+            ss_set_pattern_wrap(ss, b, value);
+        else if (r->line == 2)
+            ss_set_pattern_start(ss, b, value);
+        else
+            ss_set_pattern_end(ss, b, value);
+    }
+    r->pattern++;
+    r->number = 0;
+    r->negative = false;
+}
+
+static void read_char(scene_text_reader_t *r, char c) {
+    if (c == '\r' || r->section == SECTION_DONE) return;
+    c = toupper(c);
+
+    if (r->chars == 0 && c == '#') {
+        r->header = true;
+        r->chars++;
+        return;
+    }
+    if (r->header) {
+        if (r->chars++ == 1) start_section(r, c);
+        if (c == '\n') {
+            r->header = false;
+            r->chars = 0;
+            r->file_line++;
+        }
+        return;
+    }
+
+    if (r->section == SECTION_TEXT) {
+        if (c == '\n') {
+            r->line++;
+            r->chars = 0;
+        }
+        else if (r->line < r->text_lines && r->chars < r->text_chars) {
+            r->text[r->line * r->text_chars + r->chars++] = c;
+        }
+    }
+    else if (r->section == SECTION_PATTERNS) {
+        if (c == '\n') {
+            if (r->chars) {
+                end_pattern_value(r);
+                r->line++;
+            }
+            if (r->line >= PATTERN_LENGTH + 4) r->section = SECTION_DONE;
+            r->pattern = 0;
+            r->chars = 0;
+        }
+        else if (c == '\t') {
+            end_pattern_value(r);
+        }
+        else {
+            if (c == '-')
+                r->negative = true;
+            else if (c >= '0' && c <= '9')
+                r->number = r->number * 10 + c - '0';
+            r->chars++;
+        }
+    }
+    else {
+        // a script, lines past the end of it are ignored
+        if (c == '\n') {
+            if (r->chars && r->line < SCRIPT_MAX_COMMANDS) end_command(r);
+            start_command(r);
+            r->chars = 0;
+        }
+        else {
+            if (r->line < SCRIPT_MAX_COMMANDS) read_command_char(r, c);
+            if (r->chars < UINT8_MAX) r->chars++;
+        }
+    }
+
+    if (c == '\n') r->file_line++;
+}
+
+void scene_text_read(scene_text_reader_t *r, const uint8_t *data,
+                     size_t length) {
+    for (size_t i = 0; i < length; i++) read_char(r, data[i]);
+}
+
+uint16_t scene_text_read_end(scene_text_reader_t *r) {
+    if (r->chars) read_char(r, '\n');
+    return r->errors;
+}
@@ -0,0 +1,108 @@
+#ifndef _SCENE_TEXT_H_
+#define _SCENE_TEXT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "command.h"
+#include "scene_binary.h"
+#include "state.h"
+#include "teletype.h"
+
+// A scene as text, in the format of the ttNNs.txt files on a USB stick:
+//
+//   the scene text, with runs of blank lines printed as one blank line
+//   #1 to #8, #M and #I, each followed by its lines
+//   #P, then the length, wrap, start and end of each pattern (tab separated,
+//   a row each) and a blank line, then the 64 values of each pattern, a row
+//   for each index
+//
+// The scene is rendered into a buffer that is handed to write whenever it's
+// full, so that the file is written in whole blocks rather than a few bytes
+// at a time. A size of one FAT sector means that every write but the last is
+// a whole sector.
+
+#define SCENE_TEXT_BUFFER_SIZE 512
+
+typedef struct {
+    // returns false if the data couldn't all be written
+    bool (*write)(void *context, const uint8_t *data, uint16_t length);
+    void *context;
+    // with room for a word to run over the end
+    uint8_t buffer[SCENE_TEXT_BUFFER_SIZE + WORD_PRINT_MAX];
+    uint16_t used;
+    bool ok;
+} scene_text_writer_t;
+
+void scene_text_writer_init(scene_text_writer_t *w,
+                            bool (*write)(void *context, const uint8_t *data,
+                                          uint16_t length),
+                            void *context);
+
+// writes what's left in the buffer, returns false if any write has failed
+// since the writer was initialised
+bool scene_text_flush(scene_text_writer_t *w);
+
+// writes scripts 1-8, M and I, the patterns and text_lines lines of text
+// (each text_chars long), and flushes
+bool scene_text_write(scene_text_writer_t *w, scene_state_t *ss,
+                      const char *text, size_t text_lines, size_t text_chars);
+
+// the buffer can also be used for a scene_binary stream, which needs flushing
+// once it's written
+scene_binary_writer_t scene_text_binary_writer(scene_text_writer_t *w);
+
+
+// The reader takes the file in chunks of any size, a byte at a time, so
+// nothing bigger than a token is buffered. Words are matched as each one
+// ends, following the rules of scanner.rl, and a line is validated and stored
+// when its newline arrives. A line that doesn't parse or validate is reported
+// with its line number in the file (from 1) and skipped, as the module always
+// has. A '#' starts a section only at the start of a line.
+
+#define SCENE_TEXT_TOKEN_MAX 32
+
+typedef void (*scene_text_error_t)(void *context, uint16_t line,
+                                   error_t status, const char *message);
+
+typedef struct {
+    scene_state_t *ss;
+    char *text;
+    size_t text_lines;
+    size_t text_chars;
+    scene_text_error_t error;
+    void *context;
+    uint16_t errors;
+
+    uint16_t file_line;
+    int8_t section;  // a script number, or one of the sections in scene_text.c
+    uint8_t line;    // in the section
+    uint8_t chars;   // on the line so far
+    bool header;     // the line is a section header
+
+    // the command being read
+    tele_command_t command;
+    error_t status;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    char token[SCENE_TEXT_TOKEN_MAX + 1];  // terminated for match_token
+    uint8_t token_length;
+    char separator;  // a ':' or ';' that needs a space after it
+
+    // the pattern value being read
+    uint8_t pattern;
+    uint16_t number;
+    bool negative;
+} scene_text_reader_t;
+
+// ss and text may be NULL to only check the file, text is cleared, error is
+// called for each line that can't be read (and may be NULL)
+void scene_text_reader_init(scene_text_reader_t *r, scene_state_t *ss,
+                            char *text, size_t text_lines, size_t text_chars,
+                            scene_text_error_t error, void *context);
+void scene_text_read(scene_text_reader_t *r, const uint8_t *data,
+                     size_t length);
+// finishes a last line without a newline, returns the number of errors
+uint16_t scene_text_read_end(scene_text_reader_t *r);
+
+#endif
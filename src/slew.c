@@ -0,0 +1,76 @@
+#include "slew.h"
+
+#include "slew_tables.h"
+
+#define PHASE_BITS 24
+#define PHASE_ONE ((uint32_t)1 << PHASE_BITS)
+
+void slew_init(slew_t *s) {
+    s->now = 0;
+    s->from = 0;
+    s->target = 0;
+    s->off = 0;
+    s->steps = 1;
+    s->step = 0;
+    s->shape = SLEW_LINEAR;
+    s->curve = SLEW_LINEAR;
+    s->phase = 0;
+    s->phase_step = 0;
+}
+
+void slew_set(slew_t *s, int16_t value, bool slewed) {
+    int32_t t = (int32_t)value + s->off;
+    if (t < 0)
+        t = 0;
+    else if (t > 16383)
+        t = 16383;
+
+    // a jump still takes a step to reach the DAC
+    if (!slewed) s->now = t;
+    s->from = s->now;
+    s->target = t;
+    s->curve = s->shape;
+    s->step = slewed ? s->steps : 1;
+    s->phase = 0;
+    s->phase_step = PHASE_ONE / s->step;
+}
+
+void slew_set_time(slew_t *s, int16_t ms) {
+    s->steps = ms > 0 ? ms / SLEW_RATE : 0;
+    if (s->steps == 0) s->steps = 1;
+}
+
+void slew_set_off(slew_t *s, int16_t off) {
+    s->off = off;
+}
+
+void slew_set_shape(slew_t *s, uint8_t shape) {
+    s->shape = shape < SLEW_SHAPE_COUNT ? shape : SLEW_LINEAR;
+}
+
+void slew_stop(slew_t *s) {
+    s->step = s->step ? 1 : 0;
+}
+
+uint32_t slew_curve(uint8_t shape, uint32_t phase) {
+    if (phase >= 1 << 16) return 1 << 16;
+    const uint8_t shift = 16 - SLEW_TABLE_BITS;
+    const uint8_t i = phase >> shift;
+    const uint32_t frac = phase & ((1 << shift) - 1);
+    return slew_table[shape][i] + ((slew_delta[shape][i] * frac) >> shift);
+}
+
+bool slew_step(slew_t *s) {
+    if (s->step == 0) return false;
+
+    if (--s->step == 0) {
+        s->now = s->target;
+        return false;
+    }
+
+    s->phase += s->phase_step;
+    const uint32_t y = slew_curve(s->curve, s->phase >> (PHASE_BITS - 16));
+    const int32_t distance = (int32_t)s->target - s->from;
+    s->now = s->from + ((distance * (int32_t)y) >> 16);
+    return true;
+}
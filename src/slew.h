@@ -0,0 +1,59 @@
+#ifndef _SLEW_H_
+#define _SLEW_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The slew of a CV output, as the module runs it from its CV timer, kept here
+// so that the simulator can render exactly the same steps.
+//
+// Each step moves the output along a curve from where it was to its target,
+// the curve's shape is read from a table of SLEW_TABLE_BITS segments (see
+// utils/slew_tables.py) with the position in each segment interpolated, using
+// a table of the differences between entries so that a step costs a couple
+// of multiplies whatever the shape.
+
+// ms between steps
+#define SLEW_RATE 6
+#define SLEW_TABLE_BITS 6
+
+// the order of the tables in slew_tables.h
+typedef enum {
+    SLEW_LINEAR,
+    SLEW_EXPONENTIAL,
+    SLEW_LOGARITHMIC,
+    SLEW_S_CURVE,
+    SLEW_SHAPE_COUNT
+} slew_shape_t;
+
+typedef struct {
+    uint16_t now;     // the output, 0-16383
+    uint16_t from;    // where the slew started
+    uint16_t target;  // with the offset added
+    int16_t off;
+    uint16_t steps;  // steps a slew takes
+    uint16_t step;   // steps left, 0 if the output is at its target
+    uint8_t shape;   // for the next slew
+    uint8_t curve;   // of the slew in progress
+    uint32_t phase;  // how far through the slew, 0 to 1 << 24
+    uint32_t phase_step;
+} slew_t;
+
+void slew_init(slew_t *s);
+
+// as tele_cv, tele_cv_slew and tele_cv_off
+void slew_set(slew_t *s, int16_t value, bool slewed);
+void slew_set_time(slew_t *s, int16_t ms);
+void slew_set_off(slew_t *s, int16_t off);
+void slew_set_shape(slew_t *s, uint8_t shape);
+
+// stops a slew where it is, it reaches its target on the next step
+void slew_stop(slew_t *s);
+
+// moves the output on by a step, returns true if it's still slewing
+bool slew_step(slew_t *s);
+
+// how far along the curve of a shape phase is, both from 0 to 1 << 16
+uint32_t slew_curve(uint8_t shape, uint32_t phase);
+
+#endif
@@ -0,0 +1,106 @@
+// clang-format off
+
+#ifndef _SLEW_TABLES_H_
+#define _SLEW_TABLES_H_
+
+// This file has been autogenerated by 'utils/slew_tables.py'
+
+static const uint16_t slew_table[][65] = {
+    // linear
+    {
+            0,  1024,  2048,  3072,  4096,  5120,  6144,  7168,
+         8192,  9216, 10240, 11264, 12288, 13312, 14336, 15360,
+        16384, 17408, 18432, 19456, 20480, 21504, 22528, 23552,
+        24576, 25600, 26624, 27648, 28672, 29696, 30720, 31744,
+        32768, 33791, 34815, 35839, 36863, 37887, 38911, 39935,
+        40959, 41983, 43007, 44031, 45055, 46079, 47103, 48127,
+        49151, 50175, 51199, 52223, 53247, 54271, 55295, 56319,
+        57343, 58367, 59391, 60415, 61439, 62463, 63487, 64511,
+        65535,
+    },
+    // exponential
+    {
+            0,    79,   163,   252,   347,   449,   556,   671,
+          793,   923,  1062,  1209,  1366,  1533,  1710,  1900,
+         2101,  2315,  2544,  2786,  3045,  3320,  3613,  3925,
+         4257,  4611,  4987,  5387,  5814,  6267,  6750,  7265,
+         7812,  8395,  9015,  9675, 10378, 11126, 11923, 12770,
+        13673, 14634, 15656, 16745, 17904, 19137, 20450, 21848,
+        23336, 24920, 26606, 28401, 30311, 32345, 34510, 36815,
+        39268, 41879, 44659, 47618, 50768, 54121, 57691, 61490,
+        65535,
+    },
+    // logarithmic
+    {
+            0,  4045,  7844, 11414, 14767, 17917, 20876, 23656,
+        26267, 28720, 31025, 33190, 35224, 37134, 38929, 40615,
+        42199, 43687, 45085, 46398, 47631, 48790, 49879, 50901,
+        51862, 52765, 53612, 54409, 55157, 55860, 56520, 57140,
+        57723, 58270, 58785, 59268, 59721, 60148, 60548, 60924,
+        61278, 61610, 61922, 62215, 62490, 62749, 62991, 63220,
+        63434, 63635, 63825, 64002, 64169, 64326, 64473, 64612,
+        64742, 64864, 64979, 65086, 65188, 65283, 65372, 65456,
+        65535,
+    },
+    // s-curve
+    {
+            0,    39,   158,   355,   630,   982,  1411,  1915,
+         2494,  3146,  3869,  4662,  5522,  6448,  7438,  8488,
+         9597, 10762, 11980, 13248, 14563, 15922, 17321, 18758,
+        20228, 21728, 23256, 24806, 26375, 27960, 29556, 31160,
+        32767, 34375, 35979, 37575, 39160, 40729, 42279, 43807,
+        45307, 46777, 48214, 49613, 50972, 52287, 53555, 54773,
+        55938, 57047, 58097, 59087, 60013, 60873, 61666, 62389,
+        63041, 63620, 64124, 64553, 64905, 65180, 65377, 65496,
+        65535,
+    },
+};
+
+static const uint16_t slew_delta[][64] = {
+    // linear
+    {
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1023,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+         1024,  1024,  1024,  1024,  1024,  1024,  1024,  1024,
+    },
+    // exponential
+    {
+           79,    84,    89,    95,   102,   107,   115,   122,
+          130,   139,   147,   157,   167,   177,   190,   201,
+          214,   229,   242,   259,   275,   293,   312,   332,
+          354,   376,   400,   427,   453,   483,   515,   547,
+          583,   620,   660,   703,   748,   797,   847,   903,
+          961,  1022,  1089,  1159,  1233,  1313,  1398,  1488,
+         1584,  1686,  1795,  1910,  2034,  2165,  2305,  2453,
+         2611,  2780,  2959,  3150,  3353,  3570,  3799,  4045,
+    },
+    // logarithmic
+    {
+         4045,  3799,  3570,  3353,  3150,  2959,  2780,  2611,
+         2453,  2305,  2165,  2034,  1910,  1795,  1686,  1584,
+         1488,  1398,  1313,  1233,  1159,  1089,  1022,   961,
+          903,   847,   797,   748,   703,   660,   620,   583,
+          547,   515,   483,   453,   427,   400,   376,   354,
+          332,   312,   293,   275,   259,   242,   229,   214,
+          201,   190,   177,   167,   157,   147,   139,   130,
+          122,   115,   107,   102,    95,    89,    84,    79,
+    },
+    // s-curve
+    {
+           39,   119,   197,   275,   352,   429,   504,   579,
+          652,   723,   793,   860,   926,   990,  1050,  1109,
+         1165,  1218,  1268,  1315,  1359,  1399,  1437,  1470,
+         1500,  1528,  1550,  1569,  1585,  1596,  1604,  1607,
+         1608,  1604,  1596,  1585,  1569,  1550,  1528,  1500,
+         1470,  1437,  1399,  1359,  1315,  1268,  1218,  1165,
+         1109,  1050,   990,   926,   860,   793,   723,   652,
+          579,   504,   429,   352,   275,   197,   119,    39,
+    },
+};
+
+#endif
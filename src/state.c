@@ -2,6 +2,7 @@
 
 #include <string.h>
 
+#include "teletype.h"
 #include "teletype_io.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -11,11 +12,25 @@ void ss_init(scene_state_t *ss) {
     ss->initializing = true;
     ss_variables_init(ss);
     ss_patterns_init(ss);
-    ss->delay.count = 0;
+    ss->delay.now = 0;
+    ss->delay.next_order = 0;
+    ss->delay.dropped = 0;
+    ss->delay.running = DELAY_SIZE;
+    ss_delay_clear(ss);
     for (size_t i = 0; i < TR_COUNT; i++) { ss->tr_pulse_timer[i] = 0; }
     ss->stack_op.top = 0;
+    memset(&ss->resume, 0, sizeof(ss->resume));
+    ss_stats_clear(ss);
     memset(&ss->scripts, 0, ss_scripts_size());
+    memset(&ss->compiled, 0, sizeof(ss->compiled));
     turtle_init(&ss->turtle);
+    chaos_init(&ss->chaos);
+    ii_queue_init(&ss->ii, ii_default_devices, ii_default_device_count);
+    ii_poll_init(&ss->ii_poll);
+    cv_out_init(&ss->cv_out);
+    ss_rand_seed(ss, 1);
+    ss_clear_dirty(ss, -1);
+    ss_set_dirty(ss, SS_DIRTY_ALL);
 }
 
 void ss_variables_init(scene_state_t *ss) {
@@ -35,7 +50,6 @@ void ss_variables_init(scene_state_t *ss) {
         .o_min = 0,
         .o_max = 63,
         .o_wrap = 1,
-        .q_n = 1,
         .r_min = 0,
         .r_max = 16383,
         .time_act = 1,
@@ -46,6 +60,7 @@ void ss_variables_init(scene_state_t *ss) {
     };
 
     memcpy(&ss->variables, &default_variables, sizeof(default_variables));
+    queue_init(&ss->variables.q);
     ss_update_param_scale(ss);
     ss_update_in_scale(ss);
 }
@@ -64,6 +79,26 @@ void ss_pattern_init(scene_state_t *ss, size_t pattern_no) {
     p->start = 0;
     p->end = 63;
     for (size_t i = 0; i < PATTERN_LENGTH; i++) { p->val[i] = 0; }
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern_no));
+}
+
+// dirty sections
+
+void ss_set_dirty(scene_state_t *ss, uint32_t sections) {
+    ss->dirty.sections |= sections;
+}
+
+uint32_t ss_get_dirty(scene_state_t *ss) {
+    return ss->dirty.sections;
+}
+
+int16_t ss_get_dirty_slot(scene_state_t *ss) {
+    return ss->dirty.slot;
+}
+
+void ss_clear_dirty(scene_state_t *ss, int16_t slot) {
+    ss->dirty.sections = 0;
+    ss->dirty.slot = slot;
 }
 
 // Hardware
@@ -99,6 +134,7 @@ int16_t ss_get_pattern_idx(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_idx(scene_state_t *ss, size_t pattern, int16_t i) {
     ss->patterns[pattern].idx = i;
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern));
 }
 
 int16_t ss_get_pattern_len(scene_state_t *ss, size_t pattern) {
@@ -107,6 +143,7 @@ int16_t ss_get_pattern_len(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_len(scene_state_t *ss, size_t pattern, int16_t l) {
     ss->patterns[pattern].len = l;
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern));
 }
 
 uint16_t ss_get_pattern_wrap(scene_state_t *ss, size_t pattern) {
@@ -115,6 +152,7 @@ uint16_t ss_get_pattern_wrap(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_wrap(scene_state_t *ss, size_t pattern, uint16_t wrap) {
     ss->patterns[pattern].wrap = wrap;
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern));
 }
 
 int16_t ss_get_pattern_start(scene_state_t *ss, size_t pattern) {
@@ -123,6 +161,7 @@ int16_t ss_get_pattern_start(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_start(scene_state_t *ss, size_t pattern, int16_t start) {
     ss->patterns[pattern].start = start;
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern));
 }
 
 int16_t ss_get_pattern_end(scene_state_t *ss, size_t pattern) {
@@ -131,6 +170,7 @@ int16_t ss_get_pattern_end(scene_state_t *ss, size_t pattern) {
 
 void ss_set_pattern_end(scene_state_t *ss, size_t pattern, int16_t end) {
     ss->patterns[pattern].end = end;
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern));
 }
 
 int16_t ss_get_pattern_val(scene_state_t *ss, size_t pattern, size_t idx) {
@@ -140,6 +180,7 @@ int16_t ss_get_pattern_val(scene_state_t *ss, size_t pattern, size_t idx) {
 void ss_set_pattern_val(scene_state_t *ss, size_t pattern, size_t idx,
                         int16_t val) {
     ss->patterns[pattern].val[idx] = val;
+    ss_set_dirty(ss, SS_DIRTY_PATTERN(pattern));
 }
 
 scene_pattern_t *ss_patterns_ptr(scene_state_t *ss) {
@@ -150,6 +191,140 @@ size_t ss_patterns_size() {
     return sizeof(scene_pattern_t) * PATTERN_COUNT;
 }
 
+// delays
+
+// is slot a due to run before slot b?
+static bool ss_delay_before(scene_delay_t *d, uint8_t a, uint8_t b) {
+    // use signed differences so that wrapping of now is handled
+    int32_t due = (int32_t)(d->due[a] - d->due[b]);
+    if (due != 0) return due < 0;
+    return (int32_t)(d->order[a] - d->order[b]) < 0;
+}
+
+void ss_delay_clear(scene_state_t *ss) {
+    scene_delay_t *d = &ss->delay;
+    d->count = 0;
+    d->free_count = 0;
+    // a delay that is running still owns its slot, it's released after
+    for (int16_t i = DELAY_SIZE - 1; i >= 0; i--)
+        if (i != d->running) d->free[d->free_count++] = i;
+}
+
+bool ss_delay_add(scene_state_t *ss, int16_t time, const tele_command_t *cmd,
+                  uint8_t origin_script, int16_t origin_i) {
+    scene_delay_t *d = &ss->delay;
+    if (d->free_count == 0) {
+        if (d->dropped < UINT16_MAX) d->dropped++;
+        return false;
+    }
+
+    const uint8_t slot = d->free[--d->free_count];
+    d->due[slot] = d->now + time;
+    d->order[slot] = d->next_order++;
+    d->origin_script[slot] = origin_script;
+    d->origin_i[slot] = origin_i;
+    copy_command(&d->commands[slot], cmd);
+
+    // sift up
+    uint8_t i = d->count++;
+    while (i > 0) {
+        uint8_t parent = (i - 1) / 2;
+        if (!ss_delay_before(d, slot, d->heap[parent])) break;
+        d->heap[i] = d->heap[parent];
+        i = parent;
+    }
+    d->heap[i] = slot;
+
+    return true;
+}
+
+void ss_delay_advance(scene_state_t *ss, uint16_t time) {
+    ss->delay.now += time;
+}
+
+// returns the time until the next delay is due (0 if it's overdue), or -1 if
+// there are no delays
+int32_t ss_delay_next_due(scene_state_t *ss) {
+    scene_delay_t *d = &ss->delay;
+    if (d->count == 0) return -1;
+    int32_t due = (int32_t)(d->due[d->heap[0]] - d->now);
+    return due > 0 ? due : 0;
+}
+
+// returns the slot of the next delay that is due, removing it from the heap,
+// or -1 if there isn't one. The slot must be given back with ss_delay_release
+// once it has been run.
+int16_t ss_delay_pop_due(scene_state_t *ss) {
+    scene_delay_t *d = &ss->delay;
+    if (d->count == 0) return -1;
+
+    const uint8_t slot = d->heap[0];
+    if ((int32_t)(d->due[slot] - d->now) > 0) return -1;
+
+    // sift down the last entry from the top
+    const uint8_t last = d->heap[--d->count];
+    uint8_t i = 0;
+    while (true) {
+        uint16_t child = 2 * i + 1;
+        if (child >= d->count) break;
+        if (child + 1 < d->count &&
+            ss_delay_before(d, d->heap[child + 1], d->heap[child]))
+            child++;
+        if (!ss_delay_before(d, d->heap[child], last)) break;
+        d->heap[i] = d->heap[child];
+        i = child;
+    }
+    d->heap[i] = last;
+
+    d->running = slot;
+    return slot;
+}
+
+void ss_delay_release(scene_state_t *ss, uint8_t slot) {
+    scene_delay_t *d = &ss->delay;
+    // if the command reset the scene (INIT, INIT.SCENE) the slot has already
+    // been freed along with the rest
+    if (d->running != slot) return;
+    d->running = DELAY_SIZE;
+    d->free[d->free_count++] = slot;
+}
+
+uint16_t ss_delay_dropped(scene_state_t *ss) {
+    return ss->delay.dropped;
+}
+
+// script budgets
+
+uint16_t ss_get_script_budget(scene_state_t *ss, script_number_t idx) {
+    return ss->resume.budget[idx];
+}
+
+void ss_set_script_budget(scene_state_t *ss, script_number_t idx,
+                          uint16_t budget) {
+    ss->resume.budget[idx] = budget;
+}
+
+bool ss_get_script_abort(scene_state_t *ss, script_number_t idx) {
+    return ss->resume.abort[idx];
+}
+
+void ss_set_script_abort(scene_state_t *ss, script_number_t idx, bool abort) {
+    ss->resume.abort[idx] = abort;
+}
+
+void ss_resume_clear(scene_state_t *ss) {
+    ss->resume.pending = 0;
+}
+
+const scene_script_stats_t *ss_get_script_stats(scene_state_t *ss,
+                                                script_number_t idx) {
+    return &ss->stats[idx];
+}
+
+void ss_stats_clear(scene_state_t *ss) {
+    memset(&ss->stats, 0, sizeof(ss->stats));
+}
+
 // script manipulation
 
 uint8_t ss_get_script_len(scene_state_t *ss, script_number_t idx) {
@@ -160,6 +335,7 @@ uint8_t ss_get_script_len(scene_state_t *ss, script_number_t idx) {
 static void ss_set_script_len(scene_state_t *ss, script_number_t idx,
                               uint8_t l) {
     ss->scripts[idx].l = l;
+    ss_set_dirty(ss, SS_DIRTY_SCRIPT(idx));
 }
 
 const tele_command_t *ss_get_script_command(scene_state_t *ss,
@@ -168,10 +344,17 @@ const tele_command_t *ss_get_script_command(scene_state_t *ss,
     return &ss->scripts[script_idx].c[c_idx];
 }
 
+const tele_compiled_command_t *ss_get_compiled_command(
+    scene_state_t *ss, script_number_t script_idx, size_t c_idx) {
+    return &ss->compiled[script_idx][c_idx];
+}
+
 // private
 static void ss_set_script_command(scene_state_t *ss, script_number_t script_idx,
                                   size_t c_idx, const tele_command_t *cmd) {
     memcpy(&ss->scripts[script_idx].c[c_idx], cmd, sizeof(tele_command_t));
+    compile_command(cmd, &ss->compiled[script_idx][c_idx]);
+    ss_set_dirty(ss, SS_DIRTY_SCRIPT(script_idx));
 }
 
 bool ss_get_script_comment(scene_state_t *ss, script_number_t script_idx,
@@ -183,6 +366,7 @@ void ss_toggle_script_comment(scene_state_t *ss, script_number_t script_idx,
                               size_t c_idx) {
     ss->scripts[script_idx].comment[c_idx] =
         !ss->scripts[script_idx].comment[c_idx];
+    ss_set_dirty(ss, SS_DIRTY_SCRIPT(script_idx));
 }
 
 void ss_overwrite_script_command(scene_state_t *ss, script_number_t script_idx,
@@ -249,12 +433,23 @@ void ss_delete_script_command(scene_state_t *ss, script_number_t script_idx,
 
         tele_command_t blank_command;
         blank_command.length = 0;
+        blank_command.separator = -1;
         ss_set_script_command(ss, script_idx, script_len, &blank_command);
     }
 }
 
 void ss_clear_script(scene_state_t *ss, size_t script_idx) {
     memset(&ss->scripts[script_idx], 0, sizeof(scene_script_t));
+    memset(&ss->compiled[script_idx], 0, sizeof(ss->compiled[script_idx]));
+    ss_set_dirty(ss, SS_DIRTY_SCRIPT(script_idx));
+}
+
+// scripts that are copied in directly (e.g. from flash) need compiling before
+// they can be run
+void ss_compile_scripts(scene_state_t *ss) {
+    for (size_t s = 0; s < SCRIPT_COUNT; s++)
+        for (size_t l = 0; l < SCRIPT_MAX_COMMANDS; l++)
+            compile_command(&ss->scripts[s].c[l], &ss->compiled[s][l]);
 }
 
 scene_script_t *ss_scripts_ptr(scene_state_t *ss) {
@@ -415,12 +610,34 @@ void ss_reset_in_cal(scene_state_t *ss) {
     tele_save_calibration();
 }
 
+// Random numbers
+
+void ss_rand_seed(scene_state_t *ss, uint32_t seed) {
+    // xorshift gets stuck at 0
+    ss->rand_state = seed ? seed : 1;
+}
+
+// xorshift32, returns 0 to INT32_MAX like rand()
+int32_t ss_rand(scene_state_t *ss) {
+    uint32_t x = ss->rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ss->rand_state = x;
+    return x >> 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // EXEC STATE //////////////////////////////////////////////////////////////////
 
 void es_init(exec_state_t *es) {
     es->exec_depth = 0;
     es->overflow = false;
+    es->ops = 0;
+    es->op_limit = UINT32_MAX;
+    es->depth_high = 0;
+    es->stack_high = 0;
+    es->while_high = 0;
 }
 
 size_t es_depth(exec_state_t *es) {
@@ -438,6 +655,7 @@ size_t es_push(exec_state_t *es) {
         es->variables[es->exec_depth].i = 0;
         es->variables[es->exec_depth].breaking = false;
         es->exec_depth += 1;  // exec_depth = 1 at the root
+        if (es->exec_depth > es->depth_high) es->depth_high = es->exec_depth;
     }
     else
         es->overflow = true;
@@ -466,6 +684,11 @@ exec_vars_t *es_variables(exec_state_t *es) {
     return &es->variables[es->exec_depth - 1];  // but array is 0-indexed
 }
 
+void es_abort(exec_state_t *es) {
+    for (uint8_t i = 0; i < es->exec_depth; i++)
+        es->variables[i].breaking = true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // COMMAND STATE ///////////////////////////////////////////////////////////////
 
@@ -5,17 +5,25 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "chaos.h"
 #include "command.h"
+#include "cv_out.h"
 #include "every.h"
+#include "ii_poll.h"
+#include "ii_queue.h"
+#include "queue.h"
 #include "scale.h"
 #include "turtle.h"
 
 #define STACK_SIZE 8
 #define CV_COUNT 4
-#define Q_LENGTH 64
 #define TR_COUNT 4
 #define TRIGGER_INPUTS 8
+// the number of DEL commands that can be pending at once, can be set at build
+// time (e.g. -DDELAY_SIZE=64), but must be no more than 255
+#ifndef DELAY_SIZE
 #define DELAY_SIZE 8
+#endif
 #define STACK_OP_SIZE 16
 #define PATTERN_COUNT 4
 #define PATTERN_LENGTH 64
@@ -27,6 +35,38 @@
 #define METRO_MIN_MS 25
 #define METRO_MIN_UNSUPPORTED_MS 2
 
+////////////////////////////////////////////////////////////////////////////////
+// COMPILED COMMANDS ///////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// A compiled command is the executable form of a script line. It is built once
+// when the line is stored (see compile_command in teletype.c), so that running
+// the line doesn't need to rescan the words for SUB separators or decide
+// between get and set.
+
+// a word is an index into tele_ops, with COMPILED_SET if the op's set fn is
+// to be called, or COMPILED_NUMBER for a number, kept to 4 bytes as there are
+// one of these for every word of every line in the scene
+#define COMPILED_SET 0x8000
+#define COMPILED_NUMBER 0xffff
+
+typedef struct {
+    uint16_t op;
+    int16_t value;  // if the word is a number
+} tele_compiled_word_t;
+
+typedef struct {
+    // number of words, excluding the MOD and separators
+    uint8_t length;
+    // the MOD (index into tele_mods) to run at the end of the first sub, or -1
+    int8_t mod;
+    uint8_t sub_count;
+    // the (exclusive) end of each sub in words
+    uint8_t sub_end[COMMAND_MAX_LENGTH / 2];
+    // words in execution order (i.e. right to left for each sub)
+    tele_compiled_word_t words[COMMAND_MAX_LENGTH];
+} tele_compiled_command_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 // SCENE STATE /////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -47,6 +87,7 @@ typedef struct {
     int16_t cv[CV_COUNT];
     int16_t cv_off[CV_COUNT];
     int16_t cv_slew[CV_COUNT];
+    int16_t cv_curve[CV_COUNT];
     int16_t drunk;
     int16_t drunk_max;
     int16_t drunk_min;
@@ -63,8 +104,7 @@ typedef struct {
     int16_t o_wrap;
     int16_t p_n;
     int16_t param;
-    int16_t q[Q_LENGTH];
-    int16_t q_n;
+    scene_queue_t q;
     int16_t r_min;
     int16_t r_max;
     int16_t scene;
@@ -90,12 +130,25 @@ typedef struct {
 } scene_pattern_t;
 
 typedef struct {
-    // TODO add a delay variables struct?
+    // each delay is stored in a slot, the slot number indexes these arrays
     tele_command_t commands[DELAY_SIZE];
-    int16_t time[DELAY_SIZE];
+    uint32_t due[DELAY_SIZE];    // the value of now when the delay should run
+    uint32_t order[DELAY_SIZE];  // delays due at the same time run in order
     uint8_t origin_script[DELAY_SIZE];
     int16_t origin_i[DELAY_SIZE];
+    // a binary min-heap of the slots waiting to run, ordered by due time
+    uint8_t heap[DELAY_SIZE];
+    // a stack of unused slots
+    uint8_t free[DELAY_SIZE];
+    uint8_t free_count;
+    // the number of delays waiting to run (i.e. the heap size)
     uint8_t count;
+    // the slot currently being run, or DELAY_SIZE
+    uint8_t running;
+    uint32_t now;
+    uint32_t next_order;
+    // the number of DEL commands discarded because there was no free slot
+    uint16_t dropped;
 } scene_delay_t;
 
 typedef struct {
@@ -111,17 +164,80 @@ typedef struct {
     int16_t last_time;
 } scene_script_t;
 
+// The parts of a scene that have changed since it was last read from or
+// written to flash, so that saving a scene that hasn't changed is free (see
+// flash_write). The setters below mark what they change, text is marked by
+// whoever edits it.
+#define SS_DIRTY_SCRIPT(n) ((uint32_t)1 << (n))
+#define SS_DIRTY_PATTERN(n) ((uint32_t)1 << (SCRIPT_COUNT + (n)))
+#define SS_DIRTY_TEXT ((uint32_t)1 << (SCRIPT_COUNT + PATTERN_COUNT))
+#define SS_DIRTY_ALL (((uint32_t)SS_DIRTY_TEXT << 1) - 1)
+
+typedef struct {
+    uint32_t sections;
+    int16_t slot;  // the flash slot the scene matches, or -1
+} scene_dirty_t;
+
+// A W loop at the top level of a script can be made to yield once the script
+// has run a number of ops (its budget), so that a long loop is spread over
+// several ticks rather than holding up triggers and the CV timer. tele_tick
+// carries on from where the loop left off, with the same budget again.
 typedef struct {
+    uint8_t line;
+    int16_t i;
+    uint16_t while_depth;
+    bool if_else_condition;
+} scene_run_t;
+
+typedef struct {
+    // ops per tick for each script, 0 (the default) runs it to the end
+    uint16_t budget[SCRIPT_COUNT];
+    // stop the script where it is once the budget is spent, rather than
+    // yield, wherever it's got to
+    bool abort[SCRIPT_COUNT];
+    // a bit per script with a loop waiting to carry on
+    uint16_t pending;
+    scene_run_t run[SCRIPT_COUNT];
+} scene_resume_t;
+
+// What each script has done since the scene was loaded (or BUDGET.CLR), so
+// that a scene can be checked against its budgets. A run is a script run from
+// the top (by a trigger, M, I or the keyboard), or a tick of a W loop that
+// yielded, and includes any SCRIPTs it calls.
+typedef struct {
+    uint16_t overruns;  // runs that spent their budget
+    uint32_t ops;       // the most ops and mods in a run
+    uint8_t depth;      // the deepest the exec state got (1 for no SCRIPT)
+    uint8_t stack;      // the deepest a command stack got
+    uint16_t w;         // the most times round a W loop
+} scene_script_stats_t;
+
+typedef struct scene_state_s {
     bool initializing;
     scene_variables_t variables;
     scene_pattern_t patterns[PATTERN_COUNT];
     scene_delay_t delay;
     scene_stack_op_t stack_op;
+    scene_resume_t resume;
+    scene_script_stats_t stats[SCRIPT_COUNT];
     int16_t tr_pulse_timer[TR_COUNT];
     scene_script_t scripts[SCRIPT_COUNT];
+    // kept outside of scene_script_t so that it's not written to flash
+    tele_compiled_command_t compiled[SCRIPT_COUNT][SCRIPT_MAX_COMMANDS];
     scene_turtle_t turtle;
     bool every_last;
     cal_data_t cal;
+    // RNG and CHAOS live here rather than in globals, so that scenes can be run
+    // side by side
+    uint32_t rand_state;
+    chaos_state_t chaos;
+    // i2c messages from the ops, waiting to be sent (see ii_queue.h)
+    ii_queue_t ii;
+    // remote inputs read between scripts (see ii_poll.h)
+    ii_poll_t ii_poll;
+    // CV changes from the ops, waiting for the script to finish (see cv_out.h)
+    cv_out_t cv_out;
+    scene_dirty_t dirty;
 } scene_state_t;
 
 extern void ss_init(scene_state_t *ss);
@@ -129,6 +245,12 @@ extern void ss_variables_init(scene_state_t *ss);
 extern void ss_patterns_init(scene_state_t *ss);
 extern void ss_pattern_init(scene_state_t *ss, size_t pattern_no);
 
+extern void ss_set_dirty(scene_state_t *ss, uint32_t sections);
+extern uint32_t ss_get_dirty(scene_state_t *ss);
+extern int16_t ss_get_dirty_slot(scene_state_t *ss);
+// the scene now matches flash slot (or -1 for none)
+extern void ss_clear_dirty(scene_state_t *ss, int16_t slot);
+
 extern void ss_set_in(scene_state_t *ss, int16_t value);
 extern void ss_set_param(scene_state_t *ss, int16_t value);
 extern void ss_set_scene(scene_state_t *ss, int16_t value);
@@ -155,10 +277,34 @@ extern void ss_set_pattern_val(scene_state_t *ss, size_t pattern, size_t idx,
 extern scene_pattern_t *ss_patterns_ptr(scene_state_t *ss);
 extern size_t ss_patterns_size(void);
 
+extern void ss_delay_clear(scene_state_t *ss);
+extern bool ss_delay_add(scene_state_t *ss, int16_t time,
+                         const tele_command_t *cmd, uint8_t origin_script,
+                         int16_t origin_i);
+extern void ss_delay_advance(scene_state_t *ss, uint16_t time);
+extern int32_t ss_delay_next_due(scene_state_t *ss);
+extern int16_t ss_delay_pop_due(scene_state_t *ss);
+extern void ss_delay_release(scene_state_t *ss, uint8_t slot);
+extern uint16_t ss_delay_dropped(scene_state_t *ss);
+
+extern uint16_t ss_get_script_budget(scene_state_t *ss, script_number_t idx);
+extern void ss_set_script_budget(scene_state_t *ss, script_number_t idx,
+                                 uint16_t budget);
+extern bool ss_get_script_abort(scene_state_t *ss, script_number_t idx);
+extern void ss_set_script_abort(scene_state_t *ss, script_number_t idx,
+                                bool abort);
+// abandons any loops waiting to carry on
+extern void ss_resume_clear(scene_state_t *ss);
+extern const scene_script_stats_t *ss_get_script_stats(scene_state_t *ss,
+                                                       script_number_t idx);
+extern void ss_stats_clear(scene_state_t *ss);
+
 uint8_t ss_get_script_len(scene_state_t *ss, script_number_t idx);
 const tele_command_t *ss_get_script_command(scene_state_t *ss,
                                             script_number_t script_idx,
                                             size_t c_idx);
+const tele_compiled_command_t *ss_get_compiled_command(
+    scene_state_t *ss, script_number_t script_idx, size_t c_idx);
 bool ss_get_script_comment(scene_state_t *ss, script_number_t script_idx,
                            size_t c_idx);
 void ss_toggle_script_comment(scene_state_t *ss, script_number_t script_idx,
@@ -170,6 +316,7 @@ void ss_insert_script_command(scene_state_t *ss, script_number_t script_idx,
 void ss_delete_script_command(scene_state_t *ss, script_number_t script_idx,
                               size_t command_idx);
 void ss_clear_script(scene_state_t *ss, size_t script_idx);
+void ss_compile_scripts(scene_state_t *ss);
 
 scene_script_t *ss_scripts_ptr(scene_state_t *ss);
 size_t ss_scripts_size(void);
@@ -204,6 +351,9 @@ void ss_set_param_min(scene_state_t *, int16_t);
 void ss_set_param_max(scene_state_t *, int16_t);
 void ss_reset_param_cal(scene_state_t *);
 
+void ss_rand_seed(scene_state_t *, uint32_t seed);
+int32_t ss_rand(scene_state_t *);
+
 ////////////////////////////////////////////////////////////////////////////////
 // EXEC STATE //////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -219,10 +369,18 @@ typedef struct {
     bool delayed;
 } exec_vars_t;
 
-typedef struct {
+typedef struct exec_state_s {
     exec_vars_t variables[EXEC_DEPTH];
     uint8_t exec_depth;
     bool overflow;
+    // ops and mods run, for the script budgets, once there are more than
+    // op_limit every level of the exec state is stopped as if by BREAK
+    uint32_t ops;
+    uint32_t op_limit;
+    // high water marks, for scene_script_stats_t
+    uint8_t depth_high;
+    uint8_t stack_high;
+    uint16_t while_high;
 } exec_state_t;
 
 extern void es_init(exec_state_t *es);
@@ -233,6 +391,8 @@ extern void es_set_script_number(exec_state_t *es, uint8_t script_number);
 extern void es_set_line_number(exec_state_t *es, uint8_t line_number);
 extern uint8_t es_get_line_number(exec_state_t *es);
 extern exec_vars_t *es_variables(exec_state_t *es);
+// BREAKs out of every level, for when the op budget is spent
+extern void es_abort(exec_state_t *es);
 
 ////////////////////////////////////////////////////////////////////////////////
 // COMMAND STATE ///////////////////////////////////////////////////////////////
@@ -243,7 +403,7 @@ typedef struct {
     int16_t top;
 } command_state_stack_t;
 
-typedef struct {
+typedef struct command_state_s {
     command_state_stack_t stack;
 } command_state_t;
 
@@ -5,6 +5,7 @@
 
 #include "helpers.h"
 #include "ops/op.h"
+#include "profiler.h"
 #include "scanner.h"
 #include "table.h"
 #include "teletype.h"
@@ -12,17 +13,13 @@
 #include "util.h"
 
 
-bool processing_delays = false;
-
 /////////////////////////////////////////////////////////////////
 // DELAY ////////////////////////////////////////////////////////
 
 void clear_delays(scene_state_t *ss) {
     for (int16_t i = 0; i < TR_COUNT; i++) { ss->tr_pulse_timer[i] = 0; }
 
-    for (int16_t i = 0; i < DELAY_SIZE; i++) { ss->delay.time[i] = 0; }
-
-    ss->delay.count = 0;
+    ss_delay_clear(ss);
     ss->stack_op.top = 0;
 
     tele_has_delays(false);
@@ -50,12 +47,12 @@ error_t validate(const tele_command_t *c,
     int8_t sep_count = 0;
 
     while (idx--) {  // process words right to left
-        tele_word_t word_type = c->data[idx].tag;
-        int16_t word_value = c->data[idx].value;
+        tele_word_t word_type = command_tag(c, idx);
+        int16_t word_value = command_value(c, idx);
         // A first_cmd is either at the beginning of the command or immediately
         // after the PRE_SEP or COMMAND_SEP
-        bool first_cmd = idx == 0 || c->data[idx - 1].tag == PRE_SEP ||
-                         c->data[idx - 1].tag == SUB_SEP;
+        bool first_cmd = idx == 0 || command_tag(c, idx - 1) == PRE_SEP ||
+                         command_tag(c, idx - 1) == SUB_SEP;
 
         if (word_type == NUMBER) { stack_depth++; }
         else if (word_type == OP) {
@@ -107,7 +104,7 @@ error_t validate(const tele_command_t *c,
 
             if (idx == 0) return E_PLACE_PRE_SEP;
 
-            if (c->data[0].tag != MOD) return E_PLACE_PRE_SEP;
+            if (command_tag(c, 0) != MOD) return E_PLACE_PRE_SEP;
 
             if (stack_depth > 1) return E_EXTRA_PARAMS;
 
@@ -130,6 +127,99 @@ error_t validate(const tele_command_t *c,
         return E_OK;
 }
 
+/////////////////////////////////////////////////////////////////
+// COMPILE //////////////////////////////////////////////////////
+
+// if the last params words are all numbers then a pure op can be evaluated
+// now and replaced with its result, only the compiled form is changed, the
+// original command (and thus print_command) is left alone
+static void fold_pure_op(tele_compiled_command_t *out, uint8_t sub_start,
+                         tele_op_idx_t op_idx) {
+    const tele_op_t *op = tele_ops[op_idx];
+    if (!op_is_pure(op_idx) || !op->returns) return;
+    if (out->length - 1 - sub_start < op->params) return;
+
+    // the op itself is the last word, its params are the words before it
+    const uint8_t first_param = out->length - 1 - op->params;
+    for (uint8_t i = first_param; i < out->length - 1; i++)
+        if (out->words[i].op != COMPILED_NUMBER) return;
+
+    command_state_t cs;
+    cs_init(&cs);
+    for (uint8_t i = first_param; i < out->length - 1; i++)
+        cs_push(&cs, out->words[i].value);
+
+    // pure ops don't use the scene or exec state
+    op->get(op->data, NULL, NULL, &cs);
+
+    out->length = first_param + 1;
+    out->words[first_param].op = COMPILED_NUMBER;
+    out->words[first_param].value = cs_pop(&cs);
+}
+
+// compile a validated command into the form used by process_compiled_command,
+// the words of each SUB are stored in the order that process_command would
+// visit them, and the get or set decision is made using the stack depth that
+// the words to the right of an op will leave
+void compile_command(const tele_command_t *c, tele_compiled_command_t *out) {
+    out->length = 0;
+    out->mod = -1;
+    out->sub_count = 0;
+
+    // only the PRE part is run directly, the MOD takes care of the POST
+    ssize_t end_idx = c->length;
+    if (c->separator >= 0 && c->separator < c->length) end_idx = c->separator;
+
+    ssize_t sub_start = 0;
+    for (ssize_t idx = 0; idx <= end_idx; idx++) {
+        if (idx < end_idx && command_tag(c, idx) != SUB_SEP) continue;
+
+        // empty subs are skipped, as they are in process_command
+        if (idx > sub_start) {
+            const uint8_t sub_words_start = out->length;
+            int16_t stack_depth = 0;
+
+            for (ssize_t i = idx - 1; i >= sub_start; i--) {
+                const tele_word_t word_type = command_tag(c, i);
+                const int16_t word_value = command_value(c, i);
+                tele_compiled_word_t *w = &out->words[out->length];
+
+                if (word_type == NUMBER) {
+                    w->op = COMPILED_NUMBER;
+                    w->value = word_value;
+                    out->length++;
+                    stack_depth++;
+                }
+                else if (word_type == OP) {
+                    const tele_op_t *op = tele_ops[word_value];
+
+                    w->op = word_value;
+                    w->value = 0;
+                    if (i == sub_start && op->set != NULL &&
+                        stack_depth >= op->params + 1)
+                        w->op |= COMPILED_SET;
+                    out->length++;
+
+                    stack_depth -= op->params;
+                    if (stack_depth < 0) stack_depth = 0;
+                    if (op->returns) stack_depth++;
+
+                    fold_pure_op(out, sub_words_start, word_value);
+                }
+                else if (word_type == MOD) {
+                    // validate only allows a MOD as the very first word
+                    out->mod = word_value;
+                }
+            }
+
+            out->sub_end[out->sub_count] = out->length;
+            out->sub_count++;
+        }
+
+        sub_start = idx + 1;
+    }
+}
+
 /////////////////////////////////////////////////////////////////
 // RUN //////////////////////////////////////////////////////////
 
@@ -140,18 +230,48 @@ process_result_t run_script(scene_state_t *ss, size_t script_no) {
     return run_script_with_exec_state(ss, &es, script_no);
 }
 
-// Everything needs to call this to execute code.  An execution
-// context is required for proper operation of DEL, THIS, L, W, IF
-process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
-                                            size_t script_no) {
-#ifdef TELETYPE_PROFILE
-    tele_profile_script(script_no);
-#endif
+// saves where a W loop has got to, for resume_script
+static void suspend_script(scene_state_t *ss, exec_state_t *es,
+                           size_t script_no) {
+    const exec_vars_t *v = es_variables(es);
+    scene_run_t *run = &ss->resume.run[script_no];
+    run->line = v->line_number;
+    run->i = v->i;
+    run->while_depth = v->while_depth;
+    run->if_else_condition = v->if_else_condition;
+    ss->resume.pending |= 1 << script_no;
+}
+
+// adds a run to the script's stats
+static void record_run(scene_state_t *ss, exec_state_t *es, size_t script_no,
+                       bool overrun) {
+    scene_script_stats_t *s = &ss->stats[script_no];
+    if (overrun && s->overruns < UINT16_MAX) s->overruns++;
+    if (es->ops > s->ops) s->ops = es->ops;
+    if (es->depth_high > s->depth) s->depth = es->depth_high;
+    if (es->stack_high > s->stack) s->stack = es->stack_high;
+    if (es->while_high > s->w) s->w = es->while_high;
+}
+
+// runs the lines of a script from first, if the script has a budget then
+// either every level stops once it's spent, or a W loop at the top level
+// stops and is left for tele_tick
+static process_result_t run_lines(scene_state_t *ss, exec_state_t *es,
+                                  size_t script_no, size_t first) {
     process_result_t result = { .has_value = false, .value = 0 };
 
-    es_set_script_number(es, script_no);
+    // SCRIPT, delays and live commands always run to the end, and are counted
+    // as part of whatever ran them
+    const bool top = es_depth(es) == 1 && !es_variables(es)->delayed &&
+                     script_no < TEMP_SCRIPT;
+    const uint16_t budget = top ? ss_get_script_budget(ss, script_no) : 0;
+    uint16_t yield_at = budget;
+    if (budget && ss_get_script_abort(ss, script_no)) {
+        es->op_limit = budget;
+        yield_at = 0;
+    }
 
-    for (size_t i = 0; i < ss_get_script_len(ss, script_no); i++) {
+    for (size_t i = first; i < ss_get_script_len(ss, script_no); i++) {
         es_set_line_number(es, i);
 
         // Commented code doesn't run.
@@ -159,20 +279,82 @@ process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
 
         // BREAK implemented with break...
         if (es_variables(es)->breaking) break;
+#ifdef TELETYPE_PROFILE
+        const uint32_t line_start = tele_profile_time();
+#endif
         do {
             // TODO: Check for 0-length commands before we bother?
-            result = process_command(ss, es,
-                                     ss_get_script_command(ss, script_no, i));
+            result = process_compiled_command(
+                ss, es, ss_get_compiled_command(ss, script_no, i),
+                ss_get_script_command(ss, script_no, i));
             // and WHILE implemented with while!
         } while (es_variables(es)->while_continue &&
-                 !es_variables(es)->breaking);
+                 !es_variables(es)->breaking &&
+                 (yield_at == 0 || es->ops < yield_at));
+#ifdef TELETYPE_PROFILE
+        profile_line(script_no, i, tele_profile_time() - line_start);
+#endif
+        if (es_variables(es)->while_continue && !es_variables(es)->breaking) {
+            record_run(ss, es, script_no, true);
+            suspend_script(ss, es, script_no);
+            return result;
+        }
     }
 
+    if (top) record_run(ss, es, script_no, budget && es->ops > budget);
     es_variables(es)->breaking = false;
     ss_update_script_last(ss, script_no);
+    return result;
+}
+
+// carries on with a W loop that ran out of budget, from the start of the line
+// it's on (i.e. the next time round the loop)
+static void resume_script(scene_state_t *ss, size_t script_no) {
+    ss->resume.pending &= ~(1 << script_no);
+    const scene_run_t *run = &ss->resume.run[script_no];
+    // the script may have been edited since
+    if (run->line >= ss_get_script_len(ss, script_no)) return;
 
 #ifdef TELETYPE_PROFILE
-    tele_profile_script(script_no);
+    const uint32_t script_start = tele_profile_time();
+#endif
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    es_set_script_number(&es, script_no);
+    exec_vars_t *v = es_variables(&es);
+    v->i = run->i;
+    v->while_depth = run->while_depth;
+    v->if_else_condition = run->if_else_condition;
+    v->while_continue = true;
+
+    run_lines(ss, &es, script_no, run->line);
+#ifdef TELETYPE_PROFILE
+    profile_script(script_no, tele_profile_time() - script_start);
+#endif
+}
+
+// Everything needs to call this to execute code.  An execution
+// context is required for proper operation of DEL, THIS, L, W, IF
+process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
+                                            size_t script_no) {
+#ifdef TELETYPE_PROFILE
+    const uint32_t script_start = tele_profile_time();
+#endif
+    es_set_script_number(es, script_no);
+
+    // running a script again starts it over
+    if (es_depth(es) == 1) ss->resume.pending &= ~(1 << script_no);
+
+    // the script's CV changes reach the outputs together when it's done, as
+    // do its i2c messages (SCRIPT leaves them for its caller)
+    cv_out_begin(&ss->cv_out);
+    process_result_t result = run_lines(ss, es, script_no, 0);
+    cv_out_commit(&ss->cv_out);
+    if (es_depth(es) == 1) ii_flush(&ss->ii);
+
+#ifdef TELETYPE_PROFILE
+    profile_script(script_no, tele_profile_time() - script_start);
 #endif
     return result;
 }
@@ -188,9 +370,12 @@ process_result_t run_command(scene_state_t *ss, const tele_command_t *cmd) {
     // the lack of a script number here is a bug, so if you use this code,
     // something needs to set the script number
     // es_variables(es)->script_number =
+    cv_out_begin(&ss->cv_out);
     do {
         o = process_command(ss, &es, cmd);
     } while (es_variables(&es)->while_continue && !es_variables(&es)->breaking);
+    cv_out_commit(&ss->cv_out);
+    ii_flush(&ss->ii);
     return o;
 }
 
@@ -223,9 +408,9 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
     ssize_t sub_len = 0;
     ssize_t sub_start = 0;
 
-    // iterate through c->data to find all the SUB_SEPs and add to the array
+    // iterate through the words to find all the SUB_SEPs and add to the array
     for (ssize_t idx = start_idx; idx < end_idx; idx++) {
-        tele_word_t word_type = c->data[idx].tag;
+        tele_word_t word_type = command_tag(c, idx);
         if (word_type == SUB_SEP && idx > sub_start) {
             subs[sub_len].start = sub_start;
             subs[sub_len].end = idx - 1;
@@ -257,26 +442,41 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
         // as we are using a stack based language, we must process commands from
         // right to left
         for (ssize_t idx = sub_end; idx >= sub_start; idx--) {
-            const tele_word_t word_type = c->data[idx].tag;
-            const int16_t word_value = c->data[idx].value;
+            const tele_word_t word_type = command_tag(c, idx);
+            const int16_t word_value = command_value(c, idx);
 
             if (word_type == NUMBER) { cs_push(&cs, word_value); }
             else if (word_type == OP) {
                 const tele_op_t *op = tele_ops[word_value];
+                if (++es->ops > es->op_limit) es_abort(es);
 
                 // if we're in the first command position, and there is a set fn
                 // pointer and we have enough params, then run set, else run get
+#ifdef TELETYPE_PROFILE
+                const uint32_t start = tele_profile_time();
+#endif
                 if (idx == sub_start && op->set != NULL &&
                     cs_stack_size(&cs) >= op->params + 1)
                     op->set(op->data, ss, es, &cs);
                 else
                     op->get(op->data, ss, es, &cs);
+#ifdef TELETYPE_PROFILE
+                profile_op(word_value, tele_profile_time() - start);
+#endif
             }
             else if (word_type == MOD) {
                 tele_command_t post_command;
                 copy_post_command(&post_command, c);
+                if (++es->ops > es->op_limit) es_abort(es);
+#ifdef TELETYPE_PROFILE
+                const uint32_t start = tele_profile_time();
+#endif
                 tele_mods[word_value]->func(ss, es, &cs, &post_command);
+#ifdef TELETYPE_PROFILE
+                profile_mod(word_value, tele_profile_time() - start);
+#endif
             }
+            if (cs.stack.top > es->stack_high) es->stack_high = cs.stack.top;
         }
     }
 
@@ -294,14 +494,80 @@ process_result_t process_command(scene_state_t *ss, exec_state_t *es,
 }
 
 
+// run a compiled command inside a given exec_state, c must be the command
+// that cc was compiled from (it is used to build the POST command for a MOD)
+process_result_t process_compiled_command(scene_state_t *ss, exec_state_t *es,
+                                          const tele_compiled_command_t *cc,
+                                          const tele_command_t *c) {
+    command_state_t cs;
+    cs_init(&cs);
+
+    uint8_t idx = 0;
+    for (uint8_t sub_idx = 0;
+         sub_idx < cc->sub_count && !es_variables(es)->breaking; sub_idx++) {
+        const uint8_t sub_end = cc->sub_end[sub_idx];
+
+        // start each sub with an empty stack (see process_command)
+        cs_init(&cs);
+
+        for (; idx < sub_end; idx++) {
+            const tele_compiled_word_t *w = &cc->words[idx];
+            if (w->op == COMPILED_NUMBER)
+                cs_push(&cs, w->value);
+            else {
+                if (++es->ops > es->op_limit) es_abort(es);
+                const tele_op_idx_t op_idx = w->op & ~COMPILED_SET;
+                const tele_op_t *op = tele_ops[op_idx];
+#ifdef TELETYPE_PROFILE
+                const uint32_t start = tele_profile_time();
+#endif
+                if (w->op & COMPILED_SET)
+                    op->set(op->data, ss, es, &cs);
+                else
+                    op->get(op->data, ss, es, &cs);
+#ifdef TELETYPE_PROFILE
+                profile_op(op_idx, tele_profile_time() - start);
+#endif
+            }
+            if (cs.stack.top > es->stack_high) es->stack_high = cs.stack.top;
+        }
+
+        if (sub_idx == 0 && cc->mod >= 0) {
+            tele_command_t post_command;
+            copy_post_command(&post_command, c);
+            if (++es->ops > es->op_limit) es_abort(es);
+#ifdef TELETYPE_PROFILE
+            const uint32_t start = tele_profile_time();
+#endif
+            tele_mods[cc->mod]->func(ss, es, &cs, &post_command);
+#ifdef TELETYPE_PROFILE
+            profile_mod(cc->mod, tele_profile_time() - start);
+#endif
+        }
+    }
+
+    if (cs_stack_size(&cs)) {
+        process_result_t o = { .has_value = true, .value = cs_pop(&cs) };
+        return o;
+    }
+    else {
+        process_result_t o = { .has_value = false, .value = 0 };
+        return o;
+    }
+}
+
+
 /////////////////////////////////////////////////////////////////
 // TICK /////////////////////////////////////////////////////////
 
-void tele_tick(scene_state_t *ss, uint8_t time) {
+void tele_tick(scene_state_t *ss, uint16_t time) {
     // time is the basic resolution of all code henceforth called
     // hardware 2.0: get an RTC!
     if (ss->variables.time_act) ss->variables.time += time;
 
+    // the CV changes made by the turtle, delays and W loops land together
+    cv_out_begin(&ss->cv_out);
+
     // could be a while() if there is reason to expect a user to cascade moves
     // with SCRIPTs without the tick delay
     if (ss->turtle.stepped && ss->turtle.script_number != TEMP_SCRIPT) {
@@ -310,53 +576,56 @@ void tele_tick(scene_state_t *ss, uint8_t time) {
     }
 
     // process delays
-    for (int16_t i = 0; i < DELAY_SIZE; i++) {
-        if (ss->delay.time[i]) {
-            ss->delay.time[i] -= time;
-            if (ss->delay.time[i] <= 0) {
+    // they're kept in due order, so only the delays that are due are visited
+    ss_delay_advance(ss, time);
+    int16_t i;
+    while ((i = ss_delay_pop_due(ss)) >= 0) {
 #ifdef TELETYPE_PROFILE
-                tele_profile_delay(i);
+        const uint32_t start = tele_profile_time();
 #endif
-                // Workaround for issue #80. (0 is the signifier for "empty")
-                // Setting delay.time[i] to 1 prevents delayed delay commands
-                //     from seeing a perfectly-timed delay slot as empty
-                //     while it's still being processed.
-                ss->delay.time[i] = 1;
-
-                // Instead of just running the command, we use the TEMP script
-                // to execute it.  This is required for THIS to be tracked, as
-                // it needs to have a script number.
-                // TODO: dynamically allocate scripts to prevent waste
-                ss_clear_script(ss, TEMP_SCRIPT);
-                ss_overwrite_script_command(ss, TEMP_SCRIPT, 0,
-                                            &ss->delay.commands[i]);
-
-                // We always need to execute from within an execution context
-                // TODO: ensure all code does so!
-                // New execution context setup needs to es_push, but it's
-                // decoupled to allow SCRIPT to work
-                exec_state_t es;
-                es_init(&es);
-                es_push(&es);
-
-                // The delay flag is required to protect the script number
-                // TODO: investigate delayed nested SCRIPTs
-                es_variables(&es)->delayed = true;
-                es_variables(&es)->script_number = ss->delay.origin_script[i];
-                es_variables(&es)->i = ss->delay.origin_i[i];
-
-                run_script_with_exec_state(ss, &es, TEMP_SCRIPT);
-
-                ss->delay.time[i] = 0;
-                ss->delay.count--;
-                if (ss->delay.count == 0) tele_has_delays(false);
+        // We always need to execute from within an execution context
+        // TODO: ensure all code does so!
+        // New execution context setup needs to es_push, but it's
+        // decoupled to allow SCRIPT to work
+        exec_state_t es;
+        es_init(&es);
+        es_push(&es);
+
+        // The delay flag is required to protect the script number, which is
+        // what THIS (and EVERY) use, so the command can run straight from its
+        // slot rather than being copied into the TEMP script first
+        // TODO: investigate delayed nested SCRIPTs
+        es_variables(&es)->delayed = true;
+        es_variables(&es)->script_number = ss->delay.origin_script[i];
+        es_variables(&es)->line_number = 0;
+        es_variables(&es)->i = ss->delay.origin_i[i];
+
+        do {
+            process_command(ss, &es, &ss->delay.commands[i]);
+        } while (es_variables(&es)->while_continue &&
+                 !es_variables(&es)->breaking);
+
+        // the slot is only released now, so that a DEL run by the delayed
+        // command can't reuse it while it's still being processed (#80)
+        ss_delay_release(ss, i);
+        if (ss->delay.count == 0) tele_has_delays(false);
 #ifdef TELETYPE_PROFILE
-                tele_profile_delay(i);
+        profile_delay(tele_profile_time() - start);
 #endif
-            }
-        }
     }
 
+    // carry on with W loops that ran out of budget last time
+    for (size_t i = 0; i < SCRIPT_COUNT; i++)
+        if (ss->resume.pending & (1 << i)) resume_script(ss, i);
+
+    // send the i2c messages from the delays, turtle and W loops (and the ones
+    // a rate limit held back), then read the polled inputs, so the reads see
+    // them
+    cv_out_commit(&ss->cv_out);
+    ii_queue_tick(&ss->ii, time);
+    ii_flush(&ss->ii);
+    ii_poll_tick(&ss->ii_poll, &ss->ii, time);
+
     // process tr pulses
     for (int16_t i = 0; i < TR_COUNT; i++) {
         if (ss->tr_pulse_timer[i]) {
@@ -377,6 +646,39 @@ void tele_tick(scene_state_t *ss, uint8_t time) {
     }
 }
 
+// returns the number of ms until tele_tick next has something to do, or -1 if
+// nothing is pending, hosts can use it to sleep (or jump virtual time) rather
+// than call tele_tick at a fixed rate, TIME is only correct if the elapsed
+// time is still passed to tele_tick before it's read
+int16_t tele_next_deadline(scene_state_t *ss) {
+    // turtle steps are run on the next tick
+    if (ss->turtle.stepped && ss->turtle.script_number != TEMP_SCRIPT) return 0;
+    // as are W loops waiting to carry on
+    if (ss->resume.pending) return 0;
+
+    int32_t deadline = ss_delay_next_due(ss);
+
+    int16_t poll = ii_poll_next_due(&ss->ii_poll);
+    if (poll >= 0 && (deadline < 0 || poll < deadline)) deadline = poll;
+    int16_t ii = ii_queue_next_due(&ss->ii);
+    if (ii >= 0 && (deadline < 0 || ii < deadline)) deadline = ii;
+
+    for (int16_t i = 0; i < TR_COUNT; i++) {
+        if (ss->tr_pulse_timer[i]) {
+            // as in tele_tick, the timer is capped by tr_time
+            int16_t t = ss->tr_pulse_timer[i];
+            int16_t tr_time = ss->variables.tr_time[i];
+            if (tr_time < 0) tr_time = 0;
+            if (t > tr_time) t = tr_time;
+            if (t < 0) t = 0;
+            if (deadline < 0 || t < deadline) deadline = t;
+        }
+    }
+
+    if (deadline > INT16_MAX) deadline = INT16_MAX;
+    return deadline;
+}
+
 /////////////////////////////////////////////////////////////////
 // ERROR MESSAGES ///////////////////////////////////////////////
 
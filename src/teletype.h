@@ -9,7 +9,6 @@
 #include "state.h"
 
 #define TELE_ERROR_MSG_LENGTH 16
-// #define TELETYPE_PROFILE // un-comment this line to enable profiling
 
 typedef enum {
     E_OK,
@@ -37,14 +36,19 @@ error_t parse(const char *cmd, tele_command_t *out,
               char error_msg[TELE_ERROR_MSG_LENGTH]);
 error_t validate(const tele_command_t *c,
                  char error_msg[TELE_ERROR_MSG_LENGTH]);
+void compile_command(const tele_command_t *c, tele_compiled_command_t *out);
 process_result_t run_script(scene_state_t *ss, size_t script_no);
 process_result_t run_script_with_exec_state(scene_state_t *ss, exec_state_t *es,
                                             size_t script_no);
 process_result_t run_command(scene_state_t *ss, const tele_command_t *cmd);
 process_result_t process_command(scene_state_t *ss, exec_state_t *es,
                                  const tele_command_t *c);
+process_result_t process_compiled_command(scene_state_t *ss, exec_state_t *es,
+                                          const tele_compiled_command_t *cc,
+                                          const tele_command_t *c);
 
-void tele_tick(scene_state_t *ss, uint8_t);
+void tele_tick(scene_state_t *ss, uint16_t);
+int16_t tele_next_deadline(scene_state_t *ss);
 
 void clear_delays(scene_state_t *ss);
 
@@ -16,6 +16,13 @@ extern void tele_metro_reset(void);
 extern void tele_tr(uint8_t i, int16_t v);
 extern void tele_cv(uint8_t i, int16_t v, uint8_t s);
 extern void tele_cv_slew(uint8_t i, int16_t v);
+// the shape of the slews that follow (a slew_shape_t)
+extern void tele_cv_curve(uint8_t i, uint8_t shape);
+
+// called around the tele_cv, tele_cv_slew and tele_cv_off calls for one
+// script, which should reach the outputs on the same update
+extern void tele_cv_begin(void);
+extern void tele_cv_end(void);
 
 extern void tele_update_in(void);
 
@@ -42,8 +49,8 @@ extern bool tele_get_input_state(uint8_t);
 void tele_save_calibration(void);
 
 #ifdef TELETYPE_PROFILE
-void tele_profile_script(size_t);
-void tele_profile_delay(uint8_t);
+// free running clock used by the profiler, must be allowed to wrap
+uint32_t tele_profile_time(void);
 #endif
 
 #endif
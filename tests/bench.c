@@ -0,0 +1,234 @@
+// per op microbenchmarks, writes JSON to stdout
+//
+// every op and mod in tele_ops / tele_mods is run as a line with all of its
+// params set to 1 (and a post command of `X 1` for mods), through
+// process_command so that constant folding doesn't remove the work, followed
+// by a set of whole lines timed through parse -> validate -> process_command,
+// and the time to match a token with the matcher in use (match_token) and the
+// perfect hash one (match_token_hash)
+//
+// usage: benchmark [ms per measurement]
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "match_token.h"
+#include "ops/op.h"
+#include "teletype.h"
+
+static const char *lines[] = {
+    "X 1",
+    "X ADD X 1",
+    "CV 1 N ADD X 7",
+    "TR.P 1",
+    "IF GT X 100: X 0",
+    "L 1 4: CV I V 1",
+    "P.NEXT",
+    "Y WRAP ADD Y 1 0 15",
+    "CV 2 VV RRAND 0 500",
+    "DEL 100: TR.P 2",
+};
+
+static scene_state_t ss;
+static uint32_t min_ns = 20000000;
+
+static uint64_t now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+static void reset_scene(void) {
+    ss_init(&ss);
+    clear_delays(&ss);
+}
+
+// lines run as if they were entered in live mode
+static void init_exec(exec_state_t *es) {
+    es_init(es);
+    es_push(es);
+    es_set_script_number(es, TEMP_SCRIPT);
+    es_set_line_number(es, 0);
+}
+
+// run the command until at least min_ns has elapsed, returns ns per call
+static double time_command(const tele_command_t *cmd) {
+    uint64_t calls = 0, elapsed = 0, batch = 16;
+
+    reset_scene();
+    while (elapsed < min_ns) {
+        uint64_t start = now_ns();
+        for (uint64_t i = 0; i < batch; i++) {
+            exec_state_t es;
+            init_exec(&es);
+            process_command(&ss, &es, cmd);
+        }
+        elapsed += now_ns() - start;
+        calls += batch;
+        batch *= 2;
+    }
+
+    return (double)elapsed / calls;
+}
+
+static bool build(const char *text, tele_command_t *cmd) {
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    return parse(text, cmd, error_msg) == E_OK &&
+           validate(cmd, error_msg) == E_OK;
+}
+
+static void bench_line(const char *name, const char *kind, const char *text,
+                       bool *first) {
+    tele_command_t cmd;
+
+    printf("%s\n    {\"name\": \"%s\", \"kind\": \"%s\", ", *first ? "" : ",",
+           name, kind);
+    *first = false;
+
+    if (build(text, &cmd))
+        printf("\"line\": \"%s\", \"ns\": %.1f}", text, time_command(&cmd));
+    else
+        printf("\"line\": \"%s\", \"ns\": null}", text);
+    fflush(stdout);
+}
+
+static void bench_ops(void) {
+    char text[64];
+    bool first = true;
+
+    printf("  \"ops\": [");
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const tele_op_t *op = tele_ops[i];
+
+        strcpy(text, op->name);
+        for (uint8_t p = 0; p < op->params; p++) strcat(text, " 1");
+        bench_line(op->name, "get", text, &first);
+
+        if (op->set) {
+            strcat(text, " 1");
+            bench_line(op->name, "set", text, &first);
+        }
+    }
+    printf("\n  ],\n");
+}
+
+static void bench_mods(void) {
+    char text[64];
+    bool first = true;
+
+    printf("  \"mods\": [");
+    for (size_t i = 0; i < E_MOD__LENGTH; i++) {
+        const tele_mod_t *mod = tele_mods[i];
+
+        strcpy(text, mod->name);
+        for (uint8_t p = 0; p < mod->params; p++) strcat(text, " 1");
+        strcat(text, ": X 1");
+        bench_line(mod->name, "mod", text, &first);
+    }
+    printf("\n  ],\n");
+}
+
+static void bench_pipeline(void) {
+    const size_t count = sizeof(lines) / sizeof(lines[0]);
+
+    printf("  \"lines\": [");
+    for (size_t l = 0; l < count; l++) {
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        tele_command_t cmd;
+        uint64_t parse_ns = 0, validate_ns = 0, process_ns = 0;
+        uint64_t calls = 0;
+
+        reset_scene();
+        while (parse_ns + validate_ns + process_ns < min_ns) {
+            uint64_t t0 = now_ns();
+            parse(lines[l], &cmd, error_msg);
+            uint64_t t1 = now_ns();
+            validate(&cmd, error_msg);
+            uint64_t t2 = now_ns();
+            exec_state_t es;
+            init_exec(&es);
+            process_command(&ss, &es, &cmd);
+            uint64_t t3 = now_ns();
+
+            parse_ns += t1 - t0;
+            validate_ns += t2 - t1;
+            process_ns += t3 - t2;
+            calls++;
+        }
+
+        printf("%s\n    {\"line\": \"%s\", \"parse_ns\": %.1f, "
+               "\"validate_ns\": %.1f, \"process_ns\": %.1f, "
+               "\"total_ns\": %.1f}",
+               l ? "," : "", lines[l], (double)parse_ns / calls,
+               (double)validate_ns / calls, (double)process_ns / calls,
+               (double)(parse_ns + validate_ns + process_ns) / calls);
+        fflush(stdout);
+    }
+    printf("\n  ]\n");
+}
+
+// every op and mod name, and some numbers and misses
+static const char *other_tokens[] = { "0", "1", "-1", "100", "16384", "-8000",
+                                      "XX", "CV.X", "P.NEXTT", "1A" };
+
+typedef bool (*matcher_t)(const char *token, const size_t len,
+                          tele_data_t *out);
+
+// returns ns per token
+static double time_matcher(matcher_t matcher) {
+    const size_t other = sizeof(other_tokens) / sizeof(other_tokens[0]);
+    const size_t count = E_OP__LENGTH + E_MOD__LENGTH + other;
+    uint64_t tokens = 0, elapsed = 0;
+    volatile int16_t sink = 0;
+
+    while (elapsed < min_ns) {
+        uint64_t start = now_ns();
+        for (size_t i = 0; i < count; i++) {
+            const char *token;
+            if (i < E_OP__LENGTH)
+                token = tele_ops[i]->name;
+            else if (i < E_OP__LENGTH + E_MOD__LENGTH)
+                token = tele_mods[i - E_OP__LENGTH]->name;
+            else
+                token = other_tokens[i - E_OP__LENGTH - E_MOD__LENGTH];
+
+            tele_data_t data;
+            if (matcher(token, strlen(token), &data)) sink = data.value;
+        }
+        elapsed += now_ns() - start;
+        tokens += count;
+    }
+    (void)sink;
+
+    return (double)elapsed / tokens;
+}
+
+static void bench_match_token(void) {
+#ifdef MATCH_TOKEN_HASH
+    const char *matcher = "hash";
+#else
+    const char *matcher = "ragel";
+#endif
+    printf("  \"match_token\": {\"matcher\": \"%s\", \"ns\": %.1f, "
+           "\"hash_ns\": %.1f},\n",
+           matcher, time_matcher(match_token), time_matcher(match_token_hash));
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) min_ns = atoi(argv[1]) * 1000000;
+
+    printf("{\n");
+    bench_ops();
+    bench_mods();
+    bench_match_token();
+    bench_pipeline();
+    printf("}\n");
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "cv_out_tests.h"
+
+#include "greatest/greatest.h"
+
+#include "io.h"
+#include "teletype.h"
+
+static scene_state_t ss;
+
+// replaces script 1 with lines, and runs it
+TEST run_lines(size_t count, const char *lines[]) {
+    ASSERT_EQ(load_script(&ss, 0, count, lines), E_OK);
+    cv_outputs_clear();
+    run_script(&ss, 0);
+    PASS();
+}
+
+TEST cv_out_should_batch_a_chord() {
+    ss_init(&ss);
+    const char *lines[] = { "CV 1 V 1", "CV 2 V 2", "CV 3 V 3", "CV 4 V 4" };
+    CHECK_CALL(run_lines(4, lines));
+    ASSERT_EQ(cv_outputs.batches, 1);
+    ASSERT_EQ(cv_outputs.calls, 4);
+    ASSERT_EQ(cv_outputs.unbatched, 0);
+    for (uint8_t i = 0; i < 4; i++)
+        ASSERT_EQ(cv_outputs.value[i], ss.variables.cv[i]);
+
+    // nothing changed, nothing to send
+    const char *none[] = { "X CV 1" };
+    CHECK_CALL(run_lines(1, none));
+    ASSERT_EQ(cv_outputs.batches, 0);
+    PASS();
+}
+
+TEST cv_out_should_send_the_last_value() {
+    ss_init(&ss);
+    const char *lines[] = { "L 1 10: CV 1 I", "CV.SET 2 5", "CV 2 6" };
+    CHECK_CALL(run_lines(3, lines));
+    ASSERT_EQ(cv_outputs.calls, 2);
+    ASSERT_EQ(cv_outputs.value[0], 10);
+    ASSERT_EQ(cv_outputs.value[1], 6);
+    ASSERT_EQ(ss.cv_out.writes, 2);
+    ASSERT_EQ(ss.cv_out.commits, 1);
+    PASS();
+}
+
+TEST cv_out_should_keep_the_slew_of_a_value() {
+    ss_init(&ss);
+    const char *lines[] = { "CV.SLEW 1 100", "CV 1 5", "CV.SLEW 1 200",
+                            "CV.SLEW 2 300" };
+    CHECK_CALL(run_lines(4, lines));
+    ASSERT_EQ(cv_outputs.value_slew[0], 100);
+    ASSERT_EQ(cv_outputs.slew[0], 200);
+    ASSERT_EQ(cv_outputs.slew[1], 300);
+
+    // a value set later uses the later slew
+    const char *later[] = { "CV.SLEW 1 100", "CV 1 5", "CV.SLEW 1 200",
+                            "CV 1 6" };
+    CHECK_CALL(run_lines(4, later));
+    ASSERT_EQ(cv_outputs.value_slew[0], 200);
+    ASSERT_EQ(cv_outputs.value[0], 6);
+
+    // as does the value CV.OFF sets
+    const char *off[] = { "CV 1 5", "CV.OFF 1 10" };
+    CHECK_CALL(run_lines(2, off));
+    ASSERT_EQ(cv_outputs.off[0], 10);
+    ASSERT_EQ(cv_outputs.value[0], 5);
+    ASSERT_EQ(cv_outputs.calls, 2);
+    PASS();
+}
+
+TEST cv_out_should_batch_across_scripts() {
+    ss_init(&ss);
+    const char *two[] = { "CV 2 2" };
+    ASSERT_EQ(load_script(&ss, 1, 1, two), E_OK);
+    const char *lines[] = { "CV 1 1", "SCRIPT 2", "CV 3 3" };
+    CHECK_CALL(run_lines(3, lines));
+    ASSERT_EQ(cv_outputs.batches, 1);
+    ASSERT_EQ(cv_outputs.calls, 3);
+
+    // and the delays due on a tick
+    const char *delays[] = { "DEL 1: CV 1 5", "DEL 1: CV 2 6" };
+    CHECK_CALL(run_lines(2, delays));
+    ASSERT_EQ(cv_outputs.batches, 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(cv_outputs.batches, 1);
+    ASSERT_EQ(cv_outputs.calls, 2);
+    ASSERT_EQ(cv_outputs.unbatched, 0);
+    PASS();
+}
+
+SUITE(cv_out_suite) {
+    RUN_TEST(cv_out_should_batch_a_chord);
+    RUN_TEST(cv_out_should_send_the_last_value);
+    RUN_TEST(cv_out_should_keep_the_slew_of_a_value);
+    RUN_TEST(cv_out_should_batch_across_scripts);
+}
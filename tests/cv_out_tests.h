@@ -0,0 +1,8 @@
+#ifndef _CV_OUT_TESTS_H_
+#define _CV_OUT_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(cv_out_suite);
+
+#endif
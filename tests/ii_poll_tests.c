@@ -0,0 +1,127 @@
+#include "ii_poll_tests.h"
+
+#include "greatest/greatest.h"
+
+#include "io.h"
+#include "ops/telex.h"
+#include "teletype.h"
+
+static scene_state_t ss;
+
+// runs a line as if it was typed in, and returns its value (or 0)
+static int16_t run_line(const char *line) {
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse(line, &cmd, error_msg);
+    process_result_t result = run_command(&ss, &cmd);
+    return result.has_value ? result.value : 0;
+}
+
+// clears the bus log, and sets the reply to every read
+static void reply(int16_t value) {
+    loopback_clear();
+    loopback.reply[0] = (uint16_t)value >> 8;
+    loopback.reply[1] = value & 0xff;
+}
+
+TEST ii_poll_should_read_from_the_cache() {
+    ss_init(&ss);
+    run_line("TI.IN.POLL 1 1");
+    ASSERT_EQ(run_line("TI.IN.POLL 1"), 1);
+    ASSERT_EQ(run_line("TI.PARAM.POLL 1"), 0);
+
+    // the first tick reads it
+    reply(1234);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(loopback.count, 2);
+    ASSERT_EQ(loopback.messages[0].addr, TI);
+    ASSERT_EQ(loopback.messages[0].data[0], 4);
+    ASSERT(loopback.messages[1].rx);
+
+    // and reading it doesn't touch the bus
+    reply(99);
+    ASSERT_EQ(run_line("TI.IN 1"), 1234);
+    ASSERT_EQ(loopback.count, 0);
+    ASSERT_EQ(ss.ii_poll.hits, 1);
+
+    // but other inputs and modes still do
+    ASSERT_EQ(run_line("TI.IN 2"), 99);
+    ASSERT_EQ(run_line("TI.IN.QT 1"), 99);
+    ASSERT_EQ(run_line("TI.PARAM 1"), 99);
+    ASSERT_EQ(loopback.count, 6);
+
+    // as do polled inputs once polling is stopped
+    run_line("TI.POLL 0");
+    ASSERT_EQ(run_line("TI.IN 1"), 99);
+    tele_tick(&ss, 100);
+    ASSERT_EQ(loopback.count, 8);
+    PASS();
+}
+
+TEST ii_poll_should_refresh_each_period() {
+    ss_init(&ss);
+    run_line("TI.POLL 20");
+    run_line("TI.PARAM.POLL 5 1");
+    ASSERT_EQ(run_line("TI.PARAM.AGE 5"), -1);
+
+    reply(1);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(loopback.messages[0].addr, TI + 1);
+    ASSERT_EQ(loopback.messages[0].data[0], 0);
+    ASSERT_EQ(run_line("TI.PARAM.AGE 5"), 0);
+    ASSERT_EQ(tele_next_deadline(&ss), 20);
+
+    reply(2);
+    tele_tick(&ss, 15);
+    ASSERT_EQ(loopback.count, 0);
+    ASSERT_EQ(run_line("TI.PARAM.AGE 5"), 15);
+    ASSERT_EQ(run_line("TI.PARAM 5"), 1);
+    ASSERT_EQ(tele_next_deadline(&ss), 5);
+
+    tele_tick(&ss, 5);
+    ASSERT_EQ(loopback.count, 2);
+    ASSERT_EQ(run_line("TI.PARAM 5"), 2);
+    ASSERT_EQ(run_line("TI.PARAM.AGE 5"), 0);
+
+    // an input that isn't polled has no age
+    ASSERT_EQ(run_line("TI.IN.AGE 5"), -1);
+    run_line("TI.PARAM.POLL 5 0");
+    ASSERT_EQ(run_line("TI.PARAM.AGE 5"), -1);
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+    PASS();
+}
+
+TEST ii_poll_should_spread_reads() {
+    ss_init(&ss);
+    run_line("L 1 4: TI.IN.POLL I 1");
+    run_line("L 1 4: TI.PARAM.POLL I 1");
+    ASSERT_EQ(ss.ii_poll.count, 8);
+
+    reply(0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.ii_poll.reads, II_POLL_BATCH);
+    ASSERT_EQ(tele_next_deadline(&ss), 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.ii_poll.reads, 8);
+    ASSERT_EQ(loopback.count, 16);
+
+    // each gets a turn
+    for (uint8_t i = 0; i < 8; i++) ASSERT(ss.ii_poll.entries[i].valid);
+    PASS();
+}
+
+TEST ii_poll_should_fill_up() {
+    ss_init(&ss);
+    run_line("L 1 32: TI.IN.POLL I 1");
+    ASSERT_EQ(ss.ii_poll.count, II_POLL_SIZE);
+    ASSERT_EQ(run_line("TI.IN.POLL 16"), 1);
+    ASSERT_EQ(run_line("TI.IN.POLL 17"), 0);
+    PASS();
+}
+
+SUITE(ii_poll_suite) {
+    RUN_TEST(ii_poll_should_read_from_the_cache);
+    RUN_TEST(ii_poll_should_refresh_each_period);
+    RUN_TEST(ii_poll_should_spread_reads);
+    RUN_TEST(ii_poll_should_fill_up);
+}
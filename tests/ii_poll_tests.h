@@ -0,0 +1,8 @@
+#ifndef _II_POLL_TESTS_H_
+#define _II_POLL_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(ii_poll_suite);
+
+#endif
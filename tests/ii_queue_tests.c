@@ -0,0 +1,257 @@
+#include "ii_queue_tests.h"
+
+#include "greatest/greatest.h"
+
+#include "ii.h"
+#include "io.h"
+#include "ops/telex.h"
+#include "teletype.h"
+
+static scene_state_t ss;
+
+// replaces script 1 with lines, and runs it
+TEST run_lines(size_t n, const char *lines[]) {
+    ASSERT_EQ(load_script(&ss, 0, n, lines), E_OK);
+    // the bus latency is kept for the test to set
+    uint16_t latency = loopback.latency;
+    loopback_clear();
+    loopback.latency = latency;
+    run_script(&ss, 0);
+    PASS();
+}
+
+TEST ii_queue_should_send_last_value() {
+    ss_init(&ss);
+    const char *lines[] = { "L 1 16: TO.CV 1 I" };
+    CHECK_CALL(run_lines(1, lines));
+    ASSERT_EQ(loopback.count, 1);
+    ASSERT_EQ(loopback.messages[0].addr, TO);
+    ASSERT_EQ(loopback.messages[0].length, 4);
+    ASSERT_EQ(loopback.messages[0].data[0], TO_CV);
+    ASSERT_EQ(loopback.messages[0].data[1], 0);
+    ASSERT_EQ(loopback.messages[0].data[3], 16);
+    ASSERT_EQ(ss.ii.coalesced, 15);
+    PASS();
+}
+
+TEST ii_queue_should_keep_ports_apart() {
+    ss_init(&ss);
+    const char *lines[] = { "L 1 4: TO.CV I I", "L 1 4: TO.CV I ADD I 10" };
+    CHECK_CALL(run_lines(2, lines));
+    ASSERT_EQ(loopback.count, 4);
+    for (uint8_t i = 0; i < 4; i++) {
+        ASSERT_EQ(loopback.messages[i].data[1], i);
+        ASSERT_EQ(loopback.messages[i].data[3], i + 11);
+    }
+    PASS();
+}
+
+TEST ii_queue_should_keep_order_around_commands() {
+    ss_init(&ss);
+
+    // the pulse has to see the first time
+    const char *lines[] = { "TO.TR.TIME 1 50", "TO.TR.PULSE 1",
+                            "TO.TR.TIME 1 100" };
+    CHECK_CALL(run_lines(3, lines));
+    ASSERT_EQ(loopback.count, 3);
+    ASSERT_EQ(loopback.messages[0].data[0], TO_TR_TIME);
+    ASSERT_EQ(loopback.messages[0].data[3], 50);
+    ASSERT_EQ(loopback.messages[1].data[0], TO_TR_PULSE);
+    ASSERT_EQ(loopback.messages[2].data[3], 100);
+
+    // and a gate set high then low is a trigger
+    const char *gate[] = { "TO.TR 1 1", "TO.TR 1 0" };
+    CHECK_CALL(run_lines(2, gate));
+    ASSERT_EQ(loopback.count, 2);
+    PASS();
+}
+
+TEST ii_queue_should_flush_before_reads() {
+    ss_init(&ss);
+    const char *lines[] = { "TO.CV 1 5", "X TI.IN 1" };
+    CHECK_CALL(run_lines(2, lines));
+    ASSERT_EQ(loopback.count, 3);
+    // only the query to the TXi goes ahead of the read, the TO.CV waits for
+    // the end of the script
+    ASSERT_EQ(loopback.messages[0].addr, TI);
+    ASSERT(loopback.messages[1].rx);
+    ASSERT_EQ(loopback.messages[2].addr, TO);
+    ASSERT_EQ(loopback.messages[2].data[0], TO_CV);
+
+    // the queue only waits until the end of the script
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    loopback_clear();
+    parse("TO.CV 2 5", &cmd, error_msg);
+    process_command(&ss, &es, &cmd);
+    ASSERT_EQ(loopback.count, 0);
+    ii_flush(&ss.ii);
+    ASSERT_EQ(loopback.count, 1);
+    PASS();
+}
+
+TEST ii_queue_should_flush_when_full() {
+    ss_init(&ss);
+    const char *lines[] = { "L 1 40: TO.TR.PULSE I" };
+    CHECK_CALL(run_lines(1, lines));
+    ASSERT_EQ(loopback.count, 40);
+    for (uint8_t i = 0; i < 40; i++) {
+        ASSERT_EQ(loopback.messages[i].addr, TO + i / 4);
+        ASSERT_EQ(loopback.messages[i].data[1], i % 4);
+    }
+    ASSERT_EQ(ss.ii.sent, 40);
+    PASS();
+}
+
+TEST ii_queue_should_flush_delays() {
+    ss_init(&ss);
+    const char *lines[] = { "DEL 1: TO.CV 1 3", "DEL 1: TO.CV 1 4" };
+    CHECK_CALL(run_lines(2, lines));
+    ASSERT_EQ(loopback.count, 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(loopback.count, 1);
+    ASSERT_EQ(loopback.messages[0].data[3], 4);
+    PASS();
+}
+
+TEST ii_queue_should_send_notes_first() {
+    ss_init(&ss);
+    const char *lines[] = { "L 1 16: TO.CV I 100", "JF.NOTE 100 100" };
+    loopback.latency = 90;
+    CHECK_CALL(run_lines(2, lines));
+    ASSERT_EQ(loopback.count, 17);
+    ASSERT_EQ(loopback.messages[0].addr, JF_ADDR);
+    uint8_t length = loopback.messages[0].length;
+    ASSERT_EQ(loopback.messages[0].time, (length + 1) * 90);
+    ASSERT_EQ(loopback.time, (length + 1) * 90 + 16 * 5 * 90);
+
+    // unless JF is set to a lower priority than the TXo
+    ii_set_device(&ss.ii, JF_ADDR, II_PRIORITY_LOW, 0);
+    for (uint8_t i = 0; i < 4; i++)
+        ii_set_device(&ss.ii, TO + i, II_PRIORITY_NORMAL, 0);
+    CHECK_CALL(run_lines(2, lines));
+    ASSERT_EQ(loopback.messages[16].addr, JF_ADDR);
+    loopback.latency = 0;
+    PASS();
+}
+
+TEST ii_queue_should_send_in_order_for_each_address() {
+    ss_init(&ss);
+    const char *lines[] = { "TO.CV 5 1", "TO.TR.TIME 1 50", "TO.TR.PULSE 1",
+                            "JF.NOTE 100 100" };
+    CHECK_CALL(run_lines(4, lines));
+    ASSERT_EQ(loopback.count, 4);
+
+    // JF goes first, then the time goes with the pulse, TO.CV 5 is on another
+    // TXo and is just a value
+    ASSERT_EQ(loopback.messages[0].addr, JF_ADDR);
+    ASSERT_EQ(loopback.messages[1].data[0], TO_TR_TIME);
+    ASSERT_EQ(loopback.messages[2].data[0], TO_TR_PULSE);
+    ASSERT_EQ(loopback.messages[3].addr, TO + 1);
+
+    // at the same priority, the time still goes ahead of the note with the
+    // pulse
+    ii_set_device(&ss.ii, JF_ADDR, II_PRIORITY_NORMAL, 0);
+    ii_set_device(&ss.ii, TO, II_PRIORITY_NORMAL, 0);
+    CHECK_CALL(run_lines(4, lines));
+    ASSERT_EQ(loopback.messages[0].data[0], TO_TR_TIME);
+    ASSERT_EQ(loopback.messages[1].data[0], TO_TR_PULSE);
+    ASSERT_EQ(loopback.messages[2].addr, JF_ADDR);
+    PASS();
+}
+
+TEST ii_queue_should_limit_rate() {
+    ss_init(&ss);
+    ii_set_device(&ss.ii, TO, II_PRIORITY_NORMAL, 2);
+    const char *lines[] = { "L 1 4: TO.TR.PULSE I", "TO.TR.PULSE 5" };
+    CHECK_CALL(run_lines(2, lines));
+    ASSERT_EQ(loopback.count, 3);
+    ASSERT_EQ(loopback.messages[2].addr, TO + 1);
+    ASSERT_EQ(ss.ii.count, 2);
+    ASSERT_EQ(tele_next_deadline(&ss), II_RATE_WINDOW);
+
+    tele_tick(&ss, 5);
+    ASSERT_EQ(loopback.count, 3);
+    tele_tick(&ss, 5);
+    ASSERT_EQ(loopback.count, 5);
+    ASSERT_EQ(loopback.messages[3].data[1], 2);
+    ASSERT_EQ(loopback.messages[4].data[1], 3);
+    ASSERT_EQ(ss.ii.late, 2);
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+
+    // reads don't wait, and don't let the messages held back through (the
+    // TXo's window is used up by the two sent late)
+    const char *read[] = { "TO.TR.PULSE 1", "TO.TR.PULSE 2", "TO.TR.PULSE 3",
+                           "X TI.IN 1" };
+    CHECK_CALL(run_lines(4, read));
+    ASSERT_EQ(loopback.count, 2);
+    ASSERT_EQ(loopback.messages[0].addr, TI);
+    ASSERT(loopback.messages[1].rx);
+    ASSERT_EQ(ss.ii.count, 3);
+
+    // nor does polling
+    ss_init(&ss);
+    ii_set_device(&ss.ii, TO, II_PRIORITY_NORMAL, 1);
+    const char *poll[] = { "TI.IN.POLL 1 1", "TO.TR.PULSE 1", "TO.TR.PULSE 2" };
+    CHECK_CALL(run_lines(3, poll));
+    ASSERT_EQ(ss.ii.count, 1);
+    const uint32_t reads = ss.ii_poll.reads;
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.ii_poll.reads, reads + 1);
+    ASSERT_EQ(ss.ii.count, 1);
+    tele_tick(&ss, II_RATE_WINDOW);
+    ASSERT_EQ(ss.ii.count, 0);
+    ASSERT_EQ(ss.ii.late, 1);
+    PASS();
+}
+
+TEST ii_queue_should_set_devices_with_ops() {
+    ss_init(&ss);
+    ASSERT_EQ(ii_get_priority(&ss.ii, JF_ADDR), II_PRIORITY_HIGH);
+    ASSERT_EQ(ii_get_priority(&ss.ii, TO), II_PRIORITY_LOW);
+    ASSERT_EQ(ii_get_rate(&ss.ii, TO), 0);
+
+    // TO is 96, priorities are clamped
+    const char *lines[] = { "II.PRI 96 -1", "II.RATE 96 2", "X II.PRI 96",
+                            "Y II.RATE 96", "L 1 4: TO.TR.PULSE I" };
+    CHECK_CALL(run_lines(5, lines));
+    ASSERT_EQ(ss.variables.x, II_PRIORITY_HIGH);
+    ASSERT_EQ(ss.variables.y, 2);
+    ASSERT_EQ(loopback.count, 2);
+    ASSERT_EQ(ss.ii.count, 2);
+
+    // a new scene starts with the defaults
+    ss_init(&ss);
+    ASSERT_EQ(ii_get_priority(&ss.ii, TO), II_PRIORITY_LOW);
+    ASSERT_EQ(ii_get_rate(&ss.ii, TO), 0);
+    PASS();
+}
+
+TEST ii_queue_should_drop_when_held_back() {
+    ss_init(&ss);
+    ii_set_device(&ss.ii, TO, II_PRIORITY_NORMAL, 1);
+    const char *lines[] = { "L 1 40: TO.TR.PULSE 1" };
+    CHECK_CALL(run_lines(1, lines));
+    ASSERT_EQ(loopback.count, 1);
+    ASSERT_EQ(ss.ii.queued, 40);
+    ASSERT_EQ(ss.ii.dropped, 40 - II_QUEUE_SIZE - 1);
+    ASSERT_EQ(ss.ii.count, II_QUEUE_SIZE);
+    PASS();
+}
+
+SUITE(ii_queue_suite) {
+    RUN_TEST(ii_queue_should_send_last_value);
+    RUN_TEST(ii_queue_should_keep_ports_apart);
+    RUN_TEST(ii_queue_should_keep_order_around_commands);
+    RUN_TEST(ii_queue_should_flush_before_reads);
+    RUN_TEST(ii_queue_should_flush_when_full);
+    RUN_TEST(ii_queue_should_flush_delays);
+    RUN_TEST(ii_queue_should_send_notes_first);
+    RUN_TEST(ii_queue_should_send_in_order_for_each_address);
+    RUN_TEST(ii_queue_should_limit_rate);
+    RUN_TEST(ii_queue_should_set_devices_with_ops);
+    RUN_TEST(ii_queue_should_drop_when_held_back);
+}
@@ -0,0 +1,100 @@
+#include "io.h"
+
+#include <string.h>
+
+#include "teletype_io.h"
+
+loopback_t loopback;
+cv_outputs_t cv_outputs;
+
+error_t load_script(scene_state_t *ss, uint8_t n, size_t count,
+                    const char *lines[]) {
+    ss_clear_script(ss, n);
+    for (size_t i = 0; i < count; i++) {
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        error_t status = parse(lines[i], &cmd, error_msg);
+        if (status == E_OK) status = validate(&cmd, error_msg);
+        if (status != E_OK) return status;
+        ss_overwrite_script_command(ss, n, i, &cmd);
+    }
+    return E_OK;
+}
+
+void loopback_clear() {
+    memset(&loopback, 0, sizeof(loopback));
+}
+
+void cv_outputs_clear() {
+    memset(&cv_outputs, 0, sizeof(cv_outputs));
+}
+
+static void loopback_add(uint8_t addr, uint8_t *data, uint8_t l, bool rx) {
+    loopback.time += loopback.latency * (l + 1);
+    if (loopback.count < LOOPBACK_SIZE) {
+        loopback_message_t *m = &loopback.messages[loopback.count];
+        m->addr = addr;
+        m->length = l;
+        memcpy(m->data, data, l > 8 ? 8 : l);
+        m->rx = rx;
+        m->time = loopback.time;
+    }
+    loopback.count++;
+}
+
+void tele_metro_updated() {}
+void tele_metro_reset() {}
+void tele_tr(uint8_t i, int16_t v) {}
+void tele_cv(uint8_t i, int16_t v, uint8_t s) {
+    cv_outputs.value[i] = v;
+    cv_outputs.value_slew[i] = cv_outputs.slew[i];
+    cv_outputs.calls++;
+    if (!cv_outputs.open) cv_outputs.unbatched++;
+}
+void tele_cv_slew(uint8_t i, int16_t v) {
+    cv_outputs.slew[i] = v;
+    cv_outputs.calls++;
+    if (!cv_outputs.open) cv_outputs.unbatched++;
+}
+void tele_cv_curve(uint8_t i, uint8_t shape) {
+    cv_outputs.curve[i] = shape;
+    cv_outputs.calls++;
+    if (!cv_outputs.open) cv_outputs.unbatched++;
+}
+void tele_cv_begin() {
+    cv_outputs.open = true;
+}
+void tele_cv_end() {
+    cv_outputs.open = false;
+    cv_outputs.batches++;
+}
+void tele_update_in(void) {}
+void tele_has_delays(bool i) {}
+void tele_has_stack(bool i) {}
+void tele_cv_off(uint8_t i, int16_t v) {
+    cv_outputs.off[i] = v;
+    cv_outputs.calls++;
+    if (!cv_outputs.open) cv_outputs.unbatched++;
+}
+void tele_ii_tx(uint8_t addr, uint8_t *data, uint8_t l) {
+    loopback_add(addr, data, l, false);
+}
+void tele_ii_rx(uint8_t addr, uint8_t *data, uint8_t l) {
+    memcpy(data, loopback.reply, l > 8 ? 8 : l);
+    loopback_add(addr, data, l, true);
+}
+void tele_scene(uint8_t i) {}
+void tele_pattern_updated() {}
+void tele_kill() {}
+void tele_mute() {}
+void tele_vars_updated() {}
+bool tele_get_input_state(uint8_t n) {
+    return false;
+}
+void tele_save_calibration() {}
+
+#ifdef TELETYPE_PROFILE
+uint32_t tele_profile_time() {
+    return 0;
+}
+#endif
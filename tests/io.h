@@ -0,0 +1,59 @@
+#ifndef _IO_H_
+#define _IO_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "teletype.h"
+
+// replaces script n with lines, returns the error of the first line that
+// doesn't parse or validate (the script is then left part written), or E_OK
+error_t load_script(scene_state_t *ss, uint8_t n, size_t count,
+                    const char *lines[]);
+
+// the stand-in i2c bus in io.c keeps what's sent on it, in order, and answers
+// reads with the reply. Each message takes latency us for each byte (and one
+// for the address), so tests can see when it would have arrived.
+#define LOOPBACK_SIZE 64
+
+typedef struct {
+    uint8_t addr;
+    uint8_t length;
+    uint8_t data[8];
+    bool rx;
+    uint32_t time;  // us from the clear to the end of the message
+} loopback_message_t;
+
+typedef struct {
+    loopback_message_t messages[LOOPBACK_SIZE];
+    uint16_t count;  // may be more than LOOPBACK_SIZE, the rest aren't kept
+    uint8_t reply[8];
+    uint16_t latency;
+    uint32_t time;
+} loopback_t;
+
+extern loopback_t loopback;
+
+void loopback_clear(void);
+
+// the stand-in CV outputs keep the last value, slew, curve and offset set on
+// each (and the slew when the value was set), and count the calls made, and
+// the ones made outside of a batch
+typedef struct {
+    int16_t value[4];
+    int16_t value_slew[4];
+    int16_t slew[4];
+    int16_t off[4];
+    uint8_t curve[4];
+    uint16_t calls;
+    uint16_t batches;
+    uint16_t unbatched;
+    bool open;
+} cv_outputs_t;
+
+extern cv_outputs_t cv_outputs;
+
+void cv_outputs_clear(void);
+
+#endif
@@ -38,7 +38,59 @@ TEST match_token_should_return_mod() {
     PASS();
 }
 
+// The perfect hash matcher must agree with the ragel one, on every op and mod
+// name and on numbers and things that aren't tokens, while reading no further
+// than the length it's given.
+TEST match_token_hash_should_match_ragel() {
+    const char* tokens[] = { "0",      "1",     "-1",    "010",   "09",
+                             "32767",  "32768", "-32768", "-32769",
+                             "99999999999", "-",  "--1",  "1A",    "A1",
+                             "",       "X.",    "CV.",   "P.NEXTT", "|",
+                             "||",     "&",     "^",     "~",     "$" };
+    char buf[64];
+
+    for (size_t i = 0; i < E_OP__LENGTH + E_MOD__LENGTH; i++) {
+        const char* text = i < E_OP__LENGTH ? tele_ops[i]->name
+                                            : tele_mods[i - E_OP__LENGTH]->name;
+        tele_data_t data;
+        ASSERT_EQm(text, match_token_hash(text, strlen(text), &data), true);
+        ASSERT_EQm(text, data.tag, i < E_OP__LENGTH ? OP : MOD);
+        ASSERT_EQm(text, data.value,
+                   (int16_t)(i < E_OP__LENGTH ? i : i - E_OP__LENGTH));
+
+        // a prefix of a longer token
+        strcpy(buf, text);
+        strcat(buf, "X");
+        tele_data_t prefix;
+        ASSERT_EQm(text, match_token_hash(buf, strlen(text), &prefix), true);
+        ASSERT_EQm(text, prefix.tag, data.tag);
+        ASSERT_EQm(text, prefix.value, data.value);
+    }
+
+    for (size_t i = 0; i < sizeof(tokens) / sizeof(tokens[0]); i++) {
+        const char* text = tokens[i];
+        const size_t len = strlen(text);
+        tele_data_t ragel, hash;
+        bool ragel_result = match_token(text, len, &ragel);
+        bool hash_result = match_token_hash(text, len, &hash);
+        ASSERT_EQm(text, hash_result, ragel_result);
+        if (!ragel_result) continue;
+        ASSERT_EQm(text, hash.tag, ragel.tag);
+        // strtol doesn't clamp to int32_t where a long is 64 bits
+        if (strlen(text) < 10) ASSERT_EQm(text, hash.value, ragel.value);
+    }
+
+    tele_data_t data;
+    ASSERT(match_token_hash("99999999999", 11, &data));
+    ASSERT_EQ(data.value, INT16_MAX);
+    ASSERT(match_token_hash("-99999999999", 12, &data));
+    ASSERT_EQ(data.value, INT16_MIN);
+
+    PASS();
+}
+
 SUITE(match_token_suite) {
     RUN_TEST(match_token_should_return_op);
     RUN_TEST(match_token_should_return_mod);
+    RUN_TEST(match_token_hash_should_match_ragel);
 }
@@ -109,8 +109,8 @@ TEST mod_stack_size() {
         // execute func
         const tele_command_t sub_command = { .length = 1,
                                              .separator = 0,
-                                             .data = { { .tag = OP,
-                                                         .value = E_OP_A } } };
+                                             .tags = { OP },
+                                             .values = { E_OP_A } };
         mod->func(&ss, &es, &cs, &sub_command);
 
         // check that the stack has the correct number of items in it
@@ -119,9 +119,62 @@ TEST mod_stack_size() {
     PASS();
 }
 
+// Check every pure op only depends on its params, as they are evaluated with no
+// scene or exec state when a command is compiled
+TEST pure_ops() {
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const tele_op_t *op = tele_ops[i];
+        if (!op_is_pure(i)) continue;
+
+        ASSERTm(op->name, op->set == NULL);
+        ASSERTm(op->name, op->returns);
+
+        for (int16_t v = -3; v <= 3; v++) {
+            command_state_t cs1, cs2;
+            cs_init(&cs1);
+            cs_init(&cs2);
+            for (int j = 0; j < op->params; j++) {
+                cs_push(&cs1, v + j);
+                cs_push(&cs2, v + j);
+            }
+
+            op->get(op->data, NULL, NULL, &cs1);
+            op->get(op->data, NULL, NULL, &cs2);
+
+            ASSERT_EQm(op->name, cs_stack_size(&cs1), 1);
+            ASSERT_EQm(op->name, cs_pop(&cs1), cs_pop(&cs2));
+        }
+    }
+    PASS();
+}
+
+// Check the effects and costs in op_list.h make sense
+TEST op_info() {
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        const tele_op_info_t *info = &tele_op_info[i];
+        ASSERTm(tele_ops[i]->name, info->effect < OP_EFFECT__LENGTH);
+        ASSERTm(tele_ops[i]->name, info->cost < OP_COST__LENGTH);
+        // reading or writing a value can't be free of effects
+        if (tele_ops[i]->set) ASSERTm(tele_ops[i]->name, !op_is_pure(i));
+        if (!tele_ops[i]->returns)
+            ASSERTm(tele_ops[i]->name, info->effect > OP_EFFECT_READ);
+        // I2C ops talk to another module
+        if (info->cost == OP_COST_BUS)
+            ASSERTm(tele_ops[i]->name, info->effect >= OP_EFFECT_READ);
+    }
+    for (size_t i = 0; i < E_MOD__LENGTH; i++) {
+        ASSERT_EQm(tele_mods[i]->name, tele_mod_info[i].effect,
+                   OP_EFFECT_CONTROL);
+        ASSERTm(tele_mods[i]->name, tele_mod_info[i].cost < OP_COST__LENGTH);
+    }
+    PASS();
+}
+
 SUITE(op_mod_suite) {
     RUN_TEST(unique_ops);
     RUN_TEST(unique_mods);
     RUN_TEST(op_stack_size);
     RUN_TEST(mod_stack_size);
+    RUN_TEST(pure_ops);
+    RUN_TEST(op_info);
 }
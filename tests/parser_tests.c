@@ -190,8 +190,8 @@ TEST parser_should_return_op() {
         error_t result = parse(text, &cmd, error_msg);
         ASSERT_EQm(text, result, E_OK);
         ASSERT_EQm(text, cmd.length, 1);
-        ASSERT_EQm(text, cmd.data[0].tag, OP);
-        ASSERT_EQm(text, cmd.data[0].value, (int16_t)i);
+        ASSERT_EQm(text, command_tag(&cmd, 0), OP);
+        ASSERT_EQm(text, command_value(&cmd, 0), (int16_t)i);
     }
     PASS();
 }
@@ -206,8 +206,8 @@ TEST parser_should_return_mod() {
         error_t result = parse(text, &cmd, error_msg);
         ASSERT_EQm(text, result, E_OK);
         ASSERT_EQm(text, cmd.length, 1);
-        ASSERT_EQm(text, cmd.data[0].tag, MOD);
-        ASSERT_EQm(text, cmd.data[0].value, (int16_t)i);
+        ASSERT_EQm(text, command_tag(&cmd, 0), MOD);
+        ASSERT_EQm(text, command_value(&cmd, 0), (int16_t)i);
     }
     PASS();
 }
@@ -232,10 +232,30 @@ TEST print_command_corpus_should_be_unchanged() {
     PASS();
 }
 
+// Check that setting a word in a packed command leaves its neighbours alone,
+// including the one sharing its tag nibble
+TEST command_words_should_pack() {
+    const tele_word_t tags[] = { NUMBER, OP, MOD, PRE_SEP, SUB_SEP };
+    tele_command_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+
+    for (uint8_t i = 0; i < COMMAND_MAX_LENGTH; i++)
+        command_set(&cmd, i, tags[i % 5], i * 1000 - 8000);
+    for (uint8_t i = 0; i < COMMAND_MAX_LENGTH; i++)
+        command_set(&cmd, i, tags[(i + 2) % 5], command_value(&cmd, i) - 1);
+
+    for (uint8_t i = 0; i < COMMAND_MAX_LENGTH; i++) {
+        ASSERT_EQ(command_tag(&cmd, i), tags[(i + 2) % 5]);
+        ASSERT_EQ(command_value(&cmd, i), i * 1000 - 8001);
+    }
+    PASS();
+}
+
 SUITE(parser_suite) {
     RUN_TEST(should_parse_and_validate);
     RUN_TEST(parser_test_sub_commands);
     RUN_TEST(parser_should_return_op);
     RUN_TEST(parser_should_return_mod);
     RUN_TEST(print_command_corpus_should_be_unchanged);
+    RUN_TEST(command_words_should_pack);
 }
@@ -205,6 +205,13 @@ TEST test_PN() {
     char* test4[3] = { "P.N 0", "PN 0 0 4", "P 0" };
     CHECK_CALL(process_helper(3, test4, 4));
 
+    // stepping back through an empty pattern stays inside it
+    char* test5[3] = { "P.L 0", "P.PREV", "P.I" };
+    CHECK_CALL(process_helper(3, test5, 0));
+
+    char* test6[3] = { "PN.L 1 0", "PN.PREV 1", "PN.I 1" };
+    CHECK_CALL(process_helper(3, test6, 0));
+
     PASS();
 }
 
@@ -247,6 +254,60 @@ TEST test_Q() {
     PASS();
 }
 
+TEST test_Q_aggregates() {
+    scene_state_t ss;
+    ss_init(&ss);
+
+    char* test1[6] = { "Q.N 4", "Q 3", "Q -2", "Q 7", "Q 1", "Q.MIN" };
+    CHECK_CALL(process_helper_state(&ss, 6, test1, -2));
+    char* test2[1] = { "Q.MAX" };
+    CHECK_CALL(process_helper_state(&ss, 1, test2, 7));
+    char* test3[1] = { "Q.SUM" };
+    CHECK_CALL(process_helper_state(&ss, 1, test3, 9));
+
+    // 3 and -2 leave the queue, then 7
+    char* test4[3] = { "Q 5", "Q 4", "Q.MIN" };
+    CHECK_CALL(process_helper_state(&ss, 3, test4, 1));
+    char* test5[2] = { "Q 2", "Q.MAX" };
+    CHECK_CALL(process_helper_state(&ss, 2, test5, 5));
+
+    // values beyond Q.N are remembered when it grows
+    char* test6[2] = { "Q.N 7", "Q.MIN" };
+    CHECK_CALL(process_helper_state(&ss, 2, test6, -2));
+
+    char* test7[2] = { "Q.AVG 30000", "Q.SUM" };
+    CHECK_CALL(process_helper_state(&ss, 2, test7, 32767));
+
+    // compare against summing the values pushed, for every length
+    int16_t pushed[Q_LENGTH * 4];
+    uint32_t r = 1;
+    for (int16_t n = 1; n <= Q_LENGTH; n += 7) {
+        queue_init(&ss.variables.q);
+        queue_set_length(&ss.variables.q, n);
+        for (int i = 0; i < Q_LENGTH * 4; i++) {
+            r = r * 1103515245 + 12345;
+            pushed[i] = (int16_t)((r >> 16) % 2001) - 1000;
+            queue_push(&ss.variables.q, pushed[i]);
+
+            int32_t sum = 0;
+            int16_t min = 0, max = 0;
+            for (int j = 0; j < n; j++) {
+                int16_t v = j <= i ? pushed[i - j] : 0;
+                sum += v;
+                if (j == 0 || v < min) min = v;
+                if (j == 0 || v > max) max = v;
+            }
+            ASSERT_EQ(sum, queue_sum(&ss.variables.q));
+            ASSERT_EQ(min, queue_min(&ss.variables.q));
+            ASSERT_EQ(max, queue_max(&ss.variables.q));
+            ASSERT_EQ(i >= n - 1 ? pushed[i - n + 1] : 0,
+                      queue_get(&ss.variables.q));
+        }
+    }
+
+    PASS();
+}
+
 TEST test_X() {
     char* test1[2] = { "X 0", "X" };
     CHECK_CALL(process_helper(2, test1, 0));
@@ -297,6 +358,393 @@ TEST test_blank_command() {
     PASS();
 }
 
+// runs each line through both process_command and process_compiled_command
+// (in separate scenes) and asserts that the results and variables match
+TEST compiled_helper(size_t n, char* lines[]) {
+    scene_state_t ss1 = {}, ss2 = {};  // zero the calibration data too
+    ss_init(&ss1);
+    ss_init(&ss2);
+    exec_state_t es1, es2;
+    es_init(&es1);
+    es_push(&es1);
+    es_variables(&es1)->script_number = 1;
+    es_init(&es2);
+    es_push(&es2);
+    es_variables(&es2)->script_number = 1;
+
+    for (size_t i = 0; i < n; i++) {
+        tele_command_t cmd;
+        char error_msg[TELE_ERROR_MSG_LENGTH];
+        error_t error = parse(lines[i], &cmd, error_msg);
+        if (error != E_OK) { FAIL(); }
+        if (validate(&cmd, error_msg) != E_OK) { FAIL(); }
+
+        ss_overwrite_script_command(&ss2, 0, 0, &cmd);
+
+        process_result_t r1 = process_command(&ss1, &es1, &cmd);
+        process_result_t r2 = process_compiled_command(
+            &ss2, &es2, ss_get_compiled_command(&ss2, 0, 0),
+            ss_get_script_command(&ss2, 0, 0));
+
+        ASSERT_EQm(lines[i], r1.has_value, r2.has_value);
+        ASSERT_EQm(lines[i], r1.value, r2.value);
+        ASSERTm(lines[i], memcmp(&ss1.variables, &ss2.variables,
+                                 sizeof(scene_variables_t)) == 0);
+        ASSERTm(lines[i], memcmp(&ss1.patterns, &ss2.patterns,
+                                 ss_patterns_size()) == 0);
+    }
+
+    PASS();
+}
+
+TEST test_compiled_commands() {
+    char* test1[4] = { "X 10; Y 20; Z 30", "ADD X ADD Y Z", "X", "" };
+    CHECK_CALL(compiled_helper(4, test1));
+
+    char* test2[4] = { "P.N 1; P 0 5; P.PUSH 7", "P 0 P 1", "P.HERE",
+                       "PN 1 2 ADD PN 1 0 3" };
+    CHECK_CALL(compiled_helper(4, test2));
+
+    char* test3[5] = { "L 1 4: A ADD A I", "A", "IF GT A 5: B 1; C 2",
+                       "ELSE: B 3", "ADD B C" };
+    CHECK_CALL(compiled_helper(5, test3));
+
+    char* test4[3] = { "Q 1; Q 2; Q 3", "Q.N 3", "Q.AVG" };
+    CHECK_CALL(compiled_helper(3, test4));
+
+    char* test5[5] = { "X N ADD 12 7", "Y ADD X MUL 2 3", "A JI 3 2",
+                       "IF EQ 1 1: B VV 150", "ADD A ADD B ADD X Y" };
+    CHECK_CALL(compiled_helper(5, test5));
+
+    PASS();
+}
+
+TEST test_constant_folding() {
+    scene_state_t ss;
+    ss_init(&ss);
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    char print_buf[100];
+
+    char* test1 = "CV 1 N ADD 12 7";
+    if (parse(test1, &cmd, error_msg) != E_OK) { FAIL(); }
+    if (validate(&cmd, error_msg) != E_OK) { FAIL(); }
+    ss_overwrite_script_command(&ss, 0, 0, &cmd);
+
+    // the compiled form is "19 1 CV" with N ADD folded to a number...
+    const tele_compiled_command_t* cc = ss_get_compiled_command(&ss, 0, 0);
+    ASSERT_EQ(cc->length, 3);
+    ASSERT_EQ(cc->words[0].op, COMPILED_NUMBER);
+    // ...but the stored command still prints back unchanged
+    print_command(ss_get_script_command(&ss, 0, 0), print_buf);
+    ASSERT_STR_EQ(test1, print_buf);
+
+    // X isn't pure, so nothing can be folded
+    char* test2 = "CV 1 N ADD X 7";
+    if (parse(test2, &cmd, error_msg) != E_OK) { FAIL(); }
+    if (validate(&cmd, error_msg) != E_OK) { FAIL(); }
+    ss_overwrite_script_command(&ss, 0, 0, &cmd);
+    ASSERT_EQ(ss_get_compiled_command(&ss, 0, 0)->length, 6);
+
+    PASS();
+}
+
+// parses and runs a single line from script 1
+static int16_t run_line(scene_state_t* ss, char* line) {
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    es_variables(&es)->script_number = 1;
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse(line, &cmd, error_msg);
+    return process_command(ss, &es, &cmd).value;
+}
+
+TEST test_delays() {
+    scene_state_t ss = {};
+    ss_init(&ss);
+
+    // delays run in due order, regardless of the order they were added
+    run_line(&ss, "DEL 30: X 3");
+    run_line(&ss, "DEL 10: X 1");
+    run_line(&ss, "DEL 20: X 2");
+    ASSERT_EQ(ss.delay.count, 3);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 1);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 2);
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 3);
+    ASSERT_EQ(ss.delay.count, 0);
+
+    // delays that are due at the same time run in the order they were added
+    run_line(&ss, "DEL 5: X 1");
+    run_line(&ss, "DEL 5: X 2");
+    tele_tick(&ss, 10);
+    ASSERT_EQ(ss.variables.x, 2);
+
+    // a delay added by a delayed command waits for the next tick
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("DEL 1: X 4", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 1, 0, &cmd);
+    run_line(&ss, "DEL 1: SCRIPT 2");
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 2);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 4);
+
+    // once every slot is in use further delays are dropped and counted
+    for (int i = 0; i < DELAY_SIZE + 2; i++) run_line(&ss, "DEL 1: Y ADD Y 1");
+    ASSERT_EQ(ss.delay.count, DELAY_SIZE);
+    ASSERT_EQ(ss_delay_dropped(&ss), 2);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.y, DELAY_SIZE);
+
+    // delayed commands keep THIS and I from where they were added, and don't
+    // touch the TEMP script
+    parse("DEL 1: Y SCRIPT", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 1, 0, &cmd);
+    parse("A 5", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, TEMP_SCRIPT, 0, &cmd);
+    run_script(&ss, 1);
+    run_line(&ss, "L 1 3: DEL 1: Z ADD Z I");
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.y, 2);
+    ASSERT_EQ(ss.variables.z, 6);
+    ASSERT_EQ(ss_get_script_len(&ss, TEMP_SCRIPT), 1);
+    ASSERT_EQ(ss_get_script_command(&ss, TEMP_SCRIPT, 0)->length, 2);
+    ss.variables.z = 0;
+
+    // DEL.CLR cancels everything
+    run_line(&ss, "DEL 1: Z 1");
+    run_line(&ss, "DEL.CLR");
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.z, 0);
+    ASSERT_EQ(ss.delay.count, 0);
+
+    // a delayed INIT or INIT.SCENE frees every slot, including its own, and
+    // all of them can be used again
+    char* inits[] = { "DEL 1: INIT", "DEL 1: INIT.SCENE" };
+    for (int n = 0; n < 2; n++) {
+        run_line(&ss, inits[n]);
+        tele_tick(&ss, 1);
+        ASSERT_EQ(ss.delay.free_count, DELAY_SIZE);
+        for (int i = 0; i < DELAY_SIZE; i++)
+            run_line(&ss, "DEL 1: Y ADD Y 1");
+        ASSERT_EQ(ss_delay_dropped(&ss), 0);
+        tele_tick(&ss, 1);
+        ASSERT_EQ(ss.variables.y, DELAY_SIZE);
+        ASSERT_EQ(ss.delay.free_count, DELAY_SIZE);
+    }
+
+    PASS();
+}
+
+TEST test_next_deadline() {
+    scene_state_t ss = {};
+    ss_init(&ss);
+
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+
+    run_line(&ss, "DEL 300: X 1");
+    run_line(&ss, "DEL 1000: X 2");
+    ASSERT_EQ(tele_next_deadline(&ss), 300);
+
+    // TR.TIME is 100 by default
+    run_line(&ss, "TR.PULSE 1");
+    ASSERT_EQ(tele_next_deadline(&ss), 100);
+
+    // jump straight to each deadline
+    tele_tick(&ss, tele_next_deadline(&ss));
+    ASSERT_EQ(tele_next_deadline(&ss), 200);
+    tele_tick(&ss, tele_next_deadline(&ss));
+    ASSERT_EQ(ss.variables.x, 1);
+    ASSERT_EQ(tele_next_deadline(&ss), 700);
+    tele_tick(&ss, tele_next_deadline(&ss));
+    ASSERT_EQ(ss.variables.x, 2);
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+    ASSERT_EQ(ss.variables.time, 1000);
+
+    PASS();
+}
+
+TEST test_budget() {
+    scene_state_t ss = {};
+    ss_init(&ss);
+
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("W LT X 100: X ADD X 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 0, 0, &cmd);
+    parse("Y 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 0, 1, &cmd);
+
+    // without a budget the loop runs to the end
+    run_script(&ss, 0);
+    ASSERT_EQ(ss.variables.x, 100);
+    ASSERT_EQ(ss.variables.y, 1);
+
+    // each time round the loop is 6 ops, so 60 is 10 times round per tick
+    run_line(&ss, "BUDGET 1 60");
+    ASSERT_EQ(run_line(&ss, "BUDGET 1"), 60);
+    ss.variables.x = 0;
+    ss.variables.y = 0;
+    run_script(&ss, 0);
+    ASSERT_EQ(ss.variables.x, 10);
+    ASSERT_EQ(ss.variables.y, 0);
+    ASSERT_EQ(tele_next_deadline(&ss), 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 20);
+    for (int i = 0; i < 8; i++) tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 100);
+    // the budget ran out before the loop could see that it's done
+    ASSERT_EQ(ss.variables.y, 0);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.y, 1);
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+
+    // running the script again starts it over
+    ss.variables.x = 0;
+    run_script(&ss, 0);
+    ss.variables.x = 50;
+    run_script(&ss, 0);
+    ASSERT_EQ(ss.variables.x, 60);
+
+    // KILL abandons it
+    run_line(&ss, "KILL");
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+    tele_tick(&ss, 1);
+    ASSERT_EQ(ss.variables.x, 60);
+
+    // SCRIPT runs the loop to the end
+    ss.variables.x = 0;
+    ss.variables.y = 0;
+    run_line(&ss, "SCRIPT 1");
+    ASSERT_EQ(ss.variables.x, 100);
+    ASSERT_EQ(ss.variables.y, 1);
+
+    PASS();
+}
+
+TEST test_budget_stats() {
+    scene_state_t ss = {};
+    ss_init(&ss);
+
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    parse("L 1 100: X ADD X 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 0, 0, &cmd);
+    parse("Y 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 0, 1, &cmd);
+
+    // with BUDGET.ABORT the script stops as soon as the budget is spent, even
+    // inside an L loop
+    run_line(&ss, "BUDGET 1 50");
+    run_line(&ss, "BUDGET.ABORT 1 1");
+    ASSERT_EQ(run_line(&ss, "BUDGET.ABORT 1"), 1);
+    run_script(&ss, 0);
+    ASSERT(ss.variables.x > 0 && ss.variables.x < 20);
+    ASSERT_EQ(ss.variables.y, 0);
+    ASSERT_EQ(run_line(&ss, "BUDGET.OVER 1"), 1);
+    // the rest of the command it's in still runs, as it would after BREAK
+    const int16_t ops = run_line(&ss, "BUDGET.OPS 1");
+    ASSERT(ops > 50 && ops <= 53);
+    ASSERT_EQ(tele_next_deadline(&ss), -1);
+
+    // without a budget it's only counted
+    run_line(&ss, "BUDGET 1 0");
+    run_script(&ss, 0);
+    ASSERT_EQ(ss.variables.y, 1);
+    ASSERT_EQ(run_line(&ss, "BUDGET.OVER 1"), 1);
+    ASSERT_EQ(run_line(&ss, "BUDGET.OPS 1"), 302);
+
+    // high water marks
+    parse("SCRIPT 3", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 1, 0, &cmd);
+    parse("X ADD ADD A B ADD C D", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 2, 0, &cmd);
+    parse("W LT Z 7: Z ADD Z 1", &cmd, error_msg);
+    ss_overwrite_script_command(&ss, 2, 1, &cmd);
+    run_script(&ss, 1);
+    ASSERT_EQ(run_line(&ss, "BUDGET.DEPTH 2"), 2);
+    ASSERT_EQ(run_line(&ss, "BUDGET.STACK 2"), 3);
+    ASSERT_EQ(run_line(&ss, "BUDGET.W 2"), 7);
+    ASSERT_EQ(run_line(&ss, "BUDGET.DEPTH 1"), 1);
+    ASSERT_EQ(run_line(&ss, "BUDGET.W 1"), 0);
+
+    run_line(&ss, "BUDGET.CLR");
+    ASSERT_EQ(run_line(&ss, "BUDGET.OVER 1"), 0);
+    ASSERT_EQ(run_line(&ss, "BUDGET.DEPTH 2"), 0);
+
+    PASS();
+}
+
+// scenes don't share any state, so they can be run side by side
+TEST test_instances() {
+    scene_state_t ss1 = {}, ss2 = {};
+    ss_init(&ss1);
+    ss_init(&ss2);
+
+    // the same seed gives the same numbers, however the calls are interleaved
+    int16_t r1[4], r2[4];
+    for (int i = 0; i < 4; i++) r1[i] = run_line(&ss1, "RAND 10000");
+    for (int i = 0; i < 4; i++) {
+        r2[i] = run_line(&ss2, "RAND 10000");
+        run_line(&ss1, "TOSS");
+    }
+    for (int i = 0; i < 4; i++) ASSERT_EQ(r1[i], r2[i]);
+
+    run_line(&ss1, "CHAOS.ALG 3");
+    run_line(&ss1, "CHAOS 7");
+    ASSERT_EQ(run_line(&ss2, "CHAOS.ALG"), 0);
+    ASSERT_EQ(run_line(&ss1, "CHAOS.ALG"), 3);
+
+    // INIT keeps the RNG going
+    run_line(&ss2, "INIT");
+    ASSERT(run_line(&ss2, "RAND 10000") != r2[0] ||
+           run_line(&ss2, "RAND 10000") != r2[1]);
+
+    PASS();
+}
+
+TEST test_dirty() {
+    scene_state_t ss = {};
+    ss_init(&ss);
+    ASSERT_EQ(ss_get_dirty(&ss), SS_DIRTY_ALL);
+    ASSERT_EQ(ss_get_dirty_slot(&ss), -1);
+
+    // running ops only marks the sections they change
+    ss_clear_dirty(&ss, 5);
+    run_line(&ss, "A 7");
+    run_line(&ss, "P.N 2");
+    ASSERT_EQ(ss_get_dirty(&ss), 0);
+    run_line(&ss, "P 3 100");
+    run_line(&ss, "PN.NEXT 1");
+    ASSERT_EQ(ss_get_dirty(&ss), SS_DIRTY_PATTERN(1) | SS_DIRTY_PATTERN(2));
+
+    ss_clear_dirty(&ss, 5);
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+    ASSERT_EQ(parse("TR.P 1", &cmd, error_msg), E_OK);
+    ss_insert_script_command(&ss, 2, 0, &cmd);
+    ss_toggle_script_comment(&ss, METRO_SCRIPT, 0);
+    ASSERT_EQ(ss_get_dirty(&ss),
+              SS_DIRTY_SCRIPT(2) | SS_DIRTY_SCRIPT(METRO_SCRIPT));
+    ASSERT_EQ(ss_get_dirty_slot(&ss), 5);
+
+    ss_clear_dirty(&ss, 5);
+    ss_clear_script(&ss, TEMP_SCRIPT);
+    run_line(&ss, "INIT.P.ALL");
+    ASSERT_EQ(ss_get_dirty(&ss),
+              SS_DIRTY_SCRIPT(TEMP_SCRIPT) | SS_DIRTY_PATTERN(0) |
+                  SS_DIRTY_PATTERN(1) | SS_DIRTY_PATTERN(2) |
+                  SS_DIRTY_PATTERN(3));
+
+    PASS();
+}
+
 SUITE(process_suite) {
     RUN_TEST(test_numbers);
     RUN_TEST(test_ADD);
@@ -306,8 +754,17 @@ SUITE(process_suite) {
     RUN_TEST(test_O);
     RUN_TEST(test_P);
     RUN_TEST(test_Q);
+    RUN_TEST(test_Q_aggregates);
     RUN_TEST(test_PN);
     RUN_TEST(test_X);
     RUN_TEST(test_sub_commands);
     RUN_TEST(test_blank_command);
+    RUN_TEST(test_compiled_commands);
+    RUN_TEST(test_constant_folding);
+    RUN_TEST(test_delays);
+    RUN_TEST(test_next_deadline);
+    RUN_TEST(test_budget);
+    RUN_TEST(test_budget_stats);
+    RUN_TEST(test_instances);
+    RUN_TEST(test_dirty);
 }
@@ -0,0 +1,189 @@
+#include "scene_binary_tests.h"
+
+#include <string.h>
+
+#include "greatest/greatest.h"
+
+#include "scene_binary.h"
+#include "teletype.h"
+
+#define TEXT_LINES 32
+#define TEXT_CHARS 32
+
+static char *lines[][3] = {
+    { "X ADD X 1", "CV 1 N ADD X 7", "TR.P 1" },
+    { "IF GT X 100: X 0", "L 1 4: CV I V 1; TR.P I", NULL },
+    { "P.NEXT", "Y -32768", "Z 32767" },
+};
+
+static scene_state_t ss;
+static char text[TEXT_LINES][TEXT_CHARS];
+static uint8_t data[8192];
+
+static void build_scene(void) {
+    ss_init(&ss);
+    memset(text, 0, sizeof(text));
+
+    for (size_t s = 0; s < 3; s++) {
+        for (size_t l = 0; l < 3 && lines[s][l]; l++) {
+            tele_command_t cmd;
+            char error_msg[TELE_ERROR_MSG_LENGTH];
+            parse(lines[s][l], &cmd, error_msg);
+            ss_overwrite_script_command(&ss, s * 4, l, &cmd);
+        }
+    }
+    ss_toggle_script_comment(&ss, 4, 1);
+
+    ss_set_pattern_len(&ss, 1, 5);
+    ss_set_pattern_idx(&ss, 1, 3);
+    ss_set_pattern_wrap(&ss, 1, 0);
+    ss_set_pattern_start(&ss, 1, 2);
+    ss_set_pattern_end(&ss, 1, 40);
+    for (size_t i = 0; i < 5; i++) ss_set_pattern_val(&ss, 1, i, i * -1000);
+    ss_set_pattern_val(&ss, 3, 63, 16383);
+
+    strcpy(text[0], "A SCENE");
+    strcpy(text[2], "WITH A BLANK LINE");
+}
+
+static size_t write_scene(void) {
+    scene_binary_buffer_t b = { .data = data, .size = sizeof(data) };
+    scene_binary_writer_t w = scene_binary_buffer_writer(&b);
+    size_t length = 0;
+    scene_binary_write(&ss, &text[0][0], TEXT_LINES, TEXT_CHARS, &w, &length);
+    return length;
+}
+
+static scene_binary_result_t read_scene(scene_state_t *into, char *into_text,
+                                        size_t length) {
+    scene_binary_buffer_t b = { .data = data, .size = length };
+    scene_binary_reader_t r = scene_binary_buffer_reader(&b);
+    return scene_binary_read(into, into_text, TEXT_LINES, TEXT_CHARS, &r);
+}
+
+TEST round_trip() {
+    build_scene();
+    const size_t length = write_scene();
+
+    static scene_state_t copy;
+    char copy_text[TEXT_LINES][TEXT_CHARS];
+    ss_init(&copy);
+    ASSERT_EQ(read_scene(&copy, &copy_text[0][0], length), SCENE_BINARY_OK);
+
+    for (size_t s = 0; s < TEMP_SCRIPT; s++) {
+        ASSERT_EQ(ss_get_script_len(&ss, s), ss_get_script_len(&copy, s));
+        for (size_t l = 0; l < ss_get_script_len(&ss, s); l++) {
+            char a[64], b[64];
+            print_command(ss_get_script_command(&ss, s, l), a);
+            print_command(ss_get_script_command(&copy, s, l), b);
+            ASSERT_STR_EQ(a, b);
+            ASSERT_EQ(ss_get_script_comment(&ss, s, l),
+                      ss_get_script_comment(&copy, s, l));
+            ASSERT_EQ(memcmp(ss_get_script_command(&ss, s, l),
+                          ss_get_script_command(&copy, s, l),
+                          sizeof(tele_command_t)), 0);
+        }
+    }
+    ASSERT_EQ(memcmp(ss_patterns_ptr(&ss), ss_patterns_ptr(&copy),
+                  ss_patterns_size()), 0);
+    ASSERT_EQ(memcmp(text, copy_text, sizeof(text)), 0);
+
+    // the copy has been compiled, and runs
+    exec_state_t es;
+    es_init(&es);
+    es_push(&es);
+    es_set_script_number(&es, 0);
+    es_set_line_number(&es, 0);
+    process_command(&copy, &es, ss_get_script_command(&copy, 0, 0));
+    ASSERT_EQ(copy.variables.x, 1);
+
+    PASS();
+}
+
+TEST compact() {
+    ss_init(&ss);
+    memset(text, 0, sizeof(text));
+    ASSERT(write_scene() < 64);
+
+    build_scene();
+    ASSERT(write_scene() < 256);
+
+    PASS();
+}
+
+TEST text_only() {
+    build_scene();
+    const size_t length = write_scene();
+
+    char copy_text[TEXT_LINES][TEXT_CHARS];
+    ASSERT_EQ(read_scene(NULL, &copy_text[0][0], length), SCENE_BINARY_OK);
+    ASSERT_EQ(memcmp(text, copy_text, sizeof(text)), 0);
+
+    PASS();
+}
+
+TEST truncated() {
+    build_scene();
+    const size_t length = write_scene();
+
+    for (size_t l = 0; l < length; l++) {
+        static scene_state_t copy;
+        char copy_text[TEXT_LINES][TEXT_CHARS];
+        ss_init(&copy);
+        ASSERT(read_scene(&copy, &copy_text[0][0], l) != SCENE_BINARY_OK);
+    }
+
+    // and a writer that runs out of room says so
+    uint8_t small[32];
+    scene_binary_buffer_t b = { .data = small, .size = sizeof(small) };
+    scene_binary_writer_t w = scene_binary_buffer_writer(&b);
+    ASSERT_EQ(scene_binary_write(&ss, &text[0][0], TEXT_LINES, TEXT_CHARS, &w,
+                                 NULL),
+              SCENE_BINARY_FULL);
+
+    PASS();
+}
+
+TEST headers() {
+    build_scene();
+    size_t length = write_scene();
+
+    data[0] = 'X';
+    ASSERT_EQ(read_scene(&ss, NULL, length), SCENE_BINARY_NOT_SCENE);
+    data[0] = 'T';
+
+    data[3] = SCENE_BINARY_VERSION + 1;
+    ASSERT_EQ(read_scene(&ss, NULL, length), SCENE_BINARY_NEWER);
+    data[3] = SCENE_BINARY_VERSION;
+
+    // an unknown section is skipped
+    memmove(&data[10], &data[4], length - 4);
+    const uint8_t unknown[] = { 99, 3, 0, 'a', 'b', 'c' };
+    memcpy(&data[4], unknown, sizeof(unknown));
+    length += sizeof(unknown);
+    ASSERT_EQ(read_scene(&ss, NULL, length), SCENE_BINARY_OK);
+
+    PASS();
+}
+
+TEST unknown_op() {
+    build_scene();
+    const size_t length = write_scene();
+
+    // header, section header, name count, then the length of the first name
+    ASSERT_EQ(data[4], SCENE_BINARY_DICTIONARY);
+    const size_t name = 4 + 3 + 1;
+    memset(&data[name + 1], '`', data[name]);
+    ASSERT_EQ(read_scene(&ss, NULL, length), SCENE_BINARY_UNKNOWN_OP);
+
+    PASS();
+}
+
+SUITE(scene_binary_suite) {
+    RUN_TEST(round_trip);
+    RUN_TEST(compact);
+    RUN_TEST(text_only);
+    RUN_TEST(truncated);
+    RUN_TEST(headers);
+    RUN_TEST(unknown_op);
+}
@@ -0,0 +1,8 @@
+#ifndef _SCENE_BINARY_TESTS_H_
+#define _SCENE_BINARY_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(scene_binary_suite);
+
+#endif
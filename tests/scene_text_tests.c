@@ -0,0 +1,359 @@
+#include "scene_text_tests.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "greatest/greatest.h"
+
+#include "ops/op.h"
+#include "scene_text.h"
+#include "teletype.h"
+
+#define TEXT_LINES 32
+#define TEXT_CHARS 32
+
+static scene_state_t ss;
+static char text[TEXT_LINES][TEXT_CHARS];
+
+// a stand in for the FAT file functions, writes go to a temporary file
+typedef struct {
+    FILE *file;
+    uint16_t writes;
+    uint16_t short_writes;  // writes of less than a whole buffer
+    uint16_t fail_after;    // writes before the disk is "full", 0 for never
+} file_t;
+
+static bool file_write(void *context, const uint8_t *data, uint16_t length) {
+    file_t *f = context;
+    if (f->fail_after && f->writes == f->fail_after) return false;
+    f->writes++;
+    if (length < SCENE_TEXT_BUFFER_SIZE) f->short_writes++;
+    return fwrite(data, 1, length, f->file) == length;
+}
+
+static size_t file_contents(file_t *f, char *out, size_t size) {
+    rewind(f->file);
+    size_t length = fread(out, 1, size - 1, f->file);
+    out[length] = 0;
+    return length;
+}
+
+static void build_scene(void) {
+    static char *lines[] = { "X ADD X 1", "IF GT X 100: X 0",
+                             "L 1 4: CV I V 1; TR.P I", "Y -32768",
+                             "TO.TR.PULSE.MUTE 1 1" };
+    ss_init(&ss);
+    memset(text, 0, sizeof(text));
+
+    for (size_t s = 0; s < 10; s++) {
+        for (size_t l = 0; l < s % SCRIPT_MAX_COMMANDS; l++) {
+            tele_command_t cmd;
+            char error_msg[TELE_ERROR_MSG_LENGTH];
+            parse(lines[(s + l) % 5], &cmd, error_msg);
+            ss_overwrite_script_command(&ss, s, l, &cmd);
+        }
+    }
+    for (size_t b = 0; b < PATTERN_COUNT; b++) {
+        ss_set_pattern_len(&ss, b, b * 10);
+        ss_set_pattern_start(&ss, b, b);
+        for (size_t i = 0; i < PATTERN_LENGTH; i++)
+            ss_set_pattern_val(&ss, b, i, (i * 997 + b) % 32768 - 16384);
+    }
+
+    strcpy(text[0], "A SCENE");
+    strcpy(text[3], "AFTER BLANK LINES");
+    memset(text[5], 'X', TEXT_CHARS);  // not terminated
+}
+
+// the scene as the exporter used to write it, a char at a time
+static void reference(char *out) {
+    char *p = out;
+    bool blank = false;
+    for (size_t l = 0; l < TEXT_LINES; l++) {
+        const size_t length = strlen(text[l]) < TEXT_CHARS ? strlen(text[l])
+                                                           : TEXT_CHARS;
+        if (length) {
+            memcpy(p, text[l], length);
+            p += length;
+            *p++ = '\n';
+            blank = false;
+        }
+        else if (!blank) {
+            *p++ = '\n';
+            blank = true;
+        }
+    }
+    for (int s = 0; s < 10; s++) {
+        p += sprintf(p, "\n\n#%c", s == 8 ? 'M' : s == 9 ? 'I' : '1' + s);
+        for (int l = 0; l < ss_get_script_len(&ss, s); l++) {
+            *p++ = '\n';
+            p += print_command(ss_get_script_command(&ss, s, l), p);
+        }
+    }
+    p += sprintf(p, "\n\n#P\n");
+    for (int b = 0; b < 4; b++)
+        p += sprintf(p, "%d\t", ss_get_pattern_len(&ss, b));
+    p[-1] = '\n';
+    for (int b = 0; b < 4; b++)
+        p += sprintf(p, "%d\t", ss_get_pattern_wrap(&ss, b));
+    p[-1] = '\n';
+    for (int b = 0; b < 4; b++)
+        p += sprintf(p, "%d\t", ss_get_pattern_start(&ss, b));
+    p[-1] = '\n';
+    for (int b = 0; b < 4; b++)
+        p += sprintf(p, "%d\t", ss_get_pattern_end(&ss, b));
+    p[-1] = '\n';
+    *p++ = '\n';
+    for (int l = 0; l < 64; l++)
+        for (int b = 0; b < 4; b++)
+            p += sprintf(p, "%d%c", ss_get_pattern_val(&ss, b, l),
+                         b == 3 ? '\n' : '\t');
+    *p = 0;
+}
+
+TEST scene_text_should_match_export() {
+    static char expected[16384], actual[16384];
+    static scene_text_writer_t w;
+    build_scene();
+    reference(expected);
+
+    file_t f = { .file = tmpfile() };
+    ASSERT(f.file);
+    scene_text_writer_init(&w, file_write, &f);
+    ASSERT(scene_text_write(&w, &ss, &text[0][0], TEXT_LINES, TEXT_CHARS));
+    const size_t length = file_contents(&f, actual, sizeof(actual));
+    fclose(f.file);
+
+    ASSERT_STR_EQ(expected, actual);
+    // only the last write is short
+    ASSERT_EQ(f.writes, (length + SCENE_TEXT_BUFFER_SIZE - 1) /
+                            SCENE_TEXT_BUFFER_SIZE);
+    ASSERT_EQ(f.short_writes, 1);
+    PASS();
+}
+
+TEST scene_text_should_stop_when_full() {
+    static scene_text_writer_t w;
+    build_scene();
+
+    file_t f = { .file = tmpfile(), .fail_after = 2 };
+    ASSERT(f.file);
+    scene_text_writer_init(&w, file_write, &f);
+    ASSERT_FALSE(
+        scene_text_write(&w, &ss, &text[0][0], TEXT_LINES, TEXT_CHARS));
+    fclose(f.file);
+    ASSERT_EQ(f.writes, 2);
+    PASS();
+}
+
+TEST scene_text_should_buffer_binary() {
+    static uint8_t expected[8192], actual[8192];
+    static scene_text_writer_t w;
+    build_scene();
+
+    scene_binary_buffer_t b = { .data = expected, .size = sizeof(expected) };
+    scene_binary_writer_t writer = scene_binary_buffer_writer(&b);
+    size_t length;
+    scene_binary_write(&ss, &text[0][0], TEXT_LINES, TEXT_CHARS, &writer,
+                       &length);
+
+    file_t f = { .file = tmpfile() };
+    ASSERT(f.file);
+    scene_text_writer_init(&w, file_write, &f);
+    writer = scene_text_binary_writer(&w);
+    scene_binary_write(&ss, &text[0][0], TEXT_LINES, TEXT_CHARS, &writer,
+                       NULL);
+    ASSERT(scene_text_flush(&w));
+    rewind(f.file);
+    ASSERT_EQ(fread(actual, 1, sizeof(actual), f.file), length);
+    fclose(f.file);
+    ASSERT_EQ(memcmp(expected, actual, length), 0);
+    PASS();
+}
+
+TEST words_should_fit() {
+    for (size_t i = 0; i < E_OP__LENGTH; i++) {
+        ASSERT_EQ(tele_ops[i]->name_length, strlen(tele_ops[i]->name));
+        ASSERT(tele_ops[i]->name_length < WORD_PRINT_MAX);
+    }
+    for (size_t i = 0; i < E_MOD__LENGTH; i++) {
+        ASSERT_EQ(tele_mods[i]->name_length, strlen(tele_mods[i]->name));
+        ASSERT(tele_mods[i]->name_length < WORD_PRINT_MAX);
+    }
+
+    char out[8];
+    ASSERT_EQ(print_number(-32768, out), 6);
+    ASSERT_EQ(memcmp(out, "-32768", 6), 0);
+    ASSERT_EQ(print_number(0, out), 1);
+    ASSERT_EQ(out[0], '0');
+    PASS();
+}
+
+// reads data in chunks of chunk bytes
+static uint16_t read_text(scene_state_t *into, char *into_text,
+                          const char *data, size_t length, size_t chunk,
+                          scene_text_error_t error, void *context) {
+    static scene_text_reader_t r;
+    scene_text_reader_init(&r, into, into_text, TEXT_LINES, TEXT_CHARS, error,
+                           context);
+    for (size_t i = 0; i < length; i += chunk)
+        scene_text_read(&r, (const uint8_t *)data + i,
+                        length - i < chunk ? length - i : chunk);
+    return scene_text_read_end(&r);
+}
+
+TEST scene_text_should_round_trip() {
+    static char data[16384], copy_text[TEXT_LINES][TEXT_CHARS];
+    static scene_state_t copy;
+    build_scene();
+    reference(data);
+
+    const size_t chunks[] = { 1, 7, 512, sizeof(data) };
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        ss_init(&copy);
+        ASSERT_EQ(read_text(&copy, &copy_text[0][0], data, strlen(data),
+                            chunks[c], NULL, NULL),
+                  0);
+
+        // runs of blank lines are written as one
+        ASSERT_STR_EQ(copy_text[0], text[0]);
+        ASSERT_STR_EQ(copy_text[1], "");
+        ASSERT_STR_EQ(copy_text[2], text[3]);
+        ASSERT_STR_EQ(copy_text[3], "");
+        ASSERT_EQ(memcmp(copy_text[4], text[5], TEXT_CHARS), 0);
+        for (size_t s = 0; s < 10; s++) {
+            ASSERT_EQ(ss_get_script_len(&ss, s), ss_get_script_len(&copy, s));
+            for (size_t l = 0; l < ss_get_script_len(&ss, s); l++)
+                ASSERT_EQ(memcmp(ss_get_script_command(&ss, s, l),
+                                 ss_get_script_command(&copy, s, l),
+                                 sizeof(tele_command_t)),
+                          0);
+        }
+        for (size_t b = 0; b < PATTERN_COUNT; b++) {
+            ASSERT_EQ(ss_get_pattern_len(&ss, b), ss_get_pattern_len(&copy, b));
+            ASSERT_EQ(ss_get_pattern_start(&ss, b),
+                      ss_get_pattern_start(&copy, b));
+            for (size_t i = 0; i < PATTERN_LENGTH; i++)
+                ASSERT_EQ(ss_get_pattern_val(&ss, b, i),
+                          ss_get_pattern_val(&copy, b, i));
+        }
+    }
+    PASS();
+}
+
+typedef struct {
+    uint16_t lines[8];
+    error_t status[8];
+    char message[8][TELE_ERROR_MSG_LENGTH];
+    uint8_t count;
+} errors_t;
+
+static void record_error(void *context, uint16_t line, error_t status,
+                         const char *message) {
+    errors_t *e = context;
+    if (e->count == 8) return;
+    e->lines[e->count] = line;
+    e->status[e->count] = status;
+    strcpy(e->message[e->count], message);
+    e->count++;
+}
+
+TEST scene_text_should_match_parse() {
+    static char *lines[] = { "X ADD X 1",
+                             "IF GT X 100: X 0",
+                             "L 1 4: CV I V 1; TR.P I",
+                             "  X   1  ",
+                             "PROB 50: TR.P 1",
+                             "y -32768",
+                             "FOO 1",
+                             "X 1:",
+                             "IF X:X 1",
+                             "X 1;X 2",
+                             "ADD 1",
+                             "X 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16",
+                             "CV 1 N ADD X 7",
+                             "X 12345; Y 7" };
+    const size_t count = sizeof(lines) / sizeof(lines[0]);
+
+    // one line per script, so that the failures don't shift the others, the
+    // scripts 1-8 and M only take 9 lines at a time
+    for (size_t i = 0; i < count; i += 9) {
+        static char data[1024];
+        char *end = data;
+        for (size_t n = i; n < count && n < i + 9; n++) {
+            const char section = n - i < 8 ? '1' + n - i : 'M';
+            end += sprintf(end, "#%c\n%s\n", section, lines[n]);
+        }
+
+        static scene_state_t copy;
+        ss_init(&copy);
+        errors_t e = {};
+        read_text(&copy, NULL, data, end - data, 3, record_error, &e);
+
+        uint8_t error = 0;
+        for (size_t n = i; n < count && n < i + 9; n++) {
+            tele_command_t cmd;
+            char error_msg[TELE_ERROR_MSG_LENGTH];
+            char upper[64];
+            for (size_t c = 0; c <= strlen(lines[n]); c++)
+                upper[c] = toupper(lines[n][c]);
+            error_t status = parse(upper, &cmd, error_msg);
+            if (status == E_OK) status = validate(&cmd, error_msg);
+
+            const uint8_t s = n - i < 8 ? n - i : METRO_SCRIPT;
+            if (status == E_OK) {
+                ASSERT_EQm(lines[n], ss_get_script_len(&copy, s), 1);
+                ASSERT_EQm(lines[n],
+                           memcmp(&cmd, ss_get_script_command(&copy, s, 0),
+                                  sizeof(cmd)),
+                           0);
+            }
+            else {
+                ASSERT_EQm(lines[n], ss_get_script_len(&copy, s), 0);
+                ASSERT(error < e.count);
+                ASSERT_EQm(lines[n], e.lines[error], (n - i) * 2 + 2);
+                ASSERT_EQm(lines[n], e.status[error], status);
+                ASSERT_STR_EQ(error_msg, e.message[error]);
+                error++;
+            }
+        }
+        ASSERT_EQ(error, e.count);
+    }
+    PASS();
+}
+
+TEST scene_text_should_report_sections() {
+    const char *data = "TITLE\n\n#1\nX 1\nBAR\n\n#Q\n#2\nX 2\n";
+    errors_t e = {};
+    static scene_state_t copy;
+    static char copy_text[TEXT_LINES][TEXT_CHARS];
+    ss_init(&copy);
+    ASSERT_EQ(read_text(&copy, &copy_text[0][0], data, strlen(data), 4,
+                        record_error, &e),
+              2);
+    ASSERT_EQ(e.lines[0], 5);
+    ASSERT_EQ(e.status[0], E_PARSE);
+    ASSERT_STR_EQ(e.message[0], "BAR");
+    ASSERT_EQ(e.lines[1], 7);
+    ASSERT_STR_EQ(e.message[1], "#Q");
+    ASSERT_STR_EQ(copy_text[0], "TITLE");
+    ASSERT_EQ(ss_get_script_len(&copy, 0), 1);
+    // nothing is read after an unknown section
+    ASSERT_EQ(ss_get_script_len(&copy, 1), 0);
+
+    // a last line without a newline is still read, checking needs no scene
+    ASSERT_EQ(read_text(NULL, NULL, "#1\nX 1", 6, 1, NULL, NULL), 0);
+    ASSERT_EQ(read_text(NULL, NULL, "#1\nADD 1", 7, 1, NULL, NULL), 1);
+    PASS();
+}
+
+SUITE(scene_text_suite) {
+    RUN_TEST(scene_text_should_match_export);
+    RUN_TEST(scene_text_should_stop_when_full);
+    RUN_TEST(scene_text_should_buffer_binary);
+    RUN_TEST(words_should_fit);
+    RUN_TEST(scene_text_should_round_trip);
+    RUN_TEST(scene_text_should_match_parse);
+    RUN_TEST(scene_text_should_report_sections);
+}
@@ -0,0 +1,8 @@
+#ifndef _SCENE_TEXT_TESTS_H_
+#define _SCENE_TEXT_TESTS_H_
+
+#include "greatest/greatest.h"
+
+SUITE_EXTERN(scene_text_suite);
+
+#endif
@@ -0,0 +1,124 @@
+#include "slew_tests.h"
+
+#include "greatest/greatest.h"
+
+#include "io.h"
+#include "slew.h"
+#include "teletype.h"
+
+// steps s until it stops, returns the number of steps and the value at the
+// middle step in mid
+static uint16_t run_slew(slew_t *s, uint16_t *mid) {
+    uint16_t n = 0;
+    const uint16_t half = s->step / 2;
+    do {
+        n++;
+        if (n == half) *mid = s->now;
+    } while (slew_step(s));
+    return n;
+}
+
+TEST slew_should_reach_its_target_in_steps() {
+    slew_t s;
+    slew_init(&s);
+    slew_set_time(&s, 100 * SLEW_RATE);
+    slew_set(&s, 10000, true);
+    uint16_t mid = 0;
+    ASSERT_EQ(run_slew(&s, &mid), 100);
+    ASSERT_EQ(s.now, 10000);
+    ASSERT_IN_RANGE(4900, mid, 20);
+
+    // and back down
+    slew_set(&s, 0, true);
+    ASSERT_EQ(run_slew(&s, &mid), 100);
+    ASSERT_EQ(s.now, 0);
+    ASSERT_IN_RANGE(5100, mid, 20);
+    PASS();
+}
+
+TEST slew_should_follow_its_shape() {
+    uint16_t mid[SLEW_SHAPE_COUNT];
+    for (uint8_t shape = 0; shape < SLEW_SHAPE_COUNT; shape++) {
+        slew_t s;
+        slew_init(&s);
+        slew_set_time(&s, 64 * SLEW_RATE);
+        slew_set_shape(&s, shape);
+        slew_set(&s, 16000, true);
+        ASSERT_EQ(run_slew(&s, &mid[shape]), 64);
+        ASSERT_EQ(s.now, 16000);
+    }
+    ASSERT(mid[SLEW_EXPONENTIAL] < mid[SLEW_LINEAR]);
+    ASSERT(mid[SLEW_LOGARITHMIC] > mid[SLEW_LINEAR]);
+    ASSERT_IN_RANGE(mid[SLEW_LINEAR], mid[SLEW_S_CURVE], 400);
+
+    // the ends of every curve
+    for (uint8_t shape = 0; shape < SLEW_SHAPE_COUNT; shape++) {
+        ASSERT_EQ(slew_curve(shape, 0), 0);
+        ASSERT_EQ(slew_curve(shape, 1 << 16), 1 << 16);
+        ASSERT(slew_curve(shape, 1 << 15) < 1 << 16);
+    }
+
+    // a shape only applies from the next value
+    slew_t s;
+    slew_init(&s);
+    slew_set_time(&s, 10 * SLEW_RATE);
+    slew_set(&s, 1000, true);
+    slew_set_shape(&s, SLEW_EXPONENTIAL);
+    ASSERT_EQ(s.curve, SLEW_LINEAR);
+    slew_set(&s, 2000, true);
+    ASSERT_EQ(s.curve, SLEW_EXPONENTIAL);
+    PASS();
+}
+
+TEST slew_should_jump_and_stop() {
+    slew_t s;
+    slew_init(&s);
+    slew_set_time(&s, 1000);
+    slew_set_off(&s, 500);
+    slew_set(&s, 16000, false);
+    ASSERT_EQ(s.now, 16383);
+    ASSERT_FALSE(slew_step(&s));
+    ASSERT_EQ(s.step, 0);
+
+    slew_set_off(&s, 0);
+    slew_set(&s, 0, true);
+    ASSERT(slew_step(&s));
+    slew_stop(&s);
+    ASSERT_FALSE(slew_step(&s));
+    ASSERT_EQ(s.now, 0);
+
+    // a slew shorter than a step is a jump
+    slew_set_time(&s, 1);
+    slew_set(&s, 100, true);
+    ASSERT_EQ(s.step, 1);
+    PASS();
+}
+
+TEST slew_should_set_the_curve_with_an_op() {
+    static scene_state_t ss;
+    ss_init(&ss);
+    tele_command_t cmd;
+    char error_msg[TELE_ERROR_MSG_LENGTH];
+
+    const char *lines[] = { "CV.CURVE 2 3", "CV.CURVE 3 9", "CV.CURVE 5 1" };
+    for (uint8_t i = 0; i < 3; i++) {
+        ASSERT_EQ(parse(lines[i], &cmd, error_msg), E_OK);
+        run_command(&ss, &cmd);
+    }
+    ASSERT_EQ(ss.variables.cv_curve[1], SLEW_S_CURVE);
+    ASSERT_EQ(ss.variables.cv_curve[2], SLEW_SHAPE_COUNT - 1);
+    ASSERT_EQ(cv_outputs.curve[1], SLEW_S_CURVE);
+
+    ASSERT_EQ(parse("INIT.CV 2", &cmd, error_msg), E_OK);
+    run_command(&ss, &cmd);
+    ASSERT_EQ(ss.variables.cv_curve[1], 0);
+    ASSERT_EQ(cv_outputs.curve[1], 0);
+    PASS();
+}
+
+SUITE(slew_suite) {
+    RUN_TEST(slew_should_reach_its_target_in_steps);
+    RUN_TEST(slew_should_follow_its_shape);
+    RUN_TEST(slew_should_jump_and_stop);
+    RUN_TEST(slew_should_set_the_curve_with_an_op);
+}
@@ -4,47 +4,65 @@ import re
 _THIS_FILE = path.realpath(__file__)
 _THIS_DIR = path.dirname(_THIS_FILE)
 
-OP_C = path.abspath(path.join(_THIS_DIR, "../../src/ops/op.c"))
+OP_LIST_H = path.abspath(path.join(_THIS_DIR, "../../src/ops/op_list.h"))
+
+
+def _read_list(macro, entry):
+    """Return (group, struct suffix, effect, cost, gap) for each entry of the
+    X-macro list called macro in op_list.h, gap is True if there's a blank
+    line between the entry and the one before it in the same group"""
+    with open(OP_LIST_H, "r") as f:
+        op_list_h = f.read()
+    start = op_list_h.index("#define {}(".format(macro))
+    end = op_list_h.find("\n\n", start)
+    pattern = r"\s*{}\((\w+),\s*(\w+),\s*(\w+)\)".format(entry)
+    group = None
+    gap = False
+    entries = []
+    for line in op_list_h[start:end].splitlines()[1:]:
+        m = re.match(r"\s*/\* (\w+) \*/", line)
+        if m:
+            group = m.group(1)
+            gap = False
+            continue
+        m = re.match(pattern, line)
+        if m:
+            entries.append((group,) + m.groups() + (gap,))
+            gap = False
+        elif line.strip() == "\\":
+            gap = True
+    return entries
+
+
+def list_op_entries():
+    """Return (group, struct suffix, effect, cost, gap) for every op"""
+    return _read_list("TELE_OP_LIST", "OP")
+
+
+def list_mod_entries():
+    """Return (group, struct suffix, effect, cost, gap) for every mod"""
+    return _read_list("TELE_MOD_LIST", "MOD")
 
 
 def list_tele_ops():
-    """Return the names of all the structs defined in tele_ops"""
-    with open(OP_C, "r") as f:
-        op_c = _remove_comments(f.read())
-        ops = re.findall("&op_[a-zA-Z0-9_]+", op_c)
-        ops = [s[1:] for s in ops]
-        return ops
+    """Return the names of all the structs in tele_ops"""
+    return ["op_" + e[1] for e in list_op_entries()]
 
 
 def list_ops():
-    return map(_convert_struct_name_to_op_name, list_tele_ops())
+    return map(convert_struct_name_to_op_name, list_tele_ops())
 
 
 def list_tele_mods():
-    """Return the names of all the structs defined in tele_mods"""
-    with open(OP_C, "r") as f:
-        op_c = _remove_comments(f.read())
-        mods = re.findall("&mod_[a-zA-Z0-9_]+", op_c)
-        mods = [s[1:] for s in mods]
-        return mods
+    """Return the names of all the structs in tele_mods"""
+    return ["mod_" + e[1] for e in list_mod_entries()]
 
 
 def list_mods():
-    return map(_convert_struct_name_to_op_name, list_tele_mods())
+    return map(convert_struct_name_to_op_name, list_tele_mods())
 
 
-def _remove_comments(op_c):
-    out = op_c.splitlines()
-    out = filter(_is_not_comment, out)
-    return "\n".join(out)
-
-
-def _is_not_comment(line):
-    s = line.lstrip()
-    return not (s.startswith("//") or s.startswith("/*"))
-
-
-def _convert_struct_name_to_op_name(name):
+def convert_struct_name_to_op_name(name):
     stripped = name.replace("op_", "").replace("mod_", "")
 
     MAPPINGS = {
@@ -64,6 +82,10 @@ def _convert_struct_name_to_op_name(name):
         "SYM_RIGHT_ANGLED_x2":    ">>",
         "SYM_AMPERSAND_x2":       "&&",
         "SYM_PIPE_x2":            "||",
+        "BIT_OR":                 "|",
+        "BIT_AND":                "&",
+        "BIT_NOT":                "~",
+        "BIT_XOR":                "^",
         "M_SYM_EXCLAMATION":      "M!",
         "TURTLE":                 "@",
         "TURTLE_X":               "@X",
@@ -3,7 +3,8 @@
 import sys
 from os import path
 
-from common import list_tele_ops, list_tele_mods, OP_C
+from common import list_op_entries, list_mod_entries, list_ops, list_mods, \
+    convert_struct_name_to_op_name, OP_LIST_H
 
 if (sys.version_info.major, sys.version_info.minor) < (3, 6):
     raise Exception("need Python 3.6 or later")
@@ -11,6 +12,8 @@ if (sys.version_info.major, sys.version_info.minor) < (3, 6):
 THIS_FILE = path.realpath(__file__)
 THIS_DIR = path.dirname(THIS_FILE)
 OP_ENUM_H = path.abspath(path.join(THIS_DIR, "../src/ops/op_enum.h"))
+OP_HASH_H = path.abspath(path.join(THIS_DIR, "../src/ops/op_hash.h"))
+MATCH_TOKEN_RL = path.abspath(path.join(THIS_DIR, "../src/match_token.rl"))
 
 HEADER_PRE = """// clang-format off
 
@@ -24,11 +27,11 @@ HEADER_POST = "#endif\n"
 
 
 def make_ops():
-    return [s[3:] for s in list_tele_ops()]
+    return [e[1] for e in list_op_entries()]
 
 
 def make_mods():
-    return [s[4:] for s in list_tele_mods()]
+    return [e[1] for e in list_mod_entries()]
 
 
 def make_enum(name, prefix, entries):
@@ -42,8 +45,128 @@ def make_enum(name, prefix, entries):
     return output
 
 
+HASH_PRE = """// clang-format off
+
+#ifndef _OP_HASH_H_
+#define _OP_HASH_H_
+
+// This file has been autogenerated by 'utils/op_enums.py'
+
+// A minimal perfect hash of the op and mod names, see match_token_hash.c
+
+#include <stdint.h>
+
+"""
+HASH_POST = "#endif\n"
+
+# op_hash_words entries for mods have this bit set
+HASH_MOD = 0x8000
+
+
+def fnv1a(name, seed):
+    """32 bit FNV-1a, must match op_hash in match_token_hash.c"""
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for c in name.encode("ascii"):
+        h ^= c
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def make_hash(names):
+    """Hash and displace: each name goes in bucket fnv1a(name, 0) % buckets,
+    and every bucket gets the seed d that sends all of its names to free slots
+    fnv1a(name, d) % len(names). The biggest buckets are placed first."""
+    size = len(names)
+    buckets = size // 3 + 1
+    grouped = [[] for _ in range(buckets)]
+    for i, name in enumerate(names):
+        grouped[fnv1a(name, 0) % buckets].append(i)
+
+    displace = [0] * buckets
+    slots = [None] * size
+    for b in sorted(range(buckets), key=lambda b: -len(grouped[b])):
+        if not grouped[b]:
+            continue
+        for d in range(1, 0x10000):
+            wanted = {fnv1a(names[i], d) % size for i in grouped[b]}
+            if len(wanted) == len(grouped[b]) and \
+                    all(slots[s] is None for s in wanted):
+                break
+        else:
+            raise Exception("can't place bucket {}".format(b))
+        displace[b] = d
+        for i in grouped[b]:
+            slots[fnv1a(names[i], d) % size] = i
+    return displace, slots
+
+
+def make_table(c_type, name, values):
+    output = "static const {} {}[] = {{\n".format(c_type, name)
+    for i in range(0, len(values), 8):
+        row = ", ".join("0x{:04X}".format(v) for v in values[i:i + 8])
+        output += "    {},\n".format(row)
+    output += "};\n\n"
+    return output
+
+
+def make_op_hash(ops, mods):
+    names = list(ops) + list(mods)
+    if len(set(names)) != len(names):
+        raise Exception("op and mod names must be unique")
+    displace, slots = make_hash(names)
+    words = [i if i < len(ops) else (i - len(ops)) | HASH_MOD for i in slots]
+
+    output = "#define OP_HASH_BUCKETS {}\n".format(len(displace))
+    output += "#define OP_HASH_SIZE {}\n".format(len(words))
+    output += "#define OP_HASH_MOD 0x{:04X}\n\n".format(HASH_MOD)
+    output += "// the seed of each bucket\n"
+    output += make_table("uint16_t", "op_hash_displace", displace)
+    output += "// the op (or mod, with OP_HASH_MOD set) in each slot\n"
+    output += make_table("uint16_t", "op_hash_words", words)
+    return output
+
+
+# the generated part of match_token.rl is the scanner rules from RL_START up to
+# RL_END
+RL_START = "        # OPS\n"
+RL_END = "    *|;\n"
+
+
+def make_rl_rules(kind, prefix, entries):
+    output = ""
+    groups = []
+    for (group, name, _, _, gap) in entries:
+        if not groups or groups[-1][0] != group:
+            groups.append((group, []))
+        groups[-1][1].append((name, gap))
+
+    for (i, (group, names)) in enumerate(groups):
+        if i:
+            output += "\n"
+        output += "        # {}\n".format(group)
+        quoted = ['"{}"'.format(convert_struct_name_to_op_name(n))
+                  for (n, _) in names]
+        width = max([14] + [len(q) + 1 for q in quoted])
+        for (q, (n, gap)) in zip(quoted, names):
+            if gap:
+                output += "\n"
+            output += "        {}=> {{ {}({}{}); }};\n".format(
+                q.ljust(width), kind, prefix, n)
+    return output
+
+
+def make_match_token_rl(rl):
+    start = rl.index(RL_START)
+    end = rl.index(RL_END, start)
+    rules = RL_START
+    rules += make_rl_rules("MATCH_OP", "E_OP_", list_op_entries())
+    rules += "\n        # MODS\n"
+    rules += make_rl_rules("MATCH_MOD", "E_MOD_", list_mod_entries())
+    return rl[:start] + rules + rl[end:]
+
+
 def main():
-    print("reading:    {}".format(OP_C))
+    print("reading:    {}".format(OP_LIST_H))
     print("generating: {}".format(OP_ENUM_H))
     ops = make_ops()
     mods = make_mods()
@@ -53,6 +176,17 @@ def main():
     with open(OP_ENUM_H, "w") as g:
         g.write(header)
 
+    print("generating: {}".format(OP_HASH_H))
+    op_hash = make_op_hash(list(list_ops()), list(list_mods()))
+    with open(OP_HASH_H, "w") as g:
+        g.write(HASH_PRE + op_hash + HASH_POST)
+
+    print("generating: {}".format(MATCH_TOKEN_RL))
+    with open(MATCH_TOKEN_RL, "r") as g:
+        rl = g.read()
+    with open(MATCH_TOKEN_RL, "w") as g:
+        g.write(make_match_token_rl(rl))
+
 
 if __name__ == '__main__':
     main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+import math
+import sys
+from os import path
+
+if (sys.version_info.major, sys.version_info.minor) < (3, 6):
+    raise Exception("need Python 3.6 or later")
+
+THIS_FILE = path.realpath(__file__)
+THIS_DIR = path.dirname(THIS_FILE)
+SLEW_TABLES_H = path.abspath(path.join(THIS_DIR, "../src/slew_tables.h"))
+
+# must match SLEW_TABLE_BITS and the order of slew_shape_t in src/slew.h
+TABLE_BITS = 6
+SEGMENTS = 1 << TABLE_BITS
+ONE = 65535
+
+# how sharp the exponential and logarithmic curves are
+K = 4.0
+
+
+def linear(x):
+    return x
+
+
+def exponential(x):
+    return (math.exp(K * x) - 1) / (math.exp(K) - 1)
+
+
+def logarithmic(x):
+    return 1 - exponential(1 - x)
+
+
+def s_curve(x):
+    return (1 - math.cos(math.pi * x)) / 2
+
+
+SHAPES = [("linear", linear), ("exponential", exponential),
+          ("logarithmic", logarithmic), ("s-curve", s_curve)]
+
+HEADER_PRE = """// clang-format off
+
+#ifndef _SLEW_TABLES_H_
+#define _SLEW_TABLES_H_
+
+// This file has been autogenerated by 'utils/slew_tables.py'
+
+"""
+HEADER_POST = "#endif\n"
+
+
+def make_table(f):
+    return [round(f(i / SEGMENTS) * ONE) for i in range(SEGMENTS + 1)]
+
+
+def make_array(name, rows):
+    output = "static const uint16_t {}[][{}] = {{\n".format(
+        name, len(rows[0][1]))
+    for (shape, values) in rows:
+        output += "    // {}\n    {{\n".format(shape)
+        for i in range(0, len(values), 8):
+            output += "        " + ", ".join(
+                str(v).rjust(5) for v in values[i:i + 8]) + ",\n"
+        output += "    },\n"
+    return output + "};\n\n"
+
+
+def main():
+    print("generating: {}".format(SLEW_TABLES_H))
+    tables = [(n, make_table(f)) for (n, f) in SHAPES]
+    # the difference from each entry to the next, so a step only needs one
+    # multiply to interpolate
+    deltas = [(n, [t[i + 1] - t[i] for i in range(SEGMENTS)])
+              for (n, t) in tables]
+    with open(SLEW_TABLES_H, "w") as g:
+        g.write(HEADER_PRE)
+        g.write(make_array("slew_table", tables))
+        g.write(make_array("slew_delta", deltas))
+        g.write(HEADER_POST)
+
+
+if __name__ == '__main__':
+    main()